@@ -10,6 +10,7 @@
 #include <boost/endian/detail/disable_warnings.hpp>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/endian/describe.hpp>
 #include <iostream>
 #include <cstring>
 
@@ -41,19 +42,15 @@ namespace user
       desc_[sizeof(desc_-1)] = '\0';
     }
 
-    friend void endian_reverse_inplace(UDT&);
-
   private:
     int32_t id_;
     int64_t value_;
     char    desc_[56];  // '/0'
-  };
 
-  void endian_reverse_inplace(UDT& x)
-  {
-    boost::endian::endian_reverse_inplace(x.id_);
-    boost::endian::endian_reverse_inplace(x.value_);
-  }
+    //  defines endian_reverse_inplace(UDT&), reversing id_ and value_; arrays
+    //  of UDT are then converted as a whole by endian_reverse_inplace_n
+    BOOST_ENDIAN_DESCRIBE_CLASS(UDT, id_, value_)
+  };
 }
 
 int main(int, char* [])
@@ -63,7 +60,7 @@ int main(int, char* [])
   //cout << std::hex;
   cout << "(1) " << x.id() << ' ' << x.value() << ' ' << x.desc() << endl;
 
-  user::endian_reverse_inplace(x);
+  endian_reverse_inplace(x);
   cout << "(2) " << x.id() << ' ' << x.value() << ' ' << x.desc() << endl;
 
   endian_reverse_inplace(x);
@@ -74,6 +71,10 @@ int main(int, char* [])
 
   conditional_reverse_inplace(x, order::big, order::little);
   cout << "(5) " << x.id() << ' ' << x.value() << ' ' << x.desc() << endl;
+
+  user::UDT a[3] = { x, x, x };
+  native_to_big_inplace_n(a, 3);
+  cout << "(6) " << a[2].id() << ' ' << a[2].value() << ' ' << a[2].desc() << endl;
 }
 
 #include <boost/endian/detail/disable_warnings_pop.hpp>
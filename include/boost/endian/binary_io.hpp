@@ -0,0 +1,298 @@
+//  boost/endian/binary_io.hpp  --------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_BINARY_IO_HPP
+#define BOOST_ENDIAN_BINARY_IO_HPP
+
+#include <boost/endian/conversion.hpp>
+#include <boost/endian/detail/endian_load_n.hpp>
+#include <boost/endian/detail/endian_store_n.hpp>
+#include <boost/endian/detail/endian_value_traits.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+#if ( defined(__unix__) || defined(__APPLE__) ) && !defined(BOOST_ENDIAN_NO_FD_IO)
+# include <unistd.h>
+# include <cerrno>
+# define BOOST_ENDIAN_HAS_FD_IO
+#endif
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  Binary output and input of whole ranges of values, typed as in endian_reader
+  //  by an endian_buffer or endian_arithmetic type E. The values are either E
+  //  objects, whose bytes are moved as they are, or native values, converted in
+  //  bulk to or from E's format through a staging buffer. Either way, the bytes
+  //  move in a few large transfers: one for E objects, and one per staging
+  //  buffer, of up to binary_staging_bytes, for native values, instead of one
+  //  per value.
+  //
+  //  A sink is a std::streambuf&, std::ostream&, std::FILE* or, where
+  //  BOOST_ENDIAN_HAS_FD_IO is defined, an int file descriptor; a source is a
+  //  std::streambuf&, std::istream&, std::FILE* or an int file descriptor.
+  //
+  //  Returns: the number of whole values written or read, n unless an error
+  //  occurred or, for reads, the input ended. A stream has badbit set on a
+  //  short write and eofbit and failbit on a short read, as by write and read;
+  //  a descriptor leaves errno set.
+
+  static const std::size_t binary_staging_bytes = 256 * 1024;
+
+  template <class E, class Sink>
+    std::size_t write_binary(Sink&& s, E const* p, std::size_t n);
+  template <class E, class Sink>
+    std::size_t write_binary(Sink&& s, typename E::value_type const* p, std::size_t n);
+  template <class E, class Sink>
+    std::size_t write_binary(Sink&& s, typename E::value_type const* p, std::size_t n,
+      std::vector<unsigned char>& staging);
+
+  template <class E, class Source>
+    std::size_t read_binary(Source&& s, E* p, std::size_t n);
+  template <class E, class Source>
+    std::size_t read_binary(Source&& s, typename E::value_type* p, std::size_t n);
+  template <class E, class Source>
+    std::size_t read_binary(Source&& s, typename E::value_type* p, std::size_t n,
+      std::vector<unsigned char>& staging);
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+namespace detail
+{
+
+// The byte transfers; each returns the number of bytes moved, n unless an
+// error occurred or the input ended
+
+inline std::size_t binary_write_bytes( std::streambuf & sb, unsigned char const * p, std::size_t n )
+{
+    std::size_t r = 0;
+
+    while( r < n )
+    {
+        std::streamsize const k = sb.sputn( reinterpret_cast<char const*>( p + r ), static_cast<std::streamsize>( n - r ) );
+
+        if( k <= 0 ) break;
+
+        r += static_cast<std::size_t>( k );
+    }
+
+    return r;
+}
+
+inline std::size_t binary_write_bytes( std::ostream & os, unsigned char const * p, std::size_t n )
+{
+    os.write( reinterpret_cast<char const*>( p ), static_cast<std::streamsize>( n ) );
+    return os? n: 0;
+}
+
+inline std::size_t binary_write_bytes( std::FILE * f, unsigned char const * p, std::size_t n )
+{
+    return std::fwrite( p, 1, n, f );
+}
+
+inline std::size_t binary_read_bytes( std::streambuf & sb, unsigned char * p, std::size_t n )
+{
+    std::size_t r = 0;
+
+    while( r < n )
+    {
+        std::streamsize const k = sb.sgetn( reinterpret_cast<char*>( p + r ), static_cast<std::streamsize>( n - r ) );
+
+        if( k <= 0 ) break;
+
+        r += static_cast<std::size_t>( k );
+    }
+
+    return r;
+}
+
+inline std::size_t binary_read_bytes( std::istream & is, unsigned char * p, std::size_t n )
+{
+    is.read( reinterpret_cast<char*>( p ), static_cast<std::streamsize>( n ) );
+    return static_cast<std::size_t>( is.gcount() );
+}
+
+inline std::size_t binary_read_bytes( std::FILE * f, unsigned char * p, std::size_t n )
+{
+    return std::fread( p, 1, n, f );
+}
+
+#if defined(BOOST_ENDIAN_HAS_FD_IO)
+
+inline std::size_t binary_write_bytes( int fd, unsigned char const * p, std::size_t n )
+{
+    std::size_t r = 0;
+
+    while( r < n )
+    {
+        ssize_t const k = ::write( fd, p + r, n - r );
+
+        if( k < 0 && errno == EINTR ) continue;
+        if( k <= 0 ) break;
+
+        r += static_cast<std::size_t>( k );
+    }
+
+    return r;
+}
+
+inline std::size_t binary_read_bytes( int fd, unsigned char * p, std::size_t n )
+{
+    std::size_t r = 0;
+
+    while( r < n )
+    {
+        ssize_t const k = ::read( fd, p + r, n - r );
+
+        if( k < 0 && errno == EINTR ) continue;
+        if( k <= 0 ) break;
+
+        r += static_cast<std::size_t>( k );
+    }
+
+    return r;
+}
+
+#endif
+
+// the whole values in a transfer; a trailing partial value of a short
+// transfer is not counted
+
+template<class E> inline std::size_t binary_values( std::size_t bytes )
+{
+    return bytes / endian_value_traits<E>::size;
+}
+
+} // namespace detail
+
+//  write_binary  ----------------------------------------------------------------------//
+
+template<class E, class Sink>
+inline std::size_t write_binary( Sink && s, E const * p, std::size_t n )
+{
+    typedef detail::endian_value_traits<E> traits;
+
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof(E) == traits::size );
+
+    return detail::binary_values<E>( detail::binary_write_bytes( s, reinterpret_cast<unsigned char const*>( p ), n * traits::size ) );
+}
+
+template<class E, class Sink>
+inline std::size_t write_binary( Sink && s, typename E::value_type const * p, std::size_t n, std::vector<unsigned char> & staging )
+{
+    typedef detail::endian_value_traits<E> traits;
+    typedef typename traits::value_type T;
+
+    if( traits::byte_order == order::native && traits::size == sizeof(T) )
+    {
+        // already in the format of E
+        return detail::binary_values<E>( detail::binary_write_bytes( s, reinterpret_cast<unsigned char const*>( p ), n * traits::size ) );
+    }
+
+    std::size_t const k = binary_staging_bytes / traits::size;
+
+    staging.resize( ( n < k? n: k ) * traits::size );
+
+    std::size_t r = 0;
+
+    while( r < n )
+    {
+        std::size_t const m = n - r < k? n - r: k;
+
+        boost::endian::endian_store_n<T, traits::size, traits::byte_order>( p + r, staging.data(), m );
+
+        std::size_t const w = detail::binary_values<E>( detail::binary_write_bytes( s, staging.data(), m * traits::size ) );
+
+        r += w;
+
+        if( w < m ) break;
+    }
+
+    return r;
+}
+
+template<class E, class Sink>
+inline std::size_t write_binary( Sink && s, typename E::value_type const * p, std::size_t n )
+{
+    std::vector<unsigned char> staging;
+    return boost::endian::write_binary<E>( s, p, n, staging );
+}
+
+//  read_binary  -----------------------------------------------------------------------//
+
+template<class E, class Source>
+inline std::size_t read_binary( Source && s, E * p, std::size_t n )
+{
+    typedef detail::endian_value_traits<E> traits;
+
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof(E) == traits::size );
+
+    return detail::binary_values<E>( detail::binary_read_bytes( s, reinterpret_cast<unsigned char*>( p ), n * traits::size ) );
+}
+
+template<class E, class Source>
+inline std::size_t read_binary( Source && s, typename E::value_type * p, std::size_t n, std::vector<unsigned char> & staging )
+{
+    typedef detail::endian_value_traits<E> traits;
+    typedef typename traits::value_type T;
+
+    if( traits::size == sizeof(T) )
+    {
+        // read into place, and reversed there when needed
+
+        std::size_t const r = detail::binary_values<E>( detail::binary_read_bytes( s, reinterpret_cast<unsigned char*>( p ), n * traits::size ) );
+
+        boost::endian::conditional_reverse_inplace_n<traits::byte_order, order::native>( p, r );
+        return r;
+    }
+
+    std::size_t const k = binary_staging_bytes / traits::size;
+
+    staging.resize( ( n < k? n: k ) * traits::size );
+
+    std::size_t r = 0;
+
+    while( r < n )
+    {
+        std::size_t const m = n - r < k? n - r: k;
+        std::size_t const g = detail::binary_values<E>( detail::binary_read_bytes( s, staging.data(), m * traits::size ) );
+
+        boost::endian::endian_load_n<T, traits::size, traits::byte_order>( staging.data(), p + r, g );
+
+        r += g;
+
+        if( g < m ) break;
+    }
+
+    return r;
+}
+
+template<class E, class Source>
+inline std::size_t read_binary( Source && s, typename E::value_type * p, std::size_t n )
+{
+    std::vector<unsigned char> staging;
+    return boost::endian::read_binary<E>( s, p, n, staging );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_BINARY_IO_HPP
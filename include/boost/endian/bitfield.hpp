@@ -0,0 +1,176 @@
+//  boost/endian/bitfield.hpp  ---------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_BITFIELD_HPP
+#define BOOST_ENDIAN_BITFIELD_HPP
+
+#include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_store.hpp>
+#include <boost/endian/detail/integral_by_size.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <climits>
+#include <cstddef>
+
+# if CHAR_BIT != 8
+#   error Platforms with CHAR_BIT != 8 are not supported
+# endif
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  A field of Width bits, not necessarily byte aligned, within the
+  //  (BitOffset + Width + 7) / 8 bytes starting at ByteOffset, read as one unsigned
+  //  integer in Order. For order::big, bits are numbered from the most significant
+  //  bit of the first byte, as in protocol diagrams; for order::little, from the
+  //  least significant bit of the first byte. A field is named by deriving a type
+  //  from it:
+  //
+  //    struct ihl: endian_bitfield<order::big, 0, 4, 4> {};
+
+  template <enum order Order, std::size_t ByteOffset, std::size_t BitOffset,
+    std::size_t Width>
+      struct endian_bitfield;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+namespace detail
+{
+
+template<std::size_t N> struct endian_bitfield_round: integral_constant<std::size_t,
+    N <= 1? 1: N <= 2? 2: N <= 4? 4: 8>
+{
+};
+
+} // namespace detail
+
+template< enum order Order, std::size_t ByteOffset, std::size_t BitOffset, std::size_t Width >
+struct endian_bitfield
+{
+    BOOST_ENDIAN_STATIC_ASSERT( Width >= 1 );
+    BOOST_ENDIAN_STATIC_ASSERT( BitOffset + Width <= 64 );
+
+    // the bytes holding the field
+
+    static const std::size_t offset = ByteOffset;
+    static const std::size_t size = ( BitOffset + Width + 7 ) / 8;
+    static const order byte_order = Order;
+
+    static const std::size_t bit_offset = BitOffset;
+    static const std::size_t width = Width;
+
+    // the smallest unsigned type of 8, 16, 32 or 64 bits that holds the field
+
+    typedef typename detail::integral_by_size< detail::endian_bitfield_round< ( Width + 7 ) / 8 >::value >::type value_type;
+
+private:
+
+    // the `size` bytes are loaded into a container_type, in which the field
+    // starts at bit `shift`, counted from the least significant bit
+
+    typedef typename detail::integral_by_size< detail::endian_bitfield_round<size>::value >::type container_type;
+
+    static const std::size_t shift = Order == order::big? size * 8 - BitOffset - Width: BitOffset;
+
+    static const container_type ones = static_cast<container_type>( ~static_cast<container_type>( 0 ) );
+    static const container_type mask = static_cast<container_type>( ones >> ( sizeof(container_type) * 8 - Width ) );
+
+    static value_type extract( container_type c ) noexcept
+    {
+        return static_cast<value_type>( ( c >> shift ) & mask );
+    }
+
+public:
+
+    // p points to the start of the enclosing header; the field is in the
+    // `size` bytes at p + offset
+
+    static value_type get( unsigned char const * p ) noexcept
+    {
+        return extract( boost::endian::endian_load<container_type, size, Order>( p + ByteOffset ) );
+    }
+
+    // read-modify-write; the bits of v above Width are ignored
+
+    static void set( unsigned char * p, value_type v ) noexcept
+    {
+        container_type c = boost::endian::endian_load<container_type, size, Order>( p + ByteOffset );
+
+        c = static_cast<container_type>( ( c & ~static_cast<container_type>( mask << shift ) ) | ( ( static_cast<container_type>( v ) & mask ) << shift ) );
+
+        boost::endian::endian_store<container_type, size, Order>( p + ByteOffset, c );
+    }
+
+    // the enclosing header is an object, such as a struct of endian buffers
+
+    template<class H> static
+        typename detail::enable_if< detail::is_class<H>::value, value_type >::type
+        get( H const & h ) noexcept
+    {
+        BOOST_ENDIAN_STATIC_ASSERT( ByteOffset + size <= sizeof(H) );
+        return get( reinterpret_cast<unsigned char const*>( &h ) );
+    }
+
+    template<class H> static
+        typename detail::enable_if< detail::is_class<H>::value >::type
+        set( H & h, value_type v ) noexcept
+    {
+        BOOST_ENDIAN_STATIC_ASSERT( ByteOffset + size <= sizeof(H) );
+        set( reinterpret_cast<unsigned char*>( &h ), v );
+    }
+
+    // the field of each of n headers, the header i starting at p + i * stride.
+    // A single pass of one load, shift and mask per header is faster than
+    // vector gathers of the containers, which cost about one cycle per lane.
+
+    static void get_n( unsigned char const * p, std::size_t stride, value_type * dst, std::size_t n ) noexcept
+    {
+        p += ByteOffset;
+
+        for( std::size_t i = 0; i < n; ++i, p += stride )
+        {
+            dst[ i ] = extract( boost::endian::endian_load<container_type, size, Order>( p ) );
+        }
+    }
+
+    static void set_n( value_type const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+    {
+        for( std::size_t i = 0; i < n; ++i, p += stride )
+        {
+            set( p, src[ i ] );
+        }
+    }
+};
+
+template< enum order Order, std::size_t ByteOffset, std::size_t BitOffset, std::size_t Width >
+const std::size_t endian_bitfield<Order, ByteOffset, BitOffset, Width>::offset;
+
+template< enum order Order, std::size_t ByteOffset, std::size_t BitOffset, std::size_t Width >
+const std::size_t endian_bitfield<Order, ByteOffset, BitOffset, Width>::size;
+
+template< enum order Order, std::size_t ByteOffset, std::size_t BitOffset, std::size_t Width >
+const order endian_bitfield<Order, ByteOffset, BitOffset, Width>::byte_order;
+
+template< enum order Order, std::size_t ByteOffset, std::size_t BitOffset, std::size_t Width >
+const std::size_t endian_bitfield<Order, ByteOffset, BitOffset, Width>::bit_offset;
+
+template< enum order Order, std::size_t ByteOffset, std::size_t BitOffset, std::size_t Width >
+const std::size_t endian_bitfield<Order, ByteOffset, BitOffset, Width>::width;
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_BITFIELD_HPP
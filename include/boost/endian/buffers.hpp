@@ -30,6 +30,8 @@
 #include <boost/endian/detail/cstdint.hpp>
 #include <boost/endian/detail/endian_store.hpp>
 #include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_load_n.hpp>
+#include <boost/endian/detail/endian_store_n.hpp>
 #include <boost/endian/detail/static_assert.hpp>
 #include <iosfwd>
 #include <climits>
@@ -186,6 +188,14 @@ namespace endian
     return is;
   }
 
+  // Bulk conversion between an array of buffers and an array of values
+  template <enum order Order, class T, std::size_t n_bits, enum align A>
+  void endian_load_n(const endian_buffer<Order, T, n_bits, A>* src, T* dst,
+    std::size_t n) noexcept;
+  template <enum order Order, class T, std::size_t n_bits, enum align A>
+  void endian_store_n(const T* src, endian_buffer<Order, T, n_bits, A>* dst,
+    std::size_t n) noexcept;
+
 //----------------------------------  end synopsis  ------------------------------------//
 
 //  endian_buffer class template specializations  --------------------------------------//
@@ -353,6 +363,28 @@ public:
     }
 };
 
+//  bulk conversion  -------------------------------------------------------------------//
+
+//  Every endian_buffer holds exactly n_bits / 8 bytes, so an array of them is a
+//  packed byte stream that the bulk kernels can process in one pass. Values are
+//  moved as bit patterns, so float and double NaN payloads are preserved.
+
+template< enum order Order, class T, std::size_t n_bits, enum align A >
+inline void endian_load_n( endian_buffer<Order, T, n_bits, A> const * src, T * dst, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof( endian_buffer<Order, T, n_bits, A> ) == n_bits / 8 );
+
+    boost::endian::endian_load_n<T, n_bits / 8, Order>( reinterpret_cast<unsigned char const*>( src ), dst, n );
+}
+
+template< enum order Order, class T, std::size_t n_bits, enum align A >
+inline void endian_store_n( T const * src, endian_buffer<Order, T, n_bits, A> * dst, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof( endian_buffer<Order, T, n_bits, A> ) == n_bits / 8 );
+
+    boost::endian::endian_store_n<T, n_bits / 8, Order>( src, reinterpret_cast<unsigned char*>( dst ), n );
+}
+
 } // namespace endian
 } // namespace boost
 
@@ -0,0 +1,243 @@
+//  boost/endian/checksum.hpp  ---------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_CHECKSUM_HPP
+#define BOOST_ENDIAN_CHECKSUM_HPP
+
+#include <boost/endian/conversion.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/endian_checksum.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <cstddef>
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  The RFC 1071 Internet checksum of IPv4, ICMP, UDP and TCP: the ones' complement
+  //  sum of the data as big endian 16-bit words
+
+  class internet_checksum;
+
+  //  CRC-32C (Castagnoli) of iSCSI, SCTP, ext4 and Btrfs
+
+  class crc32c;
+
+  //  Bulk conversions that also add the big or little endian bytes, that is src for
+  //  the *_to_native_n functions and dst for the native_to_*_n functions, to sum.
+  //  Checksum is internet_checksum or crc32c.
+
+  template <class T, class Checksum>
+    inline void big_to_native_n(unsigned char const* src, T* dst, std::size_t n,
+      Checksum& sum) noexcept;
+  template <class T, class Checksum>
+    inline void little_to_native_n(unsigned char const* src, T* dst, std::size_t n,
+      Checksum& sum) noexcept;
+  template <class T, class Checksum>
+    inline void native_to_big_n(T const* src, unsigned char* dst, std::size_t n,
+      Checksum& sum) noexcept;
+  template <class T, class Checksum>
+    inline void native_to_little_n(T const* src, unsigned char* dst, std::size_t n,
+      Checksum& sum) noexcept;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+class internet_checksum
+{
+private:
+
+    detail::uint64_t sum_;
+    bool odd_;
+
+public:
+
+    internet_checksum() noexcept: sum_( 0 ), odd_( false )
+    {
+    }
+
+    // Effects: adds the n bytes at p, which continue the data added before
+
+    void update( unsigned char const * p, std::size_t n ) noexcept
+    {
+        detail::uint64_t s = 0;
+        detail::simd_invoke< detail::endian_inet_sum_simd >( p, n, &s );
+
+        // after an odd number of bytes, p[0] is the low byte of a word
+
+        if( odd_ )
+        {
+            s = detail::inet_swap( detail::inet_fold( s ) );
+        }
+
+        sum_ = detail::inet_add( sum_, s );
+        odd_ = odd_ != ( ( n & 1 ) != 0 );
+    }
+
+    // Returns: the 16-bit ones' complement sum of the data
+
+    detail::uint16_t sum() const noexcept
+    {
+        return detail::inet_fold( sum_ );
+    }
+
+    // Returns: ~sum(), the value of a checksum field. Data that includes
+    // its correct checksum field has a value() of 0.
+
+    detail::uint16_t value() const noexcept
+    {
+        return static_cast<detail::uint16_t>( ~sum() );
+    }
+};
+
+class crc32c
+{
+private:
+
+    detail::uint32_t crc_;
+
+public:
+
+    // v is the value() of the data before the data to be added
+
+    explicit crc32c( detail::uint32_t v = 0 ) noexcept: crc_( ~v )
+    {
+    }
+
+    // Effects: adds the n bytes at p
+
+    void update( unsigned char const * p, std::size_t n ) noexcept
+    {
+        detail::simd_invoke< detail::endian_crc32c_simd >( p, n, &crc_ );
+    }
+
+    // Returns: the CRC of the data; 0xE3069283 for "123456789"
+
+    detail::uint32_t value() const noexcept
+    {
+        return ~crc_;
+    }
+};
+
+namespace detail
+{
+
+template<class C> struct is_endian_checksum: false_type
+{
+};
+
+template<> struct is_endian_checksum<internet_checksum>: true_type
+{
+};
+
+template<> struct is_endian_checksum<crc32c>: true_type
+{
+};
+
+// The arrays are converted in blocks of 6K bytes, and the bytes of each block
+// are added to the checksum while they are in L1, so that the data is only
+// read from (and written to) memory once. A block is four sets of the three
+// interleaved CRC stripes.
+
+template<class T> struct endian_checksum_block: integral_constant<std::size_t, 6144 / sizeof(T)>
+{
+};
+
+template<order Order, class T, class C>
+inline void endian_load_n_checksum( unsigned char const * src, T * dst, std::size_t n, C & sum ) noexcept
+{
+    std::size_t const m = endian_checksum_block<T>::value;
+
+    for( std::size_t i = 0; i < n; i += m )
+    {
+        std::size_t const k = n - i < m? n - i: m;
+        unsigned char const * p = src + i * sizeof(T);
+
+        sum.update( p, k * sizeof(T) );
+
+        conditional_reverse_n_bytes<sizeof(T)>( p, reinterpret_cast<unsigned char*>( dst + i ), k, store_hint::normal,
+            integral_constant<bool, Order == order::native>() );
+    }
+}
+
+template<order Order, class T, class C>
+inline void endian_store_n_checksum( T const * src, unsigned char * dst, std::size_t n, C & sum ) noexcept
+{
+    std::size_t const m = endian_checksum_block<T>::value;
+
+    for( std::size_t i = 0; i < n; i += m )
+    {
+        std::size_t const k = n - i < m? n - i: m;
+        unsigned char * p = dst + i * sizeof(T);
+
+        conditional_reverse_n_bytes<sizeof(T)>( reinterpret_cast<unsigned char const*>( src + i ), p, k, store_hint::normal,
+            integral_constant<bool, Order == order::native>() );
+
+        sum.update( p, k * sizeof(T) );
+    }
+}
+
+} // namespace detail
+
+// Requires:
+//
+//    the requirements of the bulk functions without sum
+//
+// Effects:
+//
+//    converts as the bulk function without sum, and adds the n * sizeof(T)
+//    big or little endian bytes to sum, in a single pass over the data
+
+template <class T, class Checksum>
+inline void big_to_native_n( unsigned char const* src, T* dst, std::size_t n, Checksum& sum ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+    BOOST_ENDIAN_STATIC_ASSERT( detail::is_endian_checksum<Checksum>::value );
+
+    detail::endian_load_n_checksum<order::big>( src, dst, n, sum );
+}
+
+template <class T, class Checksum>
+inline void little_to_native_n( unsigned char const* src, T* dst, std::size_t n, Checksum& sum ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+    BOOST_ENDIAN_STATIC_ASSERT( detail::is_endian_checksum<Checksum>::value );
+
+    detail::endian_load_n_checksum<order::little>( src, dst, n, sum );
+}
+
+template <class T, class Checksum>
+inline void native_to_big_n( T const* src, unsigned char* dst, std::size_t n, Checksum& sum ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+    BOOST_ENDIAN_STATIC_ASSERT( detail::is_endian_checksum<Checksum>::value );
+
+    detail::endian_store_n_checksum<order::big>( src, dst, n, sum );
+}
+
+template <class T, class Checksum>
+inline void native_to_little_n( T const* src, unsigned char* dst, std::size_t n, Checksum& sum ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+    BOOST_ENDIAN_STATIC_ASSERT( detail::is_endian_checksum<Checksum>::value );
+
+    detail::endian_store_n_checksum<order::little>( src, dst, n, sum );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_CHECKSUM_HPP
@@ -10,11 +10,19 @@
 
 #include <boost/endian/detail/cstdint.hpp>
 #include <boost/endian/detail/endian_reverse.hpp>
+#include <boost/endian/detail/endian_reverse_n.hpp>
 #include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_load_n.hpp>
 #include <boost/endian/detail/endian_store.hpp>
+#include <boost/endian/detail/endian_store_n.hpp>
+#include <boost/endian/detail/endian_gather_n.hpp>
+#include <boost/endian/detail/endian_varint.hpp>
 #include <boost/endian/detail/order.hpp>
 #include <boost/endian/detail/static_assert.hpp>
 #include <boost/endian/detail/type_traits.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 //------------------------------------- synopsis ---------------------------------------//
 
@@ -139,6 +147,122 @@ namespace endian
     enum order from_order,  enum order to_order)
     noexcept;
 
+  //------------------------------------------------------------------------------------//
+  //                                                                                    //
+  //                          bulk reverse in place interfaces                          //
+  //                                                                                    //
+  //  Operate on n contiguous elements starting at p. For integral, enumeration, float  //
+  //  and double element types the bytes are reversed by vectorized kernels where      //
+  //  available; class types call endian_reverse_inplace on each element.               //
+  //                                                                                    //
+  //------------------------------------------------------------------------------------//
+
+  //  in detail/endian_reverse_n.hpp
+  //
+  //  template <class EndianReversibleInplace>
+  //    inline void endian_reverse_inplace_n(EndianReversibleInplace* p, std::size_t n) noexcept;
+  //  template <class EndianReversibleInplace>
+  //    inline void endian_reverse_inplace(EndianReversibleInplace* first,
+  //      EndianReversibleInplace* last) noexcept;
+
+  template <class EndianReversibleInplace>
+    inline void big_to_native_inplace_n(EndianReversibleInplace* p, std::size_t n) noexcept;
+  template <class EndianReversibleInplace>
+    inline void native_to_big_inplace_n(EndianReversibleInplace* p, std::size_t n) noexcept;
+  template <class EndianReversibleInplace>
+    inline void little_to_native_inplace_n(EndianReversibleInplace* p, std::size_t n) noexcept;
+  template <class EndianReversibleInplace>
+    inline void native_to_little_inplace_n(EndianReversibleInplace* p, std::size_t n) noexcept;
+
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    inline void conditional_reverse_inplace_n(EndianReversibleInplace* p, std::size_t n) noexcept;
+  template <class EndianReversibleInplace>
+    inline void conditional_reverse_inplace_n(EndianReversibleInplace* p, std::size_t n,
+      enum order from_order, enum order to_order) noexcept;
+
+  //------------------------------------------------------------------------------------//
+  //                                                                                    //
+  //                           bulk copy-and-convert interfaces                         //
+  //                                                                                    //
+  //  Read n elements from src and write them, converted, to dst in a single pass.      //
+  //  src and dst must not overlap unless they are equal. store_hint::nontemporal uses  //
+  //  streaming stores for dst where available.                                         //
+  //                                                                                    //
+  //------------------------------------------------------------------------------------//
+
+  //  in detail/endian_reverse_n.hpp
+  //
+  //  enum class store_hint { normal, nontemporal };
+  //
+  //  template <class EndianReversibleInplace>
+  //    inline void endian_reverse_n(EndianReversibleInplace const* src,
+  //      EndianReversibleInplace* dst, std::size_t n,
+  //      store_hint hint = store_hint::normal) noexcept;
+
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    inline void conditional_reverse_n(EndianReversibleInplace const* src,
+      EndianReversibleInplace* dst, std::size_t n,
+      store_hint hint = store_hint::normal) noexcept;
+  template <class EndianReversibleInplace>
+    inline void conditional_reverse_n(EndianReversibleInplace const* src,
+      EndianReversibleInplace* dst, std::size_t n,
+      enum order from_order, enum order to_order,
+      store_hint hint = store_hint::normal) noexcept;
+
+  //  requires T to be an integral, enumeration, float or double type
+
+  template <class T>
+    inline void big_to_native_n(unsigned char const* src, T* dst, std::size_t n,
+      store_hint hint = store_hint::normal) noexcept;
+  template <class T>
+    inline void little_to_native_n(unsigned char const* src, T* dst, std::size_t n,
+      store_hint hint = store_hint::normal) noexcept;
+  template <class T>
+    inline void native_to_big_n(T const* src, unsigned char* dst, std::size_t n,
+      store_hint hint = store_hint::normal) noexcept;
+  template <class T>
+    inline void native_to_little_n(T const* src, unsigned char* dst, std::size_t n,
+      store_hint hint = store_hint::normal) noexcept;
+
+  //------------------------------------------------------------------------------------//
+  //                                                                                    //
+  //                          variable length integer interfaces                        //
+  //                                                                                    //
+  //  LEB128 varints, 7 bits per byte, least significant group first, as in Protocol   //
+  //  Buffers and WebAssembly. The signed forms zigzag encode the value first. Loads    //
+  //  read at most n bytes, and return the number of bytes read, or 0 when the bytes   //
+  //  do not begin with a valid varint; stores return the number of bytes written.     //
+  //                                                                                    //
+  //------------------------------------------------------------------------------------//
+
+  //  in detail/endian_varint.hpp
+  //
+  //  template <class T> struct varint_max_size;
+  //
+  //  template <class T>
+  //    inline std::size_t load_varint_n(unsigned char const* src, std::size_t size,
+  //      T* dst, std::size_t n) noexcept;
+  //  template <class T>
+  //    inline std::size_t store_varint_n(T const* src, unsigned char* dst,
+  //      std::size_t n) noexcept;
+
+  inline std::size_t load_varint_u32(unsigned char const* p, std::size_t n, detail::uint32_t& v) noexcept;
+  inline std::size_t load_varint_s32(unsigned char const* p, std::size_t n, detail::int32_t& v) noexcept;
+  inline std::size_t load_varint_u64(unsigned char const* p, std::size_t n, detail::uint64_t& v) noexcept;
+  inline std::size_t load_varint_s64(unsigned char const* p, std::size_t n, detail::int64_t& v) noexcept;
+
+  inline std::size_t store_varint_u32(unsigned char* p, detail::uint32_t v) noexcept;
+  inline std::size_t store_varint_s32(unsigned char* p, detail::int32_t v) noexcept;
+  inline std::size_t store_varint_u64(unsigned char* p, detail::uint64_t v) noexcept;
+  inline std::size_t store_varint_s64(unsigned char* p, detail::int64_t v) noexcept;
+
+  //  0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+
+  inline detail::uint32_t zigzag_encode_s32(detail::int32_t v) noexcept;
+  inline detail::int32_t zigzag_decode_s32(detail::uint32_t v) noexcept;
+  inline detail::uint64_t zigzag_encode_s64(detail::int64_t v) noexcept;
+  inline detail::int64_t zigzag_decode_s64(detail::uint64_t v) noexcept;
+
 //----------------------------------- end synopsis -------------------------------------//
 
 template <class EndianReversible>
@@ -271,6 +395,167 @@ inline void conditional_reverse_inplace( EndianReversibleInplace& x,
     }
 }
 
+//--------------------------------------------------------------------------------------//
+//                         bulk reverse-in-place implementation                         //
+//--------------------------------------------------------------------------------------//
+
+template <class EndianReversibleInplace>
+inline void big_to_native_inplace_n( EndianReversibleInplace* p, std::size_t n ) noexcept
+{
+    boost::endian::conditional_reverse_inplace_n<order::big, order::native>( p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void native_to_big_inplace_n( EndianReversibleInplace* p, std::size_t n ) noexcept
+{
+    boost::endian::conditional_reverse_inplace_n<order::native, order::big>( p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void little_to_native_inplace_n( EndianReversibleInplace* p, std::size_t n ) noexcept
+{
+    boost::endian::conditional_reverse_inplace_n<order::little, order::native>( p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void native_to_little_inplace_n( EndianReversibleInplace* p, std::size_t n ) noexcept
+{
+    boost::endian::conditional_reverse_inplace_n<order::native, order::little>( p, n );
+}
+
+namespace detail
+{
+
+template<class EndianReversibleInplace>
+inline void conditional_reverse_inplace_n_impl( EndianReversibleInplace*, std::size_t, detail::true_type ) noexcept
+{
+}
+
+template<class EndianReversibleInplace>
+inline void conditional_reverse_inplace_n_impl( EndianReversibleInplace* p, std::size_t n, detail::false_type ) noexcept
+{
+    boost::endian::endian_reverse_inplace_n( p, n );
+}
+
+}  // namespace detail
+
+// generic conditional bulk reverse in place
+template <enum order From, enum order To, class EndianReversibleInplace>
+inline void conditional_reverse_inplace_n( EndianReversibleInplace* p, std::size_t n ) noexcept
+{
+    detail::conditional_reverse_inplace_n_impl( p, n, detail::integral_constant<bool, From == To>() );
+}
+
+// runtime bulk reverse in place
+template <class EndianReversibleInplace>
+inline void conditional_reverse_inplace_n( EndianReversibleInplace* p, std::size_t n,
+    enum order from_order, enum order to_order ) noexcept
+{
+    if( from_order != to_order )
+    {
+        boost::endian::endian_reverse_inplace_n( p, n );
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+//                          bulk copy-and-convert implementation                        //
+//--------------------------------------------------------------------------------------//
+
+namespace detail
+{
+
+template<class EndianReversibleInplace>
+inline void conditional_reverse_n_impl( EndianReversibleInplace const* src, EndianReversibleInplace* dst, std::size_t n, store_hint, detail::true_type ) noexcept
+{
+    if( src != dst )
+    {
+        std::copy( src, src + n, dst );
+    }
+}
+
+template<class EndianReversibleInplace>
+inline void conditional_reverse_n_impl( EndianReversibleInplace const* src, EndianReversibleInplace* dst, std::size_t n, store_hint hint, detail::false_type ) noexcept
+{
+    boost::endian::endian_reverse_n( src, dst, n, hint );
+}
+
+template<std::size_t N>
+inline void conditional_reverse_n_bytes( unsigned char const * src, unsigned char * dst, std::size_t n, store_hint, detail::true_type ) noexcept
+{
+    if( src != dst && n != 0 )
+    {
+        std::memcpy( dst, src, n * N );
+    }
+}
+
+template<std::size_t N>
+inline void conditional_reverse_n_bytes( unsigned char const * src, unsigned char * dst, std::size_t n, store_hint hint, detail::false_type ) noexcept
+{
+    detail::endian_reverse_n_copy<N>( src, dst, n, hint );
+}
+
+}  // namespace detail
+
+// generic conditional bulk copy-and-convert
+template <enum order From, enum order To, class EndianReversibleInplace>
+inline void conditional_reverse_n( EndianReversibleInplace const* src,
+    EndianReversibleInplace* dst, std::size_t n, store_hint hint ) noexcept
+{
+    detail::conditional_reverse_n_impl( src, dst, n, hint, detail::integral_constant<bool, From == To>() );
+}
+
+// runtime bulk copy-and-convert
+template <class EndianReversibleInplace>
+inline void conditional_reverse_n( EndianReversibleInplace const* src,
+    EndianReversibleInplace* dst, std::size_t n,
+    enum order from_order, enum order to_order, store_hint hint ) noexcept
+{
+    if( from_order == to_order )
+    {
+        detail::conditional_reverse_n_impl( src, dst, n, hint, detail::true_type() );
+    }
+    else
+    {
+        detail::conditional_reverse_n_impl( src, dst, n, hint, detail::false_type() );
+    }
+}
+
+template <class T>
+inline void big_to_native_n( unsigned char const* src, T* dst, std::size_t n, store_hint hint ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::conditional_reverse_n_bytes<sizeof(T)>( src, reinterpret_cast<unsigned char*>( dst ), n, hint,
+        detail::integral_constant<bool, order::big == order::native>() );
+}
+
+template <class T>
+inline void little_to_native_n( unsigned char const* src, T* dst, std::size_t n, store_hint hint ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::conditional_reverse_n_bytes<sizeof(T)>( src, reinterpret_cast<unsigned char*>( dst ), n, hint,
+        detail::integral_constant<bool, order::little == order::native>() );
+}
+
+template <class T>
+inline void native_to_big_n( T const* src, unsigned char* dst, std::size_t n, store_hint hint ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::conditional_reverse_n_bytes<sizeof(T)>( reinterpret_cast<unsigned char const*>( src ), dst, n, hint,
+        detail::integral_constant<bool, order::big == order::native>() );
+}
+
+template <class T>
+inline void native_to_little_n( T const* src, unsigned char* dst, std::size_t n, store_hint hint ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::conditional_reverse_n_bytes<sizeof(T)>( reinterpret_cast<unsigned char const*>( src ), dst, n, hint,
+        detail::integral_constant<bool, order::little == order::native>() );
+}
+
 // load/store convenience functions
 
 // load 16
@@ -581,6 +866,70 @@ inline void store_big_u64( unsigned char * p, detail::uint64_t v )
     boost::endian::endian_store<detail::uint64_t, 8, order::big>( p, v );
 }
 
+// varint
+
+inline std::size_t load_varint_u32( unsigned char const * p, std::size_t n, detail::uint32_t & v ) noexcept
+{
+    return detail::varint_load_one( p, n, v );
+}
+
+inline std::size_t load_varint_s32( unsigned char const * p, std::size_t n, detail::int32_t & v ) noexcept
+{
+    return detail::varint_load_one( p, n, v );
+}
+
+inline std::size_t load_varint_u64( unsigned char const * p, std::size_t n, detail::uint64_t & v ) noexcept
+{
+    return detail::varint_load_one( p, n, v );
+}
+
+inline std::size_t load_varint_s64( unsigned char const * p, std::size_t n, detail::int64_t & v ) noexcept
+{
+    return detail::varint_load_one( p, n, v );
+}
+
+inline std::size_t store_varint_u32( unsigned char * p, detail::uint32_t v ) noexcept
+{
+    return detail::varint_store_one( p, v );
+}
+
+inline std::size_t store_varint_s32( unsigned char * p, detail::int32_t v ) noexcept
+{
+    return detail::varint_store_one( p, v );
+}
+
+inline std::size_t store_varint_u64( unsigned char * p, detail::uint64_t v ) noexcept
+{
+    return detail::varint_store_one( p, v );
+}
+
+inline std::size_t store_varint_s64( unsigned char * p, detail::int64_t v ) noexcept
+{
+    return detail::varint_store_one( p, v );
+}
+
+// zigzag
+
+inline detail::uint32_t zigzag_encode_s32( detail::int32_t v ) noexcept
+{
+    return detail::zigzag_encode( v );
+}
+
+inline detail::int32_t zigzag_decode_s32( detail::uint32_t v ) noexcept
+{
+    return detail::zigzag_decode<detail::int32_t>( v );
+}
+
+inline detail::uint64_t zigzag_encode_s64( detail::int64_t v ) noexcept
+{
+    return detail::zigzag_encode( v );
+}
+
+inline detail::int64_t zigzag_decode_s64( detail::uint64_t v ) noexcept
+{
+    return detail::zigzag_decode<detail::int64_t>( v );
+}
+
 }  // namespace endian
 }  // namespace boost
 
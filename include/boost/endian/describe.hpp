@@ -0,0 +1,103 @@
+//  boost/endian/describe.hpp  --------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_DESCRIBE_HPP
+#define BOOST_ENDIAN_DESCRIBE_HPP
+
+#include <boost/endian/conversion.hpp>
+#include <boost/endian/detail/endian_describe.hpp>
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+//  BOOST_ENDIAN_DESCRIBE_STRUCT(T, m1, m2, ...)
+//
+//    At namespace scope, in the namespace of T. Lists the public data members of T
+//    that endian_reverse_inplace( T& ) reverses, and defines that function.
+//
+//  BOOST_ENDIAN_DESCRIBE_CLASS(T, m1, m2, ...)
+//
+//    Inside the definition of T. As above, but the members may be private, and
+//    the functions are friends of T, found by argument dependent lookup only.
+//
+//  Members may be of integral, enumeration, float or double type, arrays of
+//  such, or described types themselves. Up to 32 members may be listed.
+//
+//  Arrays of trivially copyable described types are converted by
+//  endian_reverse_inplace_n, endian_reverse_n and the functions built on them
+//  as a whole, with a byte permutation computed from the member offsets on
+//  first use, rather than member by member, unless a member straddles a
+//  16-byte boundary, as in a packed structure.
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+#define BOOST_ENDIAN_DESCRIBE_STRUCT(T, ...) \
+    template<class V> inline void boost_endian_describe_members( T & x, V & v ) \
+    { BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH(BOOST_ENDIAN_DESCRIBE_MEMBER_, __VA_ARGS__) } \
+    inline void endian_reverse_inplace( T & x ) noexcept \
+    { ::boost::endian::detail::endian_reverse_described( x ); }
+
+#define BOOST_ENDIAN_DESCRIBE_CLASS(T, ...) \
+    template<class V> friend void boost_endian_describe_members( T & x, V & v ) \
+    { BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH(BOOST_ENDIAN_DESCRIBE_MEMBER_, __VA_ARGS__) } \
+    friend void endian_reverse_inplace( T & x ) noexcept \
+    { ::boost::endian::detail::endian_reverse_described( x ); }
+
+#define BOOST_ENDIAN_DESCRIBE_MEMBER_(m) v( x.m );
+
+// implementation
+
+#define BOOST_ENDIAN_DESCRIBE_PP_EXPAND(x) x
+#define BOOST_ENDIAN_DESCRIBE_PP_CAT(a, b) BOOST_ENDIAN_DESCRIBE_PP_CAT_I(a, b)
+#define BOOST_ENDIAN_DESCRIBE_PP_CAT_I(a, b) a ## b
+
+#define BOOST_ENDIAN_DESCRIBE_PP_COUNT(...) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_COUNT_I(__VA_ARGS__, \
+    32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+
+#define BOOST_ENDIAN_DESCRIBE_PP_COUNT_I( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH(F, ...) BOOST_ENDIAN_DESCRIBE_PP_EXPAND( \
+    BOOST_ENDIAN_DESCRIBE_PP_CAT(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_, BOOST_ENDIAN_DESCRIBE_PP_COUNT(__VA_ARGS__))(F, __VA_ARGS__))
+
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_1(F, a) F(a)
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_2(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_1(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_3(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_2(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_4(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_3(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_5(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_4(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_6(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_5(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_7(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_6(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_8(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_7(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_9(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_8(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_10(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_9(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_11(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_10(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_12(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_11(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_13(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_12(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_14(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_13(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_15(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_14(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_16(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_15(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_17(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_16(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_18(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_17(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_19(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_18(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_20(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_19(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_21(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_20(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_22(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_21(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_23(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_22(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_24(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_23(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_25(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_24(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_26(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_25(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_27(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_26(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_28(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_27(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_29(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_28(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_30(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_29(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_31(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_30(F, __VA_ARGS__))
+#define BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_32(F, a, ...) F(a) BOOST_ENDIAN_DESCRIBE_PP_EXPAND(BOOST_ENDIAN_DESCRIBE_PP_FOR_EACH_31(F, __VA_ARGS__))
+
+#endif  // BOOST_ENDIAN_DESCRIBE_HPP
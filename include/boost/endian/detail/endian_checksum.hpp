@@ -0,0 +1,474 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_CHECKSUM_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_CHECKSUM_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// RFC 1071 Internet checksum
+//
+// The kernels add the bytes at p, read as big endian 16-bit words, to the
+// ones' complement sum *s; an odd last byte is the high byte of a word
+// padded with zero. Sums are kept in 64 bits with end around carry; as
+// 2^16 = 1 modulo 0xFFFF, every such sum folds to the same 16 bits as the
+// sum of the words, and swapping the bytes of a folded sum gives the sum
+// of the byte swapped words.
+
+inline uint64_t inet_add( uint64_t a, uint64_t b ) noexcept
+{
+    a += b;
+    return a + ( a < b );
+}
+
+inline uint16_t inet_fold( uint64_t s ) noexcept
+{
+    s = ( s & 0xFFFFFFFFu ) + ( s >> 32 );
+    s = ( s & 0xFFFFu ) + ( s >> 16 );
+    s = ( s & 0xFFFFu ) + ( s >> 16 );
+    s = ( s & 0xFFFFu ) + ( s >> 16 );
+
+    return static_cast<uint16_t>( s );
+}
+
+inline uint16_t inet_swap( uint16_t s ) noexcept
+{
+    return static_cast<uint16_t>( ( s << 8 ) | ( s >> 8 ) );
+}
+
+inline uint64_t inet_sum_bytes( unsigned char const * p, std::size_t n ) noexcept
+{
+    uint64_t a = 0;
+
+    for( ; n >= 2; p += 2, n -= 2 )
+    {
+        a += static_cast<unsigned>( p[ 0 ] << 8 | p[ 1 ] );
+    }
+
+    if( n != 0 )
+    {
+        a += static_cast<unsigned>( p[ 0 ] << 8 );
+    }
+
+    return a;
+}
+
+// the scalar kernel adds native 64-bit words, which sum the native 16-bit words
+
+inline void endian_inet_sum_scalar( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+{
+    uint64_t a = 0;
+    std::size_t i = 0;
+
+    for( ; i + 8 <= n; i += 8 )
+    {
+        uint64_t w;
+        std::memcpy( &w, p + i, 8 );
+
+        a = inet_add( a, w );
+    }
+
+    if( order::native == order::little )
+    {
+        a = inet_swap( inet_fold( a ) );
+    }
+
+    *s = inet_add( inet_add( *s, a ), inet_sum_bytes( p + i, n - i ) );
+}
+
+// The vector kernels sum all the bytes, and the bytes at even offsets, the
+// high bytes of the big endian words, with psadbw into 64-bit lanes; the sum
+// of the words is then 256 * even + ( all - even ), where the multiplication
+// is a rotation, to keep the carries out of the top.
+
+inline uint64_t inet_combine( uint64_t all, uint64_t even ) noexcept
+{
+    return inet_add( ( even << 8 ) | ( even >> 56 ), all - even );
+}
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+BOOST_ENDIAN_TARGET_SSSE3 inline void endian_inet_sum_ssse3( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+{
+    __m128i const mask = _mm_set1_epi16( 0x00FF );
+    __m128i const zero = _mm_setzero_si128();
+
+    __m128i t = zero;
+    __m128i e = zero;
+
+    std::size_t i = 0;
+
+    for( ; i + 16 <= n; i += 16 )
+    {
+        __m128i v = _mm_loadu_si128( reinterpret_cast<__m128i const*>( p + i ) );
+
+        t = _mm_add_epi64( t, _mm_sad_epu8( v, zero ) );
+        e = _mm_add_epi64( e, _mm_sad_epu8( _mm_and_si128( v, mask ), zero ) );
+    }
+
+    uint64_t a[ 2 ], b[ 2 ];
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( a ), t );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( b ), e );
+
+    *s = inet_add( inet_add( *s, inet_combine( a[ 0 ] + a[ 1 ], b[ 0 ] + b[ 1 ] ) ), inet_sum_bytes( p + i, n - i ) );
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+BOOST_ENDIAN_TARGET_AVX2 inline void endian_inet_sum_avx2( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+{
+    __m256i const mask = _mm256_set1_epi16( 0x00FF );
+    __m256i const zero = _mm256_setzero_si256();
+
+    __m256i t = zero;
+    __m256i e = zero;
+
+    std::size_t i = 0;
+
+    for( ; i + 32 <= n; i += 32 )
+    {
+        __m256i v = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( p + i ) );
+
+        t = _mm256_add_epi64( t, _mm256_sad_epu8( v, zero ) );
+        e = _mm256_add_epi64( e, _mm256_sad_epu8( _mm256_and_si256( v, mask ), zero ) );
+    }
+
+    uint64_t a[ 4 ], b[ 4 ];
+
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( a ), t );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( b ), e );
+
+    *s = inet_add( inet_add( *s, inet_combine( a[ 0 ] + a[ 1 ] + a[ 2 ] + a[ 3 ], b[ 0 ] + b[ 1 ] + b[ 2 ] + b[ 3 ] ) ), inet_sum_bytes( p + i, n - i ) );
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+BOOST_ENDIAN_TARGET_AVX512 inline void endian_inet_sum_avx512( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+{
+    __m512i const mask = _mm512_set1_epi16( 0x00FF );
+    __m512i const zero = _mm512_setzero_si512();
+
+    __m512i t = zero;
+    __m512i e = zero;
+
+    std::size_t i = 0;
+
+    for( ; i + 64 <= n; i += 64 )
+    {
+        __m512i v = _mm512_loadu_si512( p + i );
+
+        t = _mm512_add_epi64( t, _mm512_sad_epu8( v, zero ) );
+        e = _mm512_add_epi64( e, _mm512_sad_epu8( _mm512_and_si512( v, mask ), zero ) );
+    }
+
+    uint64_t a[ 8 ], b[ 8 ];
+
+    _mm512_storeu_si512( a, t );
+    _mm512_storeu_si512( b, e );
+
+    uint64_t ta = 0, tb = 0;
+
+    for( int k = 0; k < 8; ++k )
+    {
+        ta += a[ k ];
+        tb += b[ k ];
+    }
+
+    *s = inet_add( inet_add( *s, inet_combine( ta, tb ) ), inet_sum_bytes( p + i, n - i ) );
+}
+
+#endif
+
+struct endian_inet_sum_simd
+{
+    static void scalar( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+    {
+        endian_inet_sum_scalar( p, n, s );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+    {
+        endian_inet_sum_ssse3( p, n, s );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+    {
+        endian_inet_sum_avx2( p, n, s );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( unsigned char const * p, std::size_t n, uint64_t * s ) noexcept
+    {
+        endian_inet_sum_avx512( p, n, s );
+    }
+
+#endif
+};
+
+// CRC-32C, the Castagnoli CRC of iSCSI, SCTP, ext4 and Btrfs, with the
+// reflected polynomial 0x82F63B78
+//
+// The kernels update the CRC register *r, without the initial and final
+// inversions. The scalar kernel uses slicing-by-8 tables. The SSE4.2 crc32
+// instruction, which every AVX2 processor has, is used at the AVX2 and
+// AVX-512 levels; its latency is three cycles, so inputs of three or more
+// stripes are processed as three interleaved streams, which are combined by
+// shifting the CRC of one stripe over the zero bytes of the next with the
+// shift tables.
+
+static const uint32_t crc32c_polynomial = 0x82F63B78u;
+static const std::size_t crc32c_stripe = 512;
+
+// 32x32 matrices over GF(2), as the images of the 32 unit vectors
+
+inline uint32_t crc32c_matrix_times( uint32_t const * m, uint32_t v ) noexcept
+{
+    uint32_t r = 0;
+
+    for( ; v != 0; v >>= 1, ++m )
+    {
+        if( v & 1 )
+        {
+            r ^= *m;
+        }
+    }
+
+    return r;
+}
+
+inline void crc32c_matrix_square( uint32_t * r, uint32_t const * m ) noexcept
+{
+    for( int k = 0; k < 32; ++k )
+    {
+        r[ k ] = crc32c_matrix_times( m, m[ k ] );
+    }
+}
+
+struct crc32c_tables
+{
+    uint32_t slice[ 8 ][ 256 ];
+    uint32_t shift[ 4 ][ 256 ];
+
+    crc32c_tables() noexcept
+    {
+        for( uint32_t n = 0; n < 256; ++n )
+        {
+            uint32_t c = n;
+
+            for( int k = 0; k < 8; ++k )
+            {
+                c = c & 1? ( c >> 1 ) ^ crc32c_polynomial: c >> 1;
+            }
+
+            slice[ 0 ][ n ] = c;
+        }
+
+        for( uint32_t n = 0; n < 256; ++n )
+        {
+            uint32_t c = slice[ 0 ][ n ];
+
+            for( int k = 1; k < 8; ++k )
+            {
+                c = slice[ 0 ][ c & 0xFF ] ^ ( c >> 8 );
+                slice[ k ][ n ] = c;
+            }
+        }
+
+        // the operator for one zero bit, squared up to crc32c_stripe zero bytes
+
+        uint32_t a[ 32 ], b[ 32 ];
+
+        a[ 0 ] = crc32c_polynomial;
+
+        for( int k = 1; k < 32; ++k )
+        {
+            a[ k ] = uint32_t( 1 ) << ( k - 1 );
+        }
+
+        for( std::size_t bits = 1; bits < crc32c_stripe * 8; bits *= 2 )
+        {
+            crc32c_matrix_square( b, a );
+            std::memcpy( a, b, sizeof(a) );
+        }
+
+        for( uint32_t n = 0; n < 256; ++n )
+        {
+            shift[ 0 ][ n ] = crc32c_matrix_times( a, n );
+            shift[ 1 ][ n ] = crc32c_matrix_times( a, n << 8 );
+            shift[ 2 ][ n ] = crc32c_matrix_times( a, n << 16 );
+            shift[ 3 ][ n ] = crc32c_matrix_times( a, n << 24 );
+        }
+    }
+};
+
+inline crc32c_tables const & crc32c_get_tables() noexcept
+{
+    static const crc32c_tables t;
+    return t;
+}
+
+inline void endian_crc32c_scalar( unsigned char const * p, std::size_t n, uint32_t * r ) noexcept
+{
+    uint32_t const (*t)[ 256 ] = crc32c_get_tables().slice;
+
+    uint32_t c = *r;
+
+    for( ; n >= 8; p += 8, n -= 8 )
+    {
+        uint32_t const lo = c ^ boost::endian::endian_load<uint32_t, 4, order::little>( p );
+        uint32_t const hi = boost::endian::endian_load<uint32_t, 4, order::little>( p + 4 );
+
+        c = t[ 7 ][ lo & 0xFF ] ^ t[ 6 ][ ( lo >> 8 ) & 0xFF ] ^ t[ 5 ][ ( lo >> 16 ) & 0xFF ] ^ t[ 4 ][ lo >> 24 ] ^
+            t[ 3 ][ hi & 0xFF ] ^ t[ 2 ][ ( hi >> 8 ) & 0xFF ] ^ t[ 1 ][ ( hi >> 16 ) & 0xFF ] ^ t[ 0 ][ hi >> 24 ];
+    }
+
+    for( ; n != 0; ++p, --n )
+    {
+        c = t[ 0 ][ ( c ^ *p ) & 0xFF ] ^ ( c >> 8 );
+    }
+
+    *r = c;
+}
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+BOOST_ENDIAN_TARGET_AVX2 inline uint32_t crc32c_u64( uint32_t c, unsigned char const * p ) noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64)
+
+    unsigned long long w;
+    std::memcpy( &w, p, 8 );
+
+    return static_cast<uint32_t>( _mm_crc32_u64( c, w ) );
+
+#else
+
+    unsigned int w[ 2 ];
+    std::memcpy( w, p, 8 );
+
+    return _mm_crc32_u32( _mm_crc32_u32( c, w[ 0 ] ), w[ 1 ] );
+
+#endif
+}
+
+inline uint32_t crc32c_shift( crc32c_tables const & t, uint32_t c ) noexcept
+{
+    return t.shift[ 0 ][ c & 0xFF ] ^ t.shift[ 1 ][ ( c >> 8 ) & 0xFF ] ^ t.shift[ 2 ][ ( c >> 16 ) & 0xFF ] ^ t.shift[ 3 ][ c >> 24 ];
+}
+
+BOOST_ENDIAN_TARGET_AVX2 inline void endian_crc32c_sse42( unsigned char const * p, std::size_t n, uint32_t * r ) noexcept
+{
+    std::size_t const L = crc32c_stripe;
+
+    uint32_t c0 = *r;
+
+    if( n >= 3 * L )
+    {
+        crc32c_tables const & t = crc32c_get_tables();
+
+        do
+        {
+            uint32_t c1 = 0, c2 = 0;
+
+            for( std::size_t i = 0; i < L; i += 8 )
+            {
+                c0 = crc32c_u64( c0, p + i );
+                c1 = crc32c_u64( c1, p + L + i );
+                c2 = crc32c_u64( c2, p + 2 * L + i );
+            }
+
+            c0 = crc32c_shift( t, c0 ) ^ c1;
+            c0 = crc32c_shift( t, c0 ) ^ c2;
+
+            p += 3 * L;
+            n -= 3 * L;
+        }
+        while( n >= 3 * L );
+    }
+
+    for( ; n >= 8; p += 8, n -= 8 )
+    {
+        c0 = crc32c_u64( c0, p );
+    }
+
+    for( ; n != 0; ++p, --n )
+    {
+        c0 = _mm_crc32_u8( c0, *p );
+    }
+
+    *r = c0;
+}
+
+#endif
+
+struct endian_crc32c_simd
+{
+    static void scalar( unsigned char const * p, std::size_t n, uint32_t * r ) noexcept
+    {
+        endian_crc32c_scalar( p, n, r );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    // SSSE3 processors need not have SSE4.2
+
+    static void ssse3( unsigned char const * p, std::size_t n, uint32_t * r ) noexcept
+    {
+        endian_crc32c_scalar( p, n, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( unsigned char const * p, std::size_t n, uint32_t * r ) noexcept
+    {
+        endian_crc32c_sse42( p, n, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( unsigned char const * p, std::size_t n, uint32_t * r ) noexcept
+    {
+        endian_crc32c_sse42( p, n, r );
+    }
+
+#endif
+};
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_CHECKSUM_HPP_INCLUDED
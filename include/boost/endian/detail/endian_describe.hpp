@@ -0,0 +1,533 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_DESCRIBE_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_DESCRIBE_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/endian_reverse.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <cstddef>
+#include <utility>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// Support for the types described with BOOST_ENDIAN_DESCRIBE, in
+// <boost/endian/describe.hpp>. The macro defines, next to the type,
+//
+//     template<class V> void boost_endian_describe_members( T & x, V & v );
+//
+// calling v( x.m ) for each listed member m, in order.
+
+void boost_endian_describe_members();
+
+struct endian_describe_probe
+{
+    template<class M> void operator()( M & ) const noexcept
+    {
+    }
+};
+
+template<class T, class E = void> struct is_endian_described: false_type
+{
+};
+
+template<class T> struct is_endian_described<T, decltype( boost_endian_describe_members( std::declval<T&>(), std::declval<endian_describe_probe&>() ) )>: true_type
+{
+};
+
+// member by member reversal; described members are descended into, others
+// are reversed with an unqualified endian_reverse_inplace
+
+struct endian_describe_reverse
+{
+    template<class M> void reverse( M & m, true_type ) const noexcept
+    {
+        boost_endian_describe_members( m, *this );
+    }
+
+    template<class M> void reverse( M & m, false_type ) const noexcept
+    {
+        using boost::endian::endian_reverse_inplace;
+        endian_reverse_inplace( m );
+    }
+
+    template<class M, std::size_t N> void operator()( M (&m)[ N ] ) const noexcept
+    {
+        for( std::size_t i = 0; i < N; ++i )
+        {
+            ( *this )( m[ i ] );
+        }
+    }
+
+    template<class M> void operator()( M & m ) const noexcept
+    {
+        reverse( m, integral_constant<bool, is_endian_described<M>::value>() );
+    }
+};
+
+template<class T> inline void endian_reverse_described( T & x ) noexcept
+{
+    endian_describe_reverse v;
+    boost_endian_describe_members( x, v );
+}
+
+// Arrays of trivially copyable described types are reversed as a whole,
+// with a byte permutation computed once from the member offsets. The
+// permutation covers `period` bytes, a whole number of objects and a
+// multiple of 64 bytes where possible, and is applied one vector ("chunk")
+// at a time. The byte shuffles only move bytes within 16-byte lanes, which
+// is enough as long as the members are aligned; when one straddles a lane,
+// as in a packed structure, the objects are reversed member by member.
+// Chunks that do not change, such as those holding character arrays, are
+// skipped.
+
+struct endian_permutation
+{
+    // the longest period; the permutation is held in fixed storage, so that
+    // building it on first use does not allocate
+
+    static const std::size_t max_period = 4096;
+
+    // false when a member is not reversible in place, an array of such, or
+    // a described type, when members overlap or straddle a lane, or when
+    // the period would be too long; the objects are then reversed member by
+    // member
+
+    bool valid;
+
+    std::size_t period;
+
+    // the shuffle mask for each byte of the period
+
+    unsigned char mask[ max_period ];
+
+    // the offsets of the chunks of one period that change, for 16, 32 and
+    // 64 byte vectors; `width` is 0 when the list is not used, because the
+    // period is not a multiple of the vector size, or because the chunks
+    // are so sparse that reversing the members one by one is faster
+
+    struct chunk_list
+    {
+        std::size_t width;
+        std::size_t count;
+        uint16_t chunks[ max_period / 16 ];
+    };
+
+    chunk_list lists[ 3 ];
+};
+
+// Where each byte of one object comes from, once its members are reversed;
+// valid is false when members overlap or do not fit
+
+struct endian_permutation_map
+{
+    std::size_t size;
+    std::size_t members;
+    bool valid;
+
+    uint16_t src[ endian_permutation::max_period ];
+    uint64_t used[ endian_permutation::max_period / 64 ];
+};
+
+inline void endian_permutation_map_init( endian_permutation_map & m, std::size_t size ) noexcept
+{
+    m.size = size;
+    m.members = 0;
+    m.valid = size <= endian_permutation::max_period;
+
+    for( std::size_t i = 0; i < size && m.valid; ++i )
+    {
+        m.src[ i ] = static_cast<uint16_t>( i );
+    }
+
+    for( std::size_t i = 0; i < endian_permutation::max_period / 64; ++i )
+    {
+        m.used[ i ] = 0;
+    }
+}
+
+// the member of n bytes at offset first is reversed
+
+inline void endian_permutation_map_add( endian_permutation_map & m, std::size_t first, std::size_t n ) noexcept
+{
+    if( !m.valid )
+    {
+        return;
+    }
+
+    if( first > m.size || n > m.size - first )
+    {
+        m.valid = false;
+        return;
+    }
+
+    for( std::size_t t = 0; t < n; ++t )
+    {
+        std::size_t const i = first + t;
+
+        if( ( m.used[ i / 64 ] >> i % 64 ) & 1 )
+        {
+            m.valid = false; // overlapping members, as in a union
+            return;
+        }
+
+        m.used[ i / 64 ] |= uint64_t( 1 ) << i % 64;
+        m.src[ i ] = static_cast<uint16_t>( first + n - 1 - t );
+    }
+
+    ++m.members;
+}
+
+// collects the offset and size of each member to reverse
+
+struct endian_permutation_builder
+{
+    unsigned char const * base;
+    endian_permutation_map * map;
+    bool valid;
+
+    template<class M> void add( M & m, true_type ) noexcept
+    {
+        if( sizeof(M) > 1 )
+        {
+            endian_permutation_map_add( *map, static_cast<std::size_t>( reinterpret_cast<unsigned char const*>( &m ) - base ), sizeof(M) );
+        }
+    }
+
+    template<class M> void add( M & m, false_type ) noexcept
+    {
+        visit( m, integral_constant<bool, is_endian_described<M>::value>() );
+    }
+
+    template<class M> void visit( M & m, true_type ) noexcept
+    {
+        boost_endian_describe_members( m, *this );
+    }
+
+    template<class M> void visit( M &, false_type ) noexcept
+    {
+        valid = false;
+    }
+
+    template<class M, std::size_t N> void operator()( M (&m)[ N ] ) noexcept
+    {
+        for( std::size_t i = 0; i < N; ++i )
+        {
+            ( *this )( m[ i ] );
+        }
+    }
+
+    template<class M> void operator()( M & m ) noexcept
+    {
+        add( m, integral_constant<bool, is_endian_reversible_inplace<M>::value>() );
+    }
+};
+
+inline std::size_t endian_permutation_period( std::size_t size, std::size_t width ) noexcept
+{
+    std::size_t k = 1;
+
+    while( k * size % width != 0 )
+    {
+        ++k;
+    }
+
+    return k * size;
+}
+
+inline void endian_permutation_compile( endian_permutation & r, endian_permutation_map const & m ) noexcept
+{
+    if( !m.valid || m.size == 0 )
+    {
+        return;
+    }
+
+    std::size_t const size = m.size;
+
+    std::size_t P = endian_permutation_period( size, 64 );
+
+    if( P > endian_permutation::max_period )
+    {
+        P = endian_permutation_period( size, 16 );
+    }
+
+    if( P > endian_permutation::max_period )
+    {
+        return;
+    }
+
+    // the byte at i comes from i / size * size + m.src[ i % size ]
+
+    for( std::size_t i = 0; i < P; ++i )
+    {
+        std::size_t const w = i / 16 * 16;
+        std::size_t const src = i / size * size + m.src[ i % size ];
+
+        if( src < w || src >= w + 16 )
+        {
+            return;
+        }
+
+        r.mask[ i ] = static_cast<unsigned char>( src - w );
+    }
+
+    r.valid = true;
+    r.period = P;
+
+    for( std::size_t k = 0; k < 3; ++k )
+    {
+        std::size_t const L = std::size_t( 16 ) << k;
+
+        endian_permutation::chunk_list & list = r.lists[ k ];
+
+        list.width = P % L == 0? L: 0;
+        list.count = 0;
+
+        for( std::size_t w = 0; list.width != 0 && w < P; w += L )
+        {
+            for( std::size_t i = w; i < w + L; ++i )
+            {
+                if( i / size * size + m.src[ i % size ] != i )
+                {
+                    list.chunks[ list.count++ ] = static_cast<uint16_t>( w );
+                    break;
+                }
+            }
+        }
+
+        // a chunk costs about as much as four scalar member reversals
+
+        if( list.count * 4 > m.members * ( P / size ) )
+        {
+            list.width = 0;
+        }
+    }
+}
+
+template<class T> inline endian_permutation endian_permutation_make() noexcept
+{
+    endian_permutation r;
+    r.valid = false;
+    r.period = sizeof(T);
+
+    for( std::size_t k = 0; k < 3; ++k )
+    {
+        r.lists[ k ].width = 0;
+        r.lists[ k ].count = 0;
+    }
+
+    // only the member addresses are taken; the object is not accessed
+
+    alignas( T ) unsigned char buffer[ sizeof(T) ];
+    T & x = *reinterpret_cast<T*>( buffer );
+
+    endian_permutation_map m;
+    endian_permutation_map_init( m, sizeof(T) );
+
+    endian_permutation_builder b = { buffer, &m, true };
+    boost_endian_describe_members( x, b );
+
+    if( b.valid )
+    {
+        endian_permutation_compile( r, m );
+    }
+
+    return r;
+}
+
+template<class T> inline endian_permutation const & endian_permutation_of() noexcept
+{
+    static endian_permutation const r = endian_permutation_make<T>();
+    return r;
+}
+
+// The kernels apply the permutation to the whole periods in [p, p + size)
+// and return the number of bytes done.
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+BOOST_ENDIAN_TARGET_SSSE3 inline std::size_t endian_permute_ssse3( unsigned char * p, std::size_t size, endian_permutation const & perm ) noexcept
+{
+    uint16_t const * ch = perm.lists[ 0 ].chunks;
+    std::size_t const C = perm.lists[ 0 ].count;
+
+    unsigned char const * mask = perm.mask;
+
+    std::size_t b = 0;
+
+    for( ; b + perm.period <= size; b += perm.period )
+    {
+        unsigned char * q = p + b;
+
+        for( std::size_t j = 0; j < C; ++j )
+        {
+            __m128i v = _mm_loadu_si128( reinterpret_cast<__m128i const*>( q + ch[ j ] ) );
+            v = _mm_shuffle_epi8( v, _mm_loadu_si128( reinterpret_cast<__m128i const*>( mask + ch[ j ] ) ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( q + ch[ j ] ), v );
+        }
+    }
+
+    return b;
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+BOOST_ENDIAN_TARGET_AVX2 inline std::size_t endian_permute_avx2( unsigned char * p, std::size_t size, endian_permutation const & perm ) noexcept
+{
+    uint16_t const * ch = perm.lists[ 1 ].chunks;
+    std::size_t const C = perm.lists[ 1 ].count;
+
+    unsigned char const * mask = perm.mask;
+
+    std::size_t b = 0;
+
+    for( ; b + perm.period <= size; b += perm.period )
+    {
+        unsigned char * q = p + b;
+
+        for( std::size_t j = 0; j < C; ++j )
+        {
+            __m256i v = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( q + ch[ j ] ) );
+            v = _mm256_shuffle_epi8( v, _mm256_loadu_si256( reinterpret_cast<__m256i const*>( mask + ch[ j ] ) ) );
+            _mm256_storeu_si256( reinterpret_cast<__m256i*>( q + ch[ j ] ), v );
+        }
+    }
+
+    return b;
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+BOOST_ENDIAN_TARGET_AVX512 inline std::size_t endian_permute_avx512( unsigned char * p, std::size_t size, endian_permutation const & perm ) noexcept
+{
+    uint16_t const * ch = perm.lists[ 2 ].chunks;
+    std::size_t const C = perm.lists[ 2 ].count;
+
+    unsigned char const * mask = perm.mask;
+
+    std::size_t b = 0;
+
+    for( ; b + perm.period <= size; b += perm.period )
+    {
+        unsigned char * q = p + b;
+
+        for( std::size_t j = 0; j < C; ++j )
+        {
+            __m512i v = _mm512_loadu_si512( q + ch[ j ] );
+            v = _mm512_shuffle_epi8( v, _mm512_loadu_si512( mask + ch[ j ] ) );
+            _mm512_storeu_si512( q + ch[ j ], v );
+        }
+    }
+
+    return b;
+}
+
+#endif
+
+template<class T> struct endian_reverse_described_n_simd
+{
+    static void scalar( T * p, std::size_t n, endian_permutation const * ) noexcept
+    {
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            endian_reverse_described( p[ i ] );
+        }
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( T * p, std::size_t n, endian_permutation const * perm ) noexcept
+    {
+        if( perm->lists[ 0 ].width == 0 )
+        {
+            scalar( p, n, perm );
+            return;
+        }
+
+        std::size_t const i = endian_permute_ssse3( reinterpret_cast<unsigned char*>( p ), n * sizeof(T), *perm ) / sizeof(T);
+        scalar( p + i, n - i, perm );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( T * p, std::size_t n, endian_permutation const * perm ) noexcept
+    {
+        if( perm->lists[ 1 ].width == 0 )
+        {
+            ssse3( p, n, perm );
+            return;
+        }
+
+        std::size_t const i = endian_permute_avx2( reinterpret_cast<unsigned char*>( p ), n * sizeof(T), *perm ) / sizeof(T);
+        ssse3( p + i, n - i, perm );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( T * p, std::size_t n, endian_permutation const * perm ) noexcept
+    {
+        if( perm->lists[ 2 ].width == 0 )
+        {
+            avx2( p, n, perm );
+            return;
+        }
+
+        std::size_t const i = endian_permute_avx512( reinterpret_cast<unsigned char*>( p ), n * sizeof(T), *perm ) / sizeof(T);
+        ssse3( p + i, n - i, perm );
+    }
+
+#endif
+};
+
+// Requires:
+//   T is trivially copyable and described
+
+template<class T> inline void endian_reverse_described_n( T * p, std::size_t n ) noexcept
+{
+    if( n == 0 )
+    {
+        return;
+    }
+
+    endian_permutation const & perm = endian_permutation_of<T>();
+
+    if( !perm.valid || n * sizeof(T) < perm.period )
+    {
+        endian_reverse_described_n_simd<T>::scalar( p, n, &perm );
+        return;
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3) || defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    simd_invoke< endian_reverse_described_n_simd<T> >( p, n, &perm );
+
+#else
+
+    endian_reverse_described_n_simd<T>::scalar( p, n, &perm );
+
+#endif
+}
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_DESCRIBE_HPP_INCLUDED
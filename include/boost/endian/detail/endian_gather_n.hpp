@@ -0,0 +1,455 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_GATHER_N_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_GATHER_N_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_load_n.hpp>
+#include <boost/endian/detail/endian_reverse_n.hpp>
+#include <boost/endian/detail/endian_store.hpp>
+#include <boost/endian/detail/endian_store_n.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// Strided loads and stores of one N-byte field of each of n records, the
+// field of record i starting at p + i * stride.
+//
+// The gather kernels fetch S = sizeof(T) bytes at the start of each field
+// with AVX2 or AVX-512 gather instructions, move the N field bytes to the
+// top of the lane with a byte shuffle, and extend them with a shift as in
+// endian_load_n. A gather of S > N bytes reads S - N bytes past the field,
+// so the last records, for which these bytes may lie past the end of the
+// array, are loaded one at a time.
+//
+// AVX2 gathers are slower than scalar loads of whole 4 or 8 byte fields, and
+// only pay off when N < S. Stores of part of a lane have no instruction, and
+// converting into a buffer and copying the fields out is no faster than the
+// scalar loop, so the only vector store kernel is the AVX-512 scatter, for
+// N == S.
+
+template<class T, std::size_t N, order Order>
+inline void endian_gather_n_scalar( unsigned char const * p, std::size_t stride, T * dst, std::size_t n ) noexcept
+{
+    for( std::size_t i = 0; i < n; ++i, p += stride )
+    {
+        dst[ i ] = boost::endian::endian_load<T, N, Order>( p );
+    }
+}
+
+template<class T, std::size_t N, order Order>
+inline void endian_scatter_n_scalar( T const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+{
+    for( std::size_t i = 0; i < n; ++i, p += stride )
+    {
+        boost::endian::endian_store<T, N, Order>( p, src[ i ] );
+    }
+}
+
+// shuffle control for one 16-byte lane of gathered S-byte values; the N
+// field bytes are at the bottom of each value, and go to the top
+
+template<std::size_t S, std::size_t N, order Order>
+inline void endian_gather_n_mask( unsigned char (&m)[ 16 ] ) noexcept
+{
+    for( std::size_t b = 0; b < 16; ++b )
+    {
+        std::size_t const v = b / S;
+        std::size_t const t = b % S;
+
+        if( t < S - N )
+        {
+            m[ b ] = 0x80;
+        }
+        else
+        {
+            std::size_t const q = t - ( S - N ); // significance of the byte within the value
+
+            m[ b ] = static_cast<unsigned char>( v * S + ( Order == order::little? q: N - 1 - q ) );
+        }
+    }
+}
+
+// the number of trailing records whose gather would read past the field of
+// the last record
+
+template<std::size_t S, std::size_t N>
+inline std::size_t endian_gather_n_tail( std::size_t stride, std::size_t n ) noexcept
+{
+    if( S == N )
+    {
+        return 0;
+    }
+
+    std::size_t const k = stride == 0? n: ( S - N + stride - 1 ) / stride;
+    return k < n? k: n;
+}
+
+// the gather instructions take 32-bit signed offsets
+
+inline bool endian_gather_n_stride_ok( std::size_t stride ) noexcept
+{
+    return stride <= 0x7FFFFFF;
+}
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+template<std::size_t S> struct endian_gather_n_avx2_ops;
+
+template<> struct endian_gather_n_avx2_ops<4>
+{
+    static std::size_t const V = 8;
+
+    BOOST_ENDIAN_TARGET_AVX2 static __m256i gather( unsigned char const * p, int stride ) noexcept
+    {
+        __m256i const index = _mm256_mullo_epi32( _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ), _mm256_set1_epi32( stride ) );
+        return _mm256_i32gather_epi32( reinterpret_cast<int const*>( p ), index, 1 );
+    }
+};
+
+template<> struct endian_gather_n_avx2_ops<8>
+{
+    static std::size_t const V = 4;
+
+    BOOST_ENDIAN_TARGET_AVX2 static __m256i gather( unsigned char const * p, int stride ) noexcept
+    {
+        __m128i const index = _mm_mullo_epi32( _mm_setr_epi32( 0, 1, 2, 3 ), _mm_set1_epi32( stride ) );
+        return _mm256_i32gather_epi64( reinterpret_cast<long long const*>( p ), index, 1 );
+    }
+};
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_AVX2 inline void endian_gather_n_avx2( unsigned char const * p, std::size_t stride, T * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+
+    if( N == S )
+    {
+        endian_gather_n_scalar<T, N, Order>( p, stride, dst, n );
+        return;
+    }
+
+    typedef endian_gather_n_avx2_ops<S> ops;
+    typedef endian_load_n_extend<S, N, is_signed<T>::value> extend;
+
+    std::size_t const V = ops::V;
+
+    unsigned char m[ 16 ];
+    endian_gather_n_mask<S, N, Order>( m );
+
+    __m256i const mask = _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) ) );
+
+    std::size_t const last = n - endian_gather_n_tail<S, N>( stride, n );
+
+    std::size_t i = 0;
+
+    for( ; i + V <= last; i += V, p += V * stride )
+    {
+        __m256i v = _mm256_shuffle_epi8( ops::gather( p, static_cast<int>( stride ) ), mask );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst + i ), extend::avx2( v ) );
+    }
+
+    endian_gather_n_scalar<T, N, Order>( p, stride, dst + i, n - i );
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+template<std::size_t S> struct endian_gather_n_avx512_ops;
+
+template<> struct endian_gather_n_avx512_ops<4>
+{
+    static std::size_t const V = 16;
+
+    BOOST_ENDIAN_TARGET_AVX512 static __m512i index( int stride ) noexcept
+    {
+        return _mm512_mullo_epi32( _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ), _mm512_set1_epi32( stride ) );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX512 static __m512i gather( unsigned char const * p, __m512i index ) noexcept
+    {
+        return _mm512_mask_i32gather_epi32( _mm512_setzero_si512(), 0xFFFF, index, p, 1 );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX512 static void scatter( unsigned char * p, __m512i index, __m512i v ) noexcept
+    {
+        _mm512_i32scatter_epi32( p, index, v, 1 );
+    }
+};
+
+template<> struct endian_gather_n_avx512_ops<8>
+{
+    static std::size_t const V = 8;
+
+    BOOST_ENDIAN_TARGET_AVX512 static __m256i index( int stride ) noexcept
+    {
+        return _mm256_mullo_epi32( _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ), _mm256_set1_epi32( stride ) );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX512 static __m512i gather( unsigned char const * p, __m256i index ) noexcept
+    {
+        return _mm512_mask_i32gather_epi64( _mm512_setzero_si512(), 0xFF, index, p, 1 );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX512 static void scatter( unsigned char * p, __m256i index, __m512i v ) noexcept
+    {
+        _mm512_i32scatter_epi64( p, index, v, 1 );
+    }
+};
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_AVX512 inline void endian_gather_n_avx512( unsigned char const * p, std::size_t stride, T * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+
+    typedef endian_gather_n_avx512_ops<S> ops;
+    typedef endian_load_n_extend<S, N, is_signed<T>::value> extend;
+
+    std::size_t const V = ops::V;
+
+    unsigned char m[ 16 ];
+    endian_gather_n_mask<S, N, Order>( m );
+
+    __m512i const mask = _mm512_maskz_broadcast_i32x4( 0xFFFF, _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) ) );
+    auto const index = ops::index( static_cast<int>( stride ) );
+
+    std::size_t const last = n - endian_gather_n_tail<S, N>( stride, n );
+
+    std::size_t i = 0;
+
+    for( ; i + V <= last; i += V, p += V * stride )
+    {
+        __m512i v = _mm512_shuffle_epi8( ops::gather( p, index ), mask );
+
+        if( N < S )
+        {
+            v = extend::avx512( v );
+        }
+
+        _mm512_storeu_si512( dst + i, v );
+    }
+
+    endian_gather_n_scalar<T, N, Order>( p, stride, dst + i, n - i );
+}
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_AVX512 inline void endian_scatter_n_avx512( T const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+
+    if( N < S )
+    {
+        endian_scatter_n_scalar<T, N, Order>( src, p, stride, n );
+        return;
+    }
+
+    typedef endian_gather_n_avx512_ops<S> ops;
+
+    std::size_t const V = ops::V;
+
+    __m512i const mask = _mm512_maskz_broadcast_i32x4( 0xFFFF, _mm_loadu_si128( reinterpret_cast<__m128i const*>( endian_reverse_n_mask<S>::get() ) ) );
+    auto const index = ops::index( static_cast<int>( stride ) );
+
+    std::size_t i = 0;
+
+    for( ; i + V <= n; i += V, p += V * stride )
+    {
+        __m512i v = _mm512_loadu_si512( src + i );
+
+        if( Order != order::native )
+        {
+            v = _mm512_shuffle_epi8( v, mask );
+        }
+
+        ops::scatter( p, index, v );
+    }
+
+    endian_scatter_n_scalar<T, N, Order>( src + i, p, stride, n - i );
+}
+
+#endif
+
+template<class T, std::size_t N, order Order> struct endian_gather_n_simd
+{
+    static void scalar( unsigned char const * p, std::size_t stride, T * dst, std::size_t n ) noexcept
+    {
+        endian_gather_n_scalar<T, N, Order>( p, stride, dst, n );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    // no gather instruction
+
+    static void ssse3( unsigned char const * p, std::size_t stride, T * dst, std::size_t n ) noexcept
+    {
+        endian_gather_n_scalar<T, N, Order>( p, stride, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( unsigned char const * p, std::size_t stride, T * dst, std::size_t n ) noexcept
+    {
+        endian_gather_n_avx2<T, N, Order>( p, stride, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( unsigned char const * p, std::size_t stride, T * dst, std::size_t n ) noexcept
+    {
+        endian_gather_n_avx512<T, N, Order>( p, stride, dst, n );
+    }
+
+#endif
+};
+
+template<class T, std::size_t N, order Order> struct endian_scatter_n_simd
+{
+    static void scalar( T const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+    {
+        endian_scatter_n_scalar<T, N, Order>( src, p, stride, n );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( T const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+    {
+        endian_scatter_n_scalar<T, N, Order>( src, p, stride, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( T const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+    {
+        endian_scatter_n_scalar<T, N, Order>( src, p, stride, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( T const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+    {
+        endian_scatter_n_avx512<T, N, Order>( src, p, stride, n );
+    }
+
+#endif
+};
+
+// the vector kernels handle 4 and 8 byte integers, and float and double
+// when N == sizeof(T)
+
+template<class T, std::size_t N> struct endian_gather_n_vectorizable: integral_constant<bool,
+    order::native == order::little &&
+    ( sizeof(T) == 4 || sizeof(T) == 8 ) &&
+    ( is_integral<T>::value || ( N == sizeof(T) && ( is_same<T, float>::value || is_same<T, double>::value ) ) )>
+{
+};
+
+template<class T, std::size_t N, order Order>
+inline void endian_gather_n_impl( unsigned char const * p, std::size_t stride, T * dst, std::size_t n, integral_constant<bool, false> ) noexcept
+{
+    endian_gather_n_scalar<T, N, Order>( p, stride, dst, n );
+}
+
+template<class T, std::size_t N, order Order>
+inline void endian_gather_n_impl( unsigned char const * p, std::size_t stride, T * dst, std::size_t n, integral_constant<bool, true> ) noexcept
+{
+#if defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    if( endian_gather_n_stride_ok( stride ) )
+    {
+        simd_invoke< endian_gather_n_simd<T, N, Order> >( p, stride, dst, n );
+        return;
+    }
+
+#endif
+
+    endian_gather_n_scalar<T, N, Order>( p, stride, dst, n );
+}
+
+template<class T, std::size_t N, order Order>
+inline void endian_scatter_n_impl( T const * src, unsigned char * p, std::size_t stride, std::size_t n, integral_constant<bool, false> ) noexcept
+{
+    endian_scatter_n_scalar<T, N, Order>( src, p, stride, n );
+}
+
+template<class T, std::size_t N, order Order>
+inline void endian_scatter_n_impl( T const * src, unsigned char * p, std::size_t stride, std::size_t n, integral_constant<bool, true> ) noexcept
+{
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    if( endian_gather_n_stride_ok( stride ) )
+    {
+        simd_invoke< endian_scatter_n_simd<T, N, Order> >( src, p, stride, n );
+        return;
+    }
+
+#endif
+
+    endian_scatter_n_scalar<T, N, Order>( src, p, stride, n );
+}
+
+} // namespace detail
+
+// Requires:
+//
+//    the requirements of endian_load<T, N, Order>
+//    base + offset + i * stride points to N readable bytes for i in [0, n)
+//
+// Effects:
+//
+//    dst[ i ] = endian_load<T, N, Order>( base + offset + i * stride ) for i in [0, n)
+
+template<class T, std::size_t N, enum order Order>
+inline void endian_gather_n( unsigned char const * base, std::size_t stride, std::size_t offset, T * dst, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 );
+    BOOST_ENDIAN_STATIC_ASSERT( N >= 1 && N <= sizeof(T) );
+
+    detail::endian_gather_n_impl<T, N, Order>( base + offset, stride, dst, n, detail::endian_gather_n_vectorizable<T, N>() );
+}
+
+// Requires:
+//
+//    the requirements of endian_store<T, N, Order>
+//    base + offset + i * stride points to N writable bytes for i in [0, n),
+//    and these ranges do not overlap
+//
+// Effects:
+//
+//    endian_store<T, N, Order>( base + offset + i * stride, src[ i ] ) for i in [0, n)
+
+template<class T, std::size_t N, enum order Order>
+inline void endian_scatter_n( T const * src, unsigned char * base, std::size_t stride, std::size_t offset, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 );
+    BOOST_ENDIAN_STATIC_ASSERT( N >= 1 && N <= sizeof(T) );
+
+    detail::endian_scatter_n_impl<T, N, Order>( src, base + offset, stride, n, detail::endian_gather_n_vectorizable<T, N>() );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_GATHER_N_HPP_INCLUDED
@@ -0,0 +1,358 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_LOAD_N_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_LOAD_N_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_reverse_n.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// Bulk expanding loads: n values of N bytes each, packed back to back in src,
+// widened to S = sizeof(T) bytes.
+//
+// The vector kernels shuffle the N bytes of each value into the most significant
+// bytes of its S-byte lane, then shift right by 8 * (S - N) bits, arithmetically
+// for signed T, so that zero or sign extension is a single instruction.
+
+template<class T, std::size_t N, order Order>
+inline void endian_load_n_scalar( unsigned char const * src, T * dst, std::size_t n ) noexcept
+{
+    for( std::size_t i = 0; i < n; ++i, src += N )
+    {
+        dst[ i ] = boost::endian::endian_load<T, N, Order>( src );
+    }
+}
+
+// shuffle control for one 16-byte lane, holding 16 / S values
+
+template<std::size_t S, std::size_t N, order Order>
+inline void endian_load_n_mask( unsigned char (&m)[ 16 ] ) noexcept
+{
+    for( std::size_t b = 0; b < 16; ++b )
+    {
+        std::size_t const v = b / S;
+        std::size_t const t = b % S;
+
+        if( t < S - N )
+        {
+            m[ b ] = 0x80;
+        }
+        else
+        {
+            std::size_t const q = t - ( S - N ); // significance of the byte within the value
+
+            m[ b ] = static_cast<unsigned char>( v * N + ( Order == order::little? q: N - 1 - q ) );
+        }
+    }
+}
+
+template<std::size_t S, std::size_t N, bool Signed> struct endian_load_n_extend;
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3) || defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+
+template<std::size_t N, bool Signed> struct endian_load_n_extend<2, N, Signed>
+{
+    BOOST_ENDIAN_TARGET_SSSE3 static __m128i sse( __m128i v ) noexcept
+    {
+        return Signed? _mm_srai_epi16( v, 8 * ( 2 - N ) ): _mm_srli_epi16( v, 8 * ( 2 - N ) );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX2 static __m256i avx2( __m256i v ) noexcept
+    {
+        return Signed? _mm256_srai_epi16( v, 8 * ( 2 - N ) ): _mm256_srli_epi16( v, 8 * ( 2 - N ) );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX512 static __m512i avx512( __m512i v ) noexcept
+    {
+        // the zero-masking forms avoid spurious -Wmaybe-uninitialized warnings from GCC
+
+        return Signed? _mm512_maskz_srai_epi16( 0xFFFFFFFF, v, 8 * ( 2 - N ) ): _mm512_maskz_srli_epi16( 0xFFFFFFFF, v, 8 * ( 2 - N ) );
+    }
+};
+
+template<std::size_t N, bool Signed> struct endian_load_n_extend<4, N, Signed>
+{
+    BOOST_ENDIAN_TARGET_SSSE3 static __m128i sse( __m128i v ) noexcept
+    {
+        return Signed? _mm_srai_epi32( v, 8 * ( 4 - N ) ): _mm_srli_epi32( v, 8 * ( 4 - N ) );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX2 static __m256i avx2( __m256i v ) noexcept
+    {
+        return Signed? _mm256_srai_epi32( v, 8 * ( 4 - N ) ): _mm256_srli_epi32( v, 8 * ( 4 - N ) );
+    }
+
+    BOOST_ENDIAN_TARGET_AVX512 static __m512i avx512( __m512i v ) noexcept
+    {
+        return Signed? _mm512_maskz_srai_epi32( 0xFFFF, v, 8 * ( 4 - N ) ): _mm512_maskz_srli_epi32( 0xFFFF, v, 8 * ( 4 - N ) );
+    }
+};
+
+// There is no 64-bit arithmetic shift before AVX-512; sign extend the logically
+// shifted value with ( x ^ m ) - m, m being its sign bit
+
+template<std::size_t N, bool Signed> struct endian_load_n_extend<8, N, Signed>
+{
+    BOOST_ENDIAN_TARGET_SSSE3 static __m128i sse( __m128i v ) noexcept
+    {
+        v = _mm_srli_epi64( v, 8 * ( 8 - N ) );
+
+        if( Signed )
+        {
+            __m128i const m = _mm_set1_epi64x( static_cast<long long>( 1ull << ( 8 * N - 1 ) ) );
+            v = _mm_sub_epi64( _mm_xor_si128( v, m ), m );
+        }
+
+        return v;
+    }
+
+    BOOST_ENDIAN_TARGET_AVX2 static __m256i avx2( __m256i v ) noexcept
+    {
+        v = _mm256_srli_epi64( v, 8 * ( 8 - N ) );
+
+        if( Signed )
+        {
+            __m256i const m = _mm256_set1_epi64x( static_cast<long long>( 1ull << ( 8 * N - 1 ) ) );
+            v = _mm256_sub_epi64( _mm256_xor_si256( v, m ), m );
+        }
+
+        return v;
+    }
+
+    BOOST_ENDIAN_TARGET_AVX512 static __m512i avx512( __m512i v ) noexcept
+    {
+        return Signed? _mm512_maskz_srai_epi64( 0xFF, v, 8 * ( 8 - N ) ): _mm512_maskz_srli_epi64( 0xFF, v, 8 * ( 8 - N ) );
+    }
+};
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_SSSE3 inline void endian_load_n_ssse3( unsigned char const * src, T * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+    std::size_t const V = 16 / S; // values per vector
+    std::size_t const G = V * N;  // source bytes per vector
+
+    typedef endian_load_n_extend<S, N, is_signed<T>::value> extend;
+
+    unsigned char m[ 16 ];
+    endian_load_n_mask<S, N, Order>( m );
+
+    __m128i const mask = _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) );
+
+    std::size_t i = 0;
+
+    // each step reads 16 bytes, of which it consumes G
+
+    for( ; ( n - i ) * N >= 16; i += V, src += G )
+    {
+        __m128i v = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<__m128i const*>( src ) ), mask );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), extend::sse( v ) );
+    }
+
+    endian_load_n_scalar<T, N, Order>( src, dst + i, n - i );
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_AVX2 inline void endian_load_n_avx2( unsigned char const * src, T * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+    std::size_t const V = 16 / S;
+    std::size_t const G = V * N;
+
+    typedef endian_load_n_extend<S, N, is_signed<T>::value> extend;
+
+    unsigned char m[ 16 ];
+    endian_load_n_mask<S, N, Order>( m );
+
+    __m256i const mask = _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) ) );
+
+    std::size_t i = 0;
+
+    // each step reads 16 bytes at src and at src + G, and consumes 2 * G
+
+    for( ; ( n - i ) * N >= G + 16; i += 2 * V, src += 2 * G )
+    {
+        __m128i lo = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src ) );
+        __m128i hi = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + G ) );
+
+        __m256i v = _mm256_shuffle_epi8( _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 ), mask );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst + i ), extend::avx2( v ) );
+    }
+
+    endian_load_n_scalar<T, N, Order>( src, dst + i, n - i );
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_AVX512 inline void endian_load_n_avx512( unsigned char const * src, T * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+    std::size_t const V = 16 / S;
+    std::size_t const G = V * N;
+
+    typedef endian_load_n_extend<S, N, is_signed<T>::value> extend;
+
+    unsigned char m[ 16 ];
+    endian_load_n_mask<S, N, Order>( m );
+
+    __m512i const mask = _mm512_maskz_broadcast_i32x4( 0xFFFF, _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) ) );
+
+    // moves source bytes [ k * G, k * G + 16 ) to lane k; G is always even
+
+    unsigned short idx[ 32 ];
+
+    for( std::size_t k = 0; k < 4; ++k )
+    {
+        for( std::size_t j = 0; j < 8; ++j )
+        {
+            idx[ k * 8 + j ] = static_cast<unsigned short>( k * G / 2 + j );
+        }
+    }
+
+    __m512i const spread = _mm512_loadu_si512( idx );
+
+    // a masked load reads exactly the 4 * G bytes consumed
+
+    __mmask64 const lm = static_cast<__mmask64>( ( 1ull << ( 4 * G ) ) - 1 );
+
+    std::size_t i = 0;
+
+    for( ; i + 4 * V <= n; i += 4 * V, src += 4 * G )
+    {
+        __m512i v = _mm512_permutexvar_epi16( spread, _mm512_maskz_loadu_epi8( lm, src ) );
+        _mm512_storeu_si512( dst + i, extend::avx512( _mm512_shuffle_epi8( v, mask ) ) );
+    }
+
+    endian_load_n_scalar<T, N, Order>( src, dst + i, n - i );
+}
+
+#endif
+
+template<class T, std::size_t N, order Order> struct endian_load_n_simd
+{
+    static void scalar( unsigned char const * src, T * dst, std::size_t n ) noexcept
+    {
+        endian_load_n_scalar<T, N, Order>( src, dst, n );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( unsigned char const * src, T * dst, std::size_t n ) noexcept
+    {
+        endian_load_n_ssse3<T, N, Order>( src, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( unsigned char const * src, T * dst, std::size_t n ) noexcept
+    {
+        endian_load_n_avx2<T, N, Order>( src, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( unsigned char const * src, T * dst, std::size_t n ) noexcept
+    {
+        endian_load_n_avx512<T, N, Order>( src, dst, n );
+    }
+
+#endif
+};
+
+// same size: a plain copy or a bulk reversal
+
+template<class T, std::size_t N, order Order, bool Expand = ( N < sizeof(T) )> struct endian_load_n_impl
+{
+    static void apply( unsigned char const * src, T * dst, std::size_t n ) noexcept
+    {
+        unsigned char * q = reinterpret_cast<unsigned char*>( dst );
+
+        if( Order == order::native )
+        {
+            endian_reverse_n_copy<1>( src, q, n * N, store_hint::normal );
+        }
+        else
+        {
+            endian_reverse_n_copy<N>( src, q, n, store_hint::normal );
+        }
+    }
+};
+
+// expanding load
+
+template<class T, std::size_t N, order Order> struct endian_load_n_impl<T, N, Order, true>
+{
+    static void apply( unsigned char const * src, T * dst, std::size_t n ) noexcept
+    {
+#if defined(BOOST_ENDIAN_SIMD_SSSE3) || defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+
+        if( order::native == order::little && is_integral<T>::value )
+        {
+            simd_invoke< endian_load_n_simd<T, N, Order> >( src, dst, n );
+            return;
+        }
+
+#endif
+
+        endian_load_n_scalar<T, N, Order>( src, dst, n );
+    }
+};
+
+} // namespace detail
+
+// Requires:
+//
+//    sizeof(T) must be 1, 2, 4, or 8
+//    1 <= N <= sizeof(T)
+//    T is TriviallyCopyable
+//    if N < sizeof(T), T is integral or enum
+//    src points to n * N readable bytes, dst to n elements
+//
+// Effects:
+//
+//    dst[ i ] = endian_load<T, N, Order>( src + i * N ) for i in [0, n)
+
+template<class T, std::size_t N, enum order Order>
+inline void endian_load_n( unsigned char const * src, T * dst, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 );
+    BOOST_ENDIAN_STATIC_ASSERT( N >= 1 && N <= sizeof(T) );
+
+    detail::endian_load_n_impl<T, N, Order>::apply( src, dst, n );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_LOAD_N_HPP_INCLUDED
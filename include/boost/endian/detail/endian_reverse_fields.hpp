@@ -0,0 +1,225 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_REVERSE_FIELDS_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_REVERSE_FIELDS_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/endian_describe.hpp>
+#include <boost/endian/detail/endian_reverse.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// Records whose layout is only known at run time, such as one given to a
+// tool on its command line: `size` bytes each, with the fields listed by
+// offset and size reversed and the other bytes left alone. Arrays of them
+// are reversed with the permutation kernels of the described types.
+
+struct endian_record_layout
+{
+    std::size_t size;
+
+    // offset and size of each field to reverse, in order of offset
+    std::vector< std::pair<std::size_t, std::size_t> > fields;
+
+    endian_permutation perm;
+};
+
+// Returns: false when size is 0 or the fields overlap or do not fit
+
+inline bool endian_record_layout_make( endian_record_layout & r, std::size_t size, std::vector< std::pair<std::size_t, std::size_t> > fields )
+{
+    if( size == 0 )
+    {
+        return false;
+    }
+
+    std::sort( fields.begin(), fields.end() );
+
+    std::size_t end = 0;
+
+    for( std::size_t i = 0; i < fields.size(); ++i )
+    {
+        if( fields[ i ].first < end || fields[ i ].second > size || fields[ i ].first > size - fields[ i ].second )
+        {
+            return false;
+        }
+
+        end = fields[ i ].first + fields[ i ].second;
+    }
+
+    // fields of one byte do not change
+
+    fields.erase( std::remove_if( fields.begin(), fields.end(), []( std::pair<std::size_t, std::size_t> const & f ) { return f.second < 2; } ), fields.end() );
+
+    r.size = size;
+    r.fields.swap( fields );
+
+    r.perm = endian_permutation();
+    r.perm.valid = false;
+    r.perm.period = size;
+
+    endian_permutation_map m;
+    endian_permutation_map_init( m, size );
+
+    for( std::size_t i = 0; i < r.fields.size(); ++i )
+    {
+        endian_permutation_map_add( m, r.fields[ i ].first, r.fields[ i ].second );
+    }
+
+    endian_permutation_compile( r.perm, m );
+
+    return true;
+}
+
+inline void endian_reverse_field( unsigned char * p, std::size_t n ) noexcept
+{
+    switch( n )
+    {
+    case 2:
+
+        {
+            uint16_t v;
+            std::memcpy( &v, p, 2 );
+            v = endian_reverse( v );
+            std::memcpy( p, &v, 2 );
+        }
+
+        break;
+
+    case 4:
+
+        {
+            uint32_t v;
+            std::memcpy( &v, p, 4 );
+            v = endian_reverse( v );
+            std::memcpy( p, &v, 4 );
+        }
+
+        break;
+
+    case 8:
+
+        {
+            uint64_t v;
+            std::memcpy( &v, p, 8 );
+            v = endian_reverse( v );
+            std::memcpy( p, &v, 8 );
+        }
+
+        break;
+
+    default:
+
+        std::reverse( p, p + n );
+    }
+}
+
+struct endian_reverse_records_simd
+{
+    static void scalar( unsigned char * p, std::size_t n, endian_record_layout const * r ) noexcept
+    {
+        std::size_t const F = r->fields.size();
+
+        for( std::size_t i = 0; i < n; ++i, p += r->size )
+        {
+            for( std::size_t j = 0; j < F; ++j )
+            {
+                endian_reverse_field( p + r->fields[ j ].first, r->fields[ j ].second );
+            }
+        }
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( unsigned char * p, std::size_t n, endian_record_layout const * r ) noexcept
+    {
+        if( r->perm.lists[ 0 ].width == 0 )
+        {
+            scalar( p, n, r );
+            return;
+        }
+
+        std::size_t const i = endian_permute_ssse3( p, n * r->size, r->perm ) / r->size;
+        scalar( p + i * r->size, n - i, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( unsigned char * p, std::size_t n, endian_record_layout const * r ) noexcept
+    {
+        if( r->perm.lists[ 1 ].width == 0 )
+        {
+            ssse3( p, n, r );
+            return;
+        }
+
+        std::size_t const i = endian_permute_avx2( p, n * r->size, r->perm ) / r->size;
+        ssse3( p + i * r->size, n - i, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( unsigned char * p, std::size_t n, endian_record_layout const * r ) noexcept
+    {
+        if( r->perm.lists[ 2 ].width == 0 )
+        {
+            avx2( p, n, r );
+            return;
+        }
+
+        std::size_t const i = endian_permute_avx512( p, n * r->size, r->perm ) / r->size;
+        ssse3( p + i * r->size, n - i, r );
+    }
+
+#endif
+};
+
+// Effects: reverses the fields of the n records at p
+
+inline void endian_reverse_records( unsigned char * p, std::size_t n, endian_record_layout const & r ) noexcept
+{
+    if( n == 0 || r.fields.empty() )
+    {
+        return;
+    }
+
+    if( !r.perm.valid || n * r.size < r.perm.period )
+    {
+        endian_reverse_records_simd::scalar( p, n, &r );
+        return;
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3) || defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    simd_invoke< endian_reverse_records_simd >( p, n, &r );
+
+#else
+
+    endian_reverse_records_simd::scalar( p, n, &r );
+
+#endif
+}
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_REVERSE_FIELDS_HPP_INCLUDED
@@ -0,0 +1,548 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_REVERSE_N_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_REVERSE_N_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/endian_reverse.hpp>
+#include <boost/endian/detail/endian_describe.hpp>
+#include <boost/endian/detail/integral_by_size.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost
+{
+namespace endian
+{
+
+// Cache behavior of the destination writes of out-of-place bulk functions.
+// nontemporal uses streaming stores where available; use it when the output
+// is larger than the last level cache and will not be read back soon.
+
+enum class store_hint
+{
+    normal,
+    nontemporal
+};
+
+namespace detail
+{
+
+// Bulk kernels operate on n elements of N bytes each, reading from src and
+// writing to dst. src and dst either do not overlap or are equal.
+
+// scalar kernels
+
+template<std::size_t N> struct endian_reverse_n_scalar
+{
+    static void apply( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        for( std::size_t i = 0; i < n; ++i, src += N, dst += N )
+        {
+            unsigned char tmp[ N ];
+
+            for( std::size_t j = 0; j < N; ++j )
+            {
+                tmp[ j ] = src[ N - 1 - j ];
+            }
+
+            std::memcpy( dst, tmp, N );
+        }
+    }
+};
+
+template<> struct endian_reverse_n_scalar<1>
+{
+    static void apply( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        if( src != dst && n != 0 )
+        {
+            std::memcpy( dst, src, n );
+        }
+    }
+};
+
+template<std::size_t N> struct endian_reverse_n_scalar_integral
+{
+    static void apply( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        typedef typename integral_by_size<N>::type uintN_t;
+
+        for( std::size_t i = 0; i < n; ++i, src += N, dst += N )
+        {
+            uintN_t x;
+            std::memcpy( &x, src, N );
+
+            x = endian_reverse_impl( x );
+
+            std::memcpy( dst, &x, N );
+        }
+    }
+};
+
+template<> struct endian_reverse_n_scalar<2>: endian_reverse_n_scalar_integral<2> {};
+template<> struct endian_reverse_n_scalar<4>: endian_reverse_n_scalar_integral<4> {};
+template<> struct endian_reverse_n_scalar<8>: endian_reverse_n_scalar_integral<8> {};
+
+// shuffle control reversing each N-byte element of a 16-byte lane
+
+template<std::size_t N> struct endian_reverse_n_mask
+{
+};
+
+template<> struct endian_reverse_n_mask<2>
+{
+    static unsigned char const * get() noexcept
+    {
+        static unsigned char const mask[ 16 ] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+        return mask;
+    }
+};
+
+template<> struct endian_reverse_n_mask<4>
+{
+    static unsigned char const * get() noexcept
+    {
+        static unsigned char const mask[ 16 ] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+        return mask;
+    }
+};
+
+template<> struct endian_reverse_n_mask<8>
+{
+    static unsigned char const * get() noexcept
+    {
+        static unsigned char const mask[ 16 ] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+        return mask;
+    }
+};
+
+// With NT (non-temporal) set, the vector stores bypass the cache. Streaming
+// stores need an aligned destination, so a scalar head brings dst to the
+// vector alignment first; when the element size does not allow that, the
+// kernel falls back to regular stores.
+
+template<std::size_t N, std::size_t A>
+inline bool endian_reverse_n_align_head( unsigned char const * & src, unsigned char * & dst, std::size_t & n ) noexcept
+{
+    std::size_t h = ( A - reinterpret_cast<std::size_t>( dst ) % A ) % A;
+
+    if( h % N != 0 )
+    {
+        return false;
+    }
+
+    h = h / N < n? h / N: n;
+
+    endian_reverse_n_scalar<N>::apply( src, dst, h );
+
+    src += h * N;
+    dst += h * N;
+    n -= h;
+
+    return true;
+}
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+template<bool NT> BOOST_ENDIAN_TARGET_SSSE3 inline void endian_reverse_n_store_128( unsigned char * p, __m128i v ) noexcept
+{
+    if( NT )
+    {
+        _mm_stream_si128( reinterpret_cast<__m128i*>( p ), v );
+    }
+    else
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( p ), v );
+    }
+}
+
+template<std::size_t N, bool NT>
+BOOST_ENDIAN_TARGET_SSSE3 inline void endian_reverse_n_ssse3( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    if( NT && !endian_reverse_n_align_head<N, 16>( src, dst, n ) )
+    {
+        endian_reverse_n_ssse3<N, false>( src, dst, n );
+        return;
+    }
+
+    __m128i const mask = _mm_loadu_si128( reinterpret_cast<__m128i const*>( endian_reverse_n_mask<N>::get() ) );
+
+    std::size_t const k = 16 / N;
+    std::size_t i = 0;
+
+    for( ; i + 4 * k <= n; i += 4 * k, src += 64, dst += 64 )
+    {
+        __m128i v0 = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src +  0 ) );
+        __m128i v1 = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + 16 ) );
+        __m128i v2 = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + 32 ) );
+        __m128i v3 = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + 48 ) );
+
+        endian_reverse_n_store_128<NT>( dst +  0, _mm_shuffle_epi8( v0, mask ) );
+        endian_reverse_n_store_128<NT>( dst + 16, _mm_shuffle_epi8( v1, mask ) );
+        endian_reverse_n_store_128<NT>( dst + 32, _mm_shuffle_epi8( v2, mask ) );
+        endian_reverse_n_store_128<NT>( dst + 48, _mm_shuffle_epi8( v3, mask ) );
+    }
+
+    for( ; i + k <= n; i += k, src += 16, dst += 16 )
+    {
+        __m128i v = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src ) );
+        endian_reverse_n_store_128<NT>( dst, _mm_shuffle_epi8( v, mask ) );
+    }
+
+    endian_reverse_n_scalar<N>::apply( src, dst, n - i );
+
+    if( NT )
+    {
+        _mm_sfence();
+    }
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+template<bool NT> BOOST_ENDIAN_TARGET_AVX2 inline void endian_reverse_n_store_256( unsigned char * p, __m256i v ) noexcept
+{
+    if( NT )
+    {
+        _mm256_stream_si256( reinterpret_cast<__m256i*>( p ), v );
+    }
+    else
+    {
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( p ), v );
+    }
+}
+
+template<std::size_t N, bool NT>
+BOOST_ENDIAN_TARGET_AVX2 inline void endian_reverse_n_avx2( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    if( NT && !endian_reverse_n_align_head<N, 32>( src, dst, n ) )
+    {
+        endian_reverse_n_avx2<N, false>( src, dst, n );
+        return;
+    }
+
+    __m256i const mask = _mm256_broadcastsi128_si256( _mm_loadu_si128( reinterpret_cast<__m128i const*>( endian_reverse_n_mask<N>::get() ) ) );
+
+    std::size_t const k = 32 / N;
+    std::size_t i = 0;
+
+    for( ; i + 4 * k <= n; i += 4 * k, src += 128, dst += 128 )
+    {
+        __m256i v0 = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src +  0 ) );
+        __m256i v1 = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src + 32 ) );
+        __m256i v2 = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src + 64 ) );
+        __m256i v3 = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src + 96 ) );
+
+        endian_reverse_n_store_256<NT>( dst +  0, _mm256_shuffle_epi8( v0, mask ) );
+        endian_reverse_n_store_256<NT>( dst + 32, _mm256_shuffle_epi8( v1, mask ) );
+        endian_reverse_n_store_256<NT>( dst + 64, _mm256_shuffle_epi8( v2, mask ) );
+        endian_reverse_n_store_256<NT>( dst + 96, _mm256_shuffle_epi8( v3, mask ) );
+    }
+
+    for( ; i + k <= n; i += k, src += 32, dst += 32 )
+    {
+        __m256i v = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src ) );
+        endian_reverse_n_store_256<NT>( dst, _mm256_shuffle_epi8( v, mask ) );
+    }
+
+    endian_reverse_n_scalar<N>::apply( src, dst, n - i );
+
+    if( NT )
+    {
+        _mm_sfence();
+    }
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+template<bool NT> BOOST_ENDIAN_TARGET_AVX512 inline void endian_reverse_n_store_512( unsigned char * p, __m512i v ) noexcept
+{
+    if( NT )
+    {
+        _mm512_stream_si512( reinterpret_cast<__m512i*>( p ), v );
+    }
+    else
+    {
+        _mm512_storeu_si512( p, v );
+    }
+}
+
+template<std::size_t N, bool NT>
+BOOST_ENDIAN_TARGET_AVX512 inline void endian_reverse_n_avx512( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    if( NT && !endian_reverse_n_align_head<N, 64>( src, dst, n ) )
+    {
+        endian_reverse_n_avx512<N, false>( src, dst, n );
+        return;
+    }
+
+    __m512i const mask = _mm512_maskz_broadcast_i32x4( 0xFFFF, _mm_loadu_si128( reinterpret_cast<__m128i const*>( endian_reverse_n_mask<N>::get() ) ) );
+
+    std::size_t const k = 64 / N;
+    std::size_t i = 0;
+
+    for( ; i + 4 * k <= n; i += 4 * k, src += 256, dst += 256 )
+    {
+        __m512i v0 = _mm512_loadu_si512( src +   0 );
+        __m512i v1 = _mm512_loadu_si512( src +  64 );
+        __m512i v2 = _mm512_loadu_si512( src + 128 );
+        __m512i v3 = _mm512_loadu_si512( src + 192 );
+
+        endian_reverse_n_store_512<NT>( dst +   0, _mm512_shuffle_epi8( v0, mask ) );
+        endian_reverse_n_store_512<NT>( dst +  64, _mm512_shuffle_epi8( v1, mask ) );
+        endian_reverse_n_store_512<NT>( dst + 128, _mm512_shuffle_epi8( v2, mask ) );
+        endian_reverse_n_store_512<NT>( dst + 192, _mm512_shuffle_epi8( v3, mask ) );
+    }
+
+    for( ; i + k <= n; i += k, src += 64, dst += 64 )
+    {
+        __m512i v = _mm512_loadu_si512( src );
+        endian_reverse_n_store_512<NT>( dst, _mm512_shuffle_epi8( v, mask ) );
+    }
+
+    // the tail (fewer than 64 bytes) goes through a single masked operation
+
+    if( i < n )
+    {
+        __mmask64 m = static_cast<__mmask64>( ( static_cast<unsigned long long>( 1 ) << ( ( n - i ) * N ) ) - 1 );
+
+        __m512i v = _mm512_maskz_loadu_epi8( m, src );
+        _mm512_mask_storeu_epi8( dst, m, _mm512_shuffle_epi8( v, mask ) );
+    }
+
+    if( NT )
+    {
+        _mm_sfence();
+    }
+}
+
+#endif
+
+// kernel selection
+
+template<std::size_t N> struct endian_reverse_n_kernel: endian_reverse_n_scalar<N>
+{
+    static void apply_nt( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_reverse_n_scalar<N>::apply( src, dst, n );
+    }
+};
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3) || defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+
+template<std::size_t N, bool NT> struct endian_reverse_n_simd
+{
+    static void scalar( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_reverse_n_scalar<N>::apply( src, dst, n );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_reverse_n_ssse3<N, NT>( src, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_reverse_n_avx2<N, NT>( src, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_reverse_n_avx512<N, NT>( src, dst, n );
+    }
+
+#endif
+};
+
+template<std::size_t N> struct endian_reverse_n_kernel_simd
+{
+    static void apply( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        simd_invoke< endian_reverse_n_simd<N, false> >( src, dst, n );
+    }
+
+    static void apply_nt( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        simd_invoke< endian_reverse_n_simd<N, true> >( src, dst, n );
+    }
+};
+
+template<> struct endian_reverse_n_kernel<2>: endian_reverse_n_kernel_simd<2> {};
+template<> struct endian_reverse_n_kernel<4>: endian_reverse_n_kernel_simd<4> {};
+template<> struct endian_reverse_n_kernel<8>: endian_reverse_n_kernel_simd<8> {};
+
+#endif
+
+template<std::size_t N>
+inline void endian_reverse_n_copy( unsigned char const * src, unsigned char * dst, std::size_t n, store_hint hint ) noexcept
+{
+    if( hint == store_hint::nontemporal )
+    {
+        endian_reverse_n_kernel<N>::apply_nt( src, dst, n );
+    }
+    else
+    {
+        endian_reverse_n_kernel<N>::apply( src, dst, n );
+    }
+}
+
+} // namespace detail
+
+// Requires:
+//   T is integral, enumeration, float or double
+//   p points to an array of at least n elements
+
+template<class T> inline
+    typename detail::enable_if< !detail::is_class<T>::value >::type
+    endian_reverse_inplace_n( T * p, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( detail::is_endian_reversible_inplace<T>::value );
+
+    unsigned char * q = reinterpret_cast<unsigned char*>( p );
+    detail::endian_reverse_n_kernel<sizeof(T)>::apply( q, q, n );
+}
+
+namespace detail
+{
+
+// trivially copyable types described with BOOST_ENDIAN_DESCRIBE_STRUCT or
+// BOOST_ENDIAN_DESCRIBE_CLASS are reversed with a precomputed permutation
+
+template<class T> struct is_endian_permutable: integral_constant<bool,
+    is_endian_described<T>::value && is_trivially_copyable<T>::value>
+{
+};
+
+template<class T>
+inline void endian_reverse_inplace_n_udt( T * p, std::size_t n, true_type ) noexcept
+{
+    detail::endian_reverse_described_n( p, n );
+}
+
+template<class T>
+inline void endian_reverse_inplace_n_udt( T * p, std::size_t n, false_type ) noexcept
+{
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        endian_reverse_inplace( p[i] );
+    }
+}
+
+template<class T>
+inline void endian_reverse_n_udt( T const * src, T * dst, std::size_t n, true_type ) noexcept
+{
+    if( src != dst && n != 0 )
+    {
+        std::memcpy( dst, src, n * sizeof(T) );
+    }
+
+    detail::endian_reverse_described_n( dst, n );
+}
+
+template<class T>
+inline void endian_reverse_n_udt( T const * src, T * dst, std::size_t n, false_type ) noexcept
+{
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        dst[i] = src[i];
+        endian_reverse_inplace( dst[i] );
+    }
+}
+
+} // namespace detail
+
+// Default implementation for user-defined types
+
+template<class T> inline
+    typename detail::enable_if< detail::is_class<T>::value >::type
+    endian_reverse_inplace_n( T * p, std::size_t n ) noexcept
+{
+    detail::endian_reverse_inplace_n_udt( p, n, detail::is_endian_permutable<T>() );
+}
+
+// Requires:
+//   T is integral, enumeration, float or double
+//   [src, src+n) and [dst, dst+n) do not overlap, or src == dst
+
+template<class T> inline
+    typename detail::enable_if< !detail::is_class<T>::value >::type
+    endian_reverse_n( T const * src, T * dst, std::size_t n, store_hint hint = store_hint::normal ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( detail::is_endian_reversible_inplace<T>::value );
+
+    detail::endian_reverse_n_copy<sizeof(T)>( reinterpret_cast<unsigned char const*>( src ), reinterpret_cast<unsigned char*>( dst ), n, hint );
+}
+
+// Default implementation for user-defined types
+
+template<class T> inline
+    typename detail::enable_if< detail::is_class<T>::value >::type
+    endian_reverse_n( T const * src, T * dst, std::size_t n, store_hint = store_hint::normal ) noexcept
+{
+    detail::endian_reverse_n_udt( src, dst, n, detail::is_endian_permutable<T>() );
+}
+
+// endian_reverse_inplace for arrays
+
+template<class T, std::size_t N>
+inline void endian_reverse_inplace( T (&x)[ N ] ) noexcept;
+
+namespace detail
+{
+
+template<class T, std::size_t N>
+inline void endian_reverse_inplace_array( T (&x)[ N ], true_type ) noexcept
+{
+    boost::endian::endian_reverse_inplace_n( x, N );
+}
+
+template<class T, std::size_t N>
+inline void endian_reverse_inplace_array( T (&x)[ N ], false_type ) noexcept
+{
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        endian_reverse_inplace( x[i] );
+    }
+}
+
+} // namespace detail
+
+template<class T, std::size_t N>
+inline void endian_reverse_inplace( T (&x)[ N ] ) noexcept
+{
+    detail::endian_reverse_inplace_array( x, detail::integral_constant<bool, detail::is_endian_reversible_inplace<T>::value>() );
+}
+
+// range form
+
+template<class T>
+inline void endian_reverse_inplace( T * first, T * last ) noexcept
+{
+    boost::endian::endian_reverse_inplace_n( first, static_cast<std::size_t>( last - first ) );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_REVERSE_N_HPP_INCLUDED
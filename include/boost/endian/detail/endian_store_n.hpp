@@ -0,0 +1,312 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_STORE_N_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_STORE_N_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/endian_store.hpp>
+#include <boost/endian/detail/endian_reverse_n.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// Bulk truncating stores: n values of S = sizeof(T) bytes, each written as its
+// N least significant bytes, packed back to back in dst.
+//
+// The vector kernels compact the N low bytes of every value in a 16-byte lane,
+// in the requested order, into the first G = (16 / S) * N bytes of the lane
+// with one byte shuffle.
+
+template<class T, std::size_t N, order Order>
+inline void endian_store_n_scalar( T const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    for( std::size_t i = 0; i < n; ++i, dst += N )
+    {
+        boost::endian::endian_store<T, N, Order>( dst, src[ i ] );
+    }
+}
+
+// shuffle control for one 16-byte lane, holding 16 / S values
+
+template<std::size_t S, std::size_t N, order Order>
+inline void endian_store_n_mask( unsigned char (&m)[ 16 ] ) noexcept
+{
+    std::size_t const G = 16 / S * N;
+
+    for( std::size_t b = 0; b < 16; ++b )
+    {
+        if( b >= G )
+        {
+            m[ b ] = 0x80;
+        }
+        else
+        {
+            std::size_t const v = b / N;
+            std::size_t const t = b % N;
+            std::size_t const q = Order == order::little? t: N - 1 - t; // significance of the byte within the value
+
+            m[ b ] = static_cast<unsigned char>( v * S + q );
+        }
+    }
+}
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+// Converts the last n < 16 / S values through a zero-padded lane, so that the
+// tail does not fall back to the per-value byte loop
+
+template<class T, std::size_t N>
+BOOST_ENDIAN_TARGET_SSSE3 inline void endian_store_n_tail_ssse3( T const * src, unsigned char * dst, std::size_t n, __m128i mask ) noexcept
+{
+    if( n == 0 )
+    {
+        return;
+    }
+
+    unsigned char tmp[ 16 ] = {};
+    std::memcpy( tmp, src, n * sizeof(T) );
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( tmp ), _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<__m128i const*>( tmp ) ), mask ) );
+    std::memcpy( dst, tmp, n * N );
+}
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_SSSE3 inline void endian_store_n_ssse3( T const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+    std::size_t const V = 16 / S; // values per vector
+    std::size_t const G = V * N;  // destination bytes per vector
+
+    unsigned char m[ 16 ];
+    endian_store_n_mask<S, N, Order>( m );
+
+    __m128i const mask = _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) );
+
+    std::size_t i = 0;
+
+    // each step writes 16 bytes, of which the next step overwrites all but G
+
+    for( ; ( n - i ) * N >= 16; i += V, dst += G )
+    {
+        __m128i v = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + i ) ), mask );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), v );
+    }
+
+    for( ; n - i >= V; i += V, dst += G )
+    {
+        endian_store_n_tail_ssse3<T, N>( src + i, dst, V, mask );
+    }
+
+    endian_store_n_tail_ssse3<T, N>( src + i, dst, n - i, mask );
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_AVX2 inline void endian_store_n_avx2( T const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+    std::size_t const V = 16 / S;
+    std::size_t const G = V * N;
+
+    unsigned char m[ 16 ];
+    endian_store_n_mask<S, N, Order>( m );
+
+    __m128i const mask128 = _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) );
+    __m256i const mask = _mm256_broadcastsi128_si256( mask128 );
+
+    std::size_t i = 0;
+
+    // each step writes 16 bytes at dst and at dst + G, and produces 2 * G
+
+    for( ; ( n - i ) * N >= G + 16; i += 2 * V, dst += 2 * G )
+    {
+        __m256i v = _mm256_shuffle_epi8( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src + i ) ), mask );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm256_castsi256_si128( v ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + G ), _mm256_extracti128_si256( v, 1 ) );
+    }
+
+    for( ; n - i >= V; i += V, dst += G )
+    {
+        endian_store_n_tail_ssse3<T, N>( src + i, dst, V, mask128 );
+    }
+
+    endian_store_n_tail_ssse3<T, N>( src + i, dst, n - i, mask128 );
+}
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+template<class T, std::size_t N, order Order>
+BOOST_ENDIAN_TARGET_AVX512 inline void endian_store_n_avx512( T const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    std::size_t const S = sizeof(T);
+    std::size_t const V = 16 / S;
+    std::size_t const G = V * N;
+
+    unsigned char m[ 16 ];
+    endian_store_n_mask<S, N, Order>( m );
+
+    __m512i const mask = _mm512_maskz_broadcast_i32x4( 0xFFFF, _mm_loadu_si128( reinterpret_cast<__m128i const*>( m ) ) );
+
+    // moves the first G bytes of lane k to bytes [ k * G, k * G + G ); G is always even
+
+    unsigned short idx[ 32 ] = {};
+
+    for( std::size_t k = 0; k < 4; ++k )
+    {
+        for( std::size_t j = 0; j < G / 2; ++j )
+        {
+            idx[ k * G / 2 + j ] = static_cast<unsigned short>( k * 8 + j );
+        }
+    }
+
+    __m512i const compact = _mm512_loadu_si512( idx );
+
+    // a masked store writes exactly the 4 * G bytes produced
+
+    __mmask64 const sm = static_cast<__mmask64>( ( 1ull << ( 4 * G ) ) - 1 );
+
+    std::size_t i = 0;
+
+    for( ; i + 4 * V <= n; i += 4 * V, dst += 4 * G )
+    {
+        __m512i v = _mm512_shuffle_epi8( _mm512_loadu_si512( src + i ), mask );
+        _mm512_mask_storeu_epi8( dst, sm, _mm512_permutexvar_epi16( compact, v ) );
+    }
+
+    // the last 4 * V - 1 or fewer values go through the same path, with masked
+    // loads and stores
+
+    if( i < n )
+    {
+        std::size_t const r = n - i;
+
+        __mmask64 const lm = static_cast<__mmask64>( ( 1ull << ( r * S ) ) - 1 );
+        __mmask64 const tm = static_cast<__mmask64>( ( 1ull << ( r * N ) ) - 1 );
+
+        __m512i v = _mm512_shuffle_epi8( _mm512_maskz_loadu_epi8( lm, src + i ), mask );
+        _mm512_mask_storeu_epi8( dst, tm, _mm512_permutexvar_epi16( compact, v ) );
+    }
+}
+
+#endif
+
+template<class T, std::size_t N, order Order> struct endian_store_n_simd
+{
+    static void scalar( T const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_store_n_scalar<T, N, Order>( src, dst, n );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( T const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_store_n_ssse3<T, N, Order>( src, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( T const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_store_n_avx2<T, N, Order>( src, dst, n );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( T const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        endian_store_n_avx512<T, N, Order>( src, dst, n );
+    }
+
+#endif
+};
+
+// same size: a plain copy or a bulk reversal
+
+template<class T, std::size_t N, order Order, bool Truncate = ( N < sizeof(T) )> struct endian_store_n_impl
+{
+    static void apply( T const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        unsigned char const * p = reinterpret_cast<unsigned char const*>( src );
+
+        if( Order == order::native )
+        {
+            endian_reverse_n_copy<1>( p, dst, n * N, store_hint::normal );
+        }
+        else
+        {
+            endian_reverse_n_copy<N>( p, dst, n, store_hint::normal );
+        }
+    }
+};
+
+// truncating store
+
+template<class T, std::size_t N, order Order> struct endian_store_n_impl<T, N, Order, true>
+{
+    static void apply( T const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+#if defined(BOOST_ENDIAN_SIMD_SSSE3) || defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+
+        if( order::native == order::little && is_integral<T>::value )
+        {
+            simd_invoke< endian_store_n_simd<T, N, Order> >( src, dst, n );
+            return;
+        }
+
+#endif
+
+        endian_store_n_scalar<T, N, Order>( src, dst, n );
+    }
+};
+
+} // namespace detail
+
+// Requires:
+//
+//    sizeof(T) must be 1, 2, 4, or 8
+//    1 <= N <= sizeof(T)
+//    T is TriviallyCopyable
+//    if N < sizeof(T), T is integral or enum
+//    src points to n elements, dst to n * N writable bytes
+//
+// Effects:
+//
+//    endian_store<T, N, Order>( dst + i * N, src[ i ] ) for i in [0, n)
+
+template<class T, std::size_t N, enum order Order>
+inline void endian_store_n( T const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 );
+    BOOST_ENDIAN_STATIC_ASSERT( N >= 1 && N <= sizeof(T) );
+
+    detail::endian_store_n_impl<T, N, Order>::apply( src, dst, n );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_STORE_N_HPP_INCLUDED
@@ -0,0 +1,45 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_VALUE_TRAITS_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_VALUE_TRAITS_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/arithmetic.hpp>
+#include <boost/endian/buffers.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <cstddef>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// the order, value type and size of an endian_buffer or endian_arithmetic
+// type, when it names the format of a value, as in r.read<big_uint32_t>()
+
+template<class E> struct endian_value_traits;
+
+template<order Order, class T, std::size_t n_bits, align A>
+struct endian_value_traits< endian_buffer<Order, T, n_bits, A> >
+{
+    typedef T value_type;
+
+    static const order byte_order = Order;
+    static const std::size_t size = n_bits / 8;
+};
+
+template<order Order, class T, std::size_t n_bits, align A>
+struct endian_value_traits< endian_arithmetic<Order, T, n_bits, A> >:
+    endian_value_traits< endian_buffer<Order, T, n_bits, A> >
+{
+};
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_VALUE_TRAITS_HPP_INCLUDED
@@ -0,0 +1,708 @@
+#ifndef BOOST_ENDIAN_DETAIL_ENDIAN_VARINT_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_ENDIAN_VARINT_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/integral_by_size.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <cstddef>
+
+namespace boost
+{
+namespace endian
+{
+
+// the largest number of bytes of the varint of a T
+
+template<class T> struct varint_max_size: detail::integral_constant<std::size_t, ( sizeof(T) * 8 + 6 ) / 7>
+{
+};
+
+namespace detail
+{
+
+// Variable length integers, as in LEB128, Protocol Buffers and WebAssembly:
+// 7 bits per byte, least significant group first, with the top bit of every
+// byte but the last set. Signed values are zigzag encoded first, so that
+// values of small magnitude have short encodings.
+//
+// A varint of T is invalid when it is longer than varint_max_size<T>, or
+// when its last byte has bits above the width of T.
+
+template<class T> struct varint_unsigned
+{
+    typedef typename integral_by_size<sizeof(T)>::type type;
+};
+
+template<class T>
+inline typename varint_unsigned<T>::type zigzag_encode( T v ) noexcept
+{
+    typedef typename varint_unsigned<T>::type U;
+
+    U const u = static_cast<U>( v );
+    return static_cast<U>( static_cast<U>( u << 1 ) ^ static_cast<U>( U( 0 ) - ( u >> ( sizeof(T) * 8 - 1 ) ) ) );
+}
+
+template<class T>
+inline T zigzag_decode( typename varint_unsigned<T>::type u ) noexcept
+{
+    typedef typename varint_unsigned<T>::type U;
+    return static_cast<T>( static_cast<U>( ( u >> 1 ) ^ static_cast<U>( U( 0 ) - ( u & 1 ) ) ) );
+}
+
+template<class T>
+inline typename varint_unsigned<T>::type varint_encode_value( T v ) noexcept
+{
+    return is_signed<T>::value? zigzag_encode( v ): static_cast<typename varint_unsigned<T>::type>( v );
+}
+
+template<class T>
+inline T varint_decode_value( typename varint_unsigned<T>::type u ) noexcept
+{
+    return is_signed<T>::value? zigzag_decode<T>( u ): static_cast<T>( u );
+}
+
+// one value; returns the number of bytes, or 0 when the n bytes at p do not
+// begin with a valid varint
+
+template<class T>
+inline std::size_t varint_load_one( unsigned char const * p, std::size_t n, T & v ) noexcept
+{
+    typedef typename varint_unsigned<T>::type U;
+
+    std::size_t const m = varint_max_size<T>::value;
+
+    U r = 0;
+
+    for( std::size_t i = 0; i < n && i < m; ++i )
+    {
+        unsigned const b = p[ i ];
+
+        r = static_cast<U>( r | static_cast<U>( static_cast<U>( b & 0x7F ) << ( 7 * i ) ) );
+
+        if( b < 0x80 )
+        {
+            if( i == m - 1 && ( b >> ( sizeof(T) * 8 - 7 * i ) ) != 0 )
+            {
+                return 0;
+            }
+
+            v = varint_decode_value<T>( r );
+            return i + 1;
+        }
+    }
+
+    return 0;
+}
+
+template<class T>
+inline std::size_t varint_store_one( unsigned char * p, T v ) noexcept
+{
+    typename varint_unsigned<T>::type u = varint_encode_value( v );
+
+    std::size_t i = 0;
+
+    for( ; u >= 0x80; u >>= 7 )
+    {
+        p[ i++ ] = static_cast<unsigned char>( u | 0x80 );
+    }
+
+    p[ i++ ] = static_cast<unsigned char>( u );
+    return i;
+}
+
+template<class T>
+inline void endian_load_varint_n_scalar( unsigned char const * src, std::size_t size, T * dst, std::size_t n, std::size_t * r ) noexcept
+{
+    std::size_t j = 0;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        std::size_t const k = varint_load_one( src + j, size - j, dst[ i ] );
+
+        if( k == 0 )
+        {
+            *r = 0;
+            return;
+        }
+
+        j += k;
+    }
+
+    *r = j;
+}
+
+template<class T>
+inline void endian_store_varint_n_scalar( T const * src, unsigned char * dst, std::size_t n, std::size_t * r ) noexcept
+{
+    std::size_t j = 0;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        j += varint_store_one( dst + j, src[ i ] );
+    }
+
+    *r = j;
+}
+
+// The vector decoder follows masked VByte (Plaisance, Kurz and Lemire,
+// "Vectorized VByte Decoding"). The top bits of 16 input bytes are gathered
+// with pmovmskb; when all are clear, the 16 bytes are 16 values. Otherwise
+// the bits of the first 12 bytes select a table entry, which decodes the
+// next six values of one or two bytes, or the next four of one to three
+// bytes, with a byte shuffle into 16 or 32-bit lanes and a merge of the
+// 7-bit groups; a longer value is decoded alone by the scalar code.
+//
+// The encoder is the reverse: four values below 2^21 are spread into three
+// 7-bit groups per 32-bit lane, the continuation bits are set from compares,
+// and a shuffle selected by the lengths packs the bytes together.
+
+struct varint_entry
+{
+    unsigned char kind; // 0: scalar, 1: six values of 1-2 bytes, 2: four values of 1-3 bytes
+    unsigned char pattern;
+    unsigned char length;
+};
+
+struct varint_tables
+{
+    varint_entry decode[ 4096 ];
+
+    unsigned char shuffle2[ 64 ][ 16 ];
+    unsigned char shuffle3[ 81 ][ 16 ];
+
+    // indexed by the lanes of two or more bytes, and those of three bytes << 4
+
+    unsigned char pack[ 256 ][ 16 ];
+    unsigned char pack_length[ 256 ];
+
+    varint_tables() noexcept
+    {
+        for( unsigned m = 0; m < 4096; ++m )
+        {
+            unsigned len[ 12 ];
+            unsigned count = 0, k = 0;
+
+            for( unsigned b = 0; b < 12; ++b )
+            {
+                ++k;
+
+                if( ( m >> b & 1 ) == 0 )
+                {
+                    len[ count++ ] = k;
+                    k = 0;
+                }
+            }
+
+            varint_entry e = { 0, 0, 0 };
+
+            if( count >= 6 && len[ 0 ] <= 2 && len[ 1 ] <= 2 && len[ 2 ] <= 2 && len[ 3 ] <= 2 && len[ 4 ] <= 2 && len[ 5 ] <= 2 )
+            {
+                e.kind = 1;
+
+                for( unsigned i = 0; i < 6; ++i )
+                {
+                    e.pattern = static_cast<unsigned char>( e.pattern | ( len[ i ] - 1 ) << i );
+                    e.length = static_cast<unsigned char>( e.length + len[ i ] );
+                }
+            }
+            else if( count >= 4 && len[ 0 ] <= 3 && len[ 1 ] <= 3 && len[ 2 ] <= 3 && len[ 3 ] <= 3 )
+            {
+                e.kind = 2;
+
+                for( unsigned i = 0, w = 1; i < 4; ++i, w *= 3 )
+                {
+                    e.pattern = static_cast<unsigned char>( e.pattern + ( len[ i ] - 1 ) * w );
+                    e.length = static_cast<unsigned char>( e.length + len[ i ] );
+                }
+            }
+
+            decode[ m ] = e;
+        }
+
+        for( unsigned p = 0; p < 64; ++p )
+        {
+            unsigned o = 0;
+
+            for( unsigned i = 0; i < 8; ++i )
+            {
+                if( i < 6 )
+                {
+                    unsigned const two = p >> i & 1;
+
+                    shuffle2[ p ][ 2 * i ] = static_cast<unsigned char>( o );
+                    shuffle2[ p ][ 2 * i + 1 ] = static_cast<unsigned char>( two? o + 1: 0x80 );
+
+                    o += 1 + two;
+                }
+                else
+                {
+                    shuffle2[ p ][ 2 * i ] = shuffle2[ p ][ 2 * i + 1 ] = 0x80;
+                }
+            }
+        }
+
+        for( unsigned p = 0; p < 81; ++p )
+        {
+            unsigned o = 0;
+
+            for( unsigned i = 0, w = 1; i < 4; ++i, w *= 3 )
+            {
+                unsigned const d = p / w % 3;
+
+                for( unsigned j = 0; j < 4; ++j )
+                {
+                    shuffle3[ p ][ 4 * i + j ] = static_cast<unsigned char>( j <= d && j < 3? o + j: 0x80 );
+                }
+
+                o += d + 1;
+            }
+        }
+
+        for( unsigned m = 0; m < 256; ++m )
+        {
+            unsigned q = 0;
+
+            for( unsigned i = 0; i < 4; ++i )
+            {
+                unsigned const l = 1 + ( m >> i & 1 ) + ( m >> ( i + 4 ) & 1 );
+
+                for( unsigned j = 0; j < l; ++j )
+                {
+                    pack[ m ][ q++ ] = static_cast<unsigned char>( 4 * i + j );
+                }
+            }
+
+            pack_length[ m ] = static_cast<unsigned char>( q );
+
+            for( ; q < 16; ++q )
+            {
+                pack[ m ][ q ] = 0x80;
+            }
+        }
+    }
+};
+
+inline varint_tables const & varint_get_tables() noexcept
+{
+    static const varint_tables t;
+    return t;
+}
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+// four values in the 32-bit lanes of a vector, zigzag encoded when signed
+
+template<class T, std::size_t S = sizeof(T), bool Signed = is_signed<T>::value> struct varint_lanes;
+
+BOOST_ENDIAN_TARGET_SSSE3 inline __m128i varint_zigzag_decode_32( __m128i v ) noexcept
+{
+    return _mm_xor_si128( _mm_srli_epi32( v, 1 ), _mm_sub_epi32( _mm_setzero_si128(), _mm_and_si128( v, _mm_set1_epi32( 1 ) ) ) );
+}
+
+// true when all four values are below 2^21, and so have at most three bytes
+
+BOOST_ENDIAN_TARGET_SSSE3 inline bool varint_short_32( __m128i v ) noexcept
+{
+    return _mm_movemask_epi8( _mm_cmpeq_epi32( _mm_srli_epi32( v, 21 ), _mm_setzero_si128() ) ) == 0xFFFF;
+}
+
+template<class T> struct varint_lanes<T, 4, false>
+{
+    BOOST_ENDIAN_TARGET_SSSE3 static void store( T * dst, __m128i v ) noexcept
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), v );
+    }
+
+    BOOST_ENDIAN_TARGET_SSSE3 static bool load( T const * src, __m128i & v ) noexcept
+    {
+        v = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src ) );
+        return varint_short_32( v );
+    }
+};
+
+template<class T> struct varint_lanes<T, 4, true>
+{
+    BOOST_ENDIAN_TARGET_SSSE3 static void store( T * dst, __m128i v ) noexcept
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), varint_zigzag_decode_32( v ) );
+    }
+
+    BOOST_ENDIAN_TARGET_SSSE3 static bool load( T const * src, __m128i & v ) noexcept
+    {
+        __m128i const x = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src ) );
+
+        v = _mm_xor_si128( _mm_slli_epi32( x, 1 ), _mm_srai_epi32( x, 31 ) );
+        return varint_short_32( v );
+    }
+};
+
+template<class T> struct varint_lanes<T, 8, false>
+{
+    BOOST_ENDIAN_TARGET_SSSE3 static void store( T * dst, __m128i v ) noexcept
+    {
+        __m128i const zero = _mm_setzero_si128();
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_unpacklo_epi32( v, zero ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 2 ), _mm_unpackhi_epi32( v, zero ) );
+    }
+
+    // the low halves, when the high halves are zero
+
+    BOOST_ENDIAN_TARGET_SSSE3 static bool narrow( __m128i a, __m128i b, __m128i & v ) noexcept
+    {
+        __m128 const fa = _mm_castsi128_ps( a );
+        __m128 const fb = _mm_castsi128_ps( b );
+
+        v = _mm_castps_si128( _mm_shuffle_ps( fa, fb, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+        __m128i const h = _mm_castps_si128( _mm_shuffle_ps( fa, fb, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+
+        return _mm_movemask_epi8( _mm_cmpeq_epi32( _mm_or_si128( h, _mm_srli_epi32( v, 21 ) ), _mm_setzero_si128() ) ) == 0xFFFF;
+    }
+
+    BOOST_ENDIAN_TARGET_SSSE3 static bool load( T const * src, __m128i & v ) noexcept
+    {
+        return narrow( _mm_loadu_si128( reinterpret_cast<__m128i const*>( src ) ), _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + 2 ) ), v );
+    }
+};
+
+template<class T> struct varint_lanes<T, 8, true>
+{
+    BOOST_ENDIAN_TARGET_SSSE3 static void store( T * dst, __m128i v ) noexcept
+    {
+        __m128i const d = varint_zigzag_decode_32( v );
+        __m128i const s = _mm_srai_epi32( d, 31 );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_unpacklo_epi32( d, s ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 2 ), _mm_unpackhi_epi32( d, s ) );
+    }
+
+    BOOST_ENDIAN_TARGET_SSSE3 static __m128i zigzag( __m128i x ) noexcept
+    {
+        __m128i const s = _mm_shuffle_epi32( _mm_srai_epi32( x, 31 ), _MM_SHUFFLE( 3, 3, 1, 1 ) );
+        return _mm_xor_si128( _mm_slli_epi64( x, 1 ), s );
+    }
+
+    BOOST_ENDIAN_TARGET_SSSE3 static bool load( T const * src, __m128i & v ) noexcept
+    {
+        __m128i const a = zigzag( _mm_loadu_si128( reinterpret_cast<__m128i const*>( src ) ) );
+        __m128i const b = zigzag( _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + 2 ) ) );
+
+        return varint_lanes<detail::uint64_t, 8, false>::narrow( a, b, v );
+    }
+};
+
+template<class T>
+BOOST_ENDIAN_TARGET_SSSE3 inline void endian_load_varint_n_ssse3( unsigned char const * src, std::size_t size, T * dst, std::size_t n, std::size_t * r ) noexcept
+{
+    typedef varint_lanes<T> L;
+
+    varint_tables const & t = varint_get_tables();
+
+    __m128i const zero = _mm_setzero_si128();
+
+    std::size_t i = 0, j = 0;
+
+    while( n - i >= 16 && size - j >= 16 )
+    {
+        __m128i const v = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + j ) );
+        int const m = _mm_movemask_epi8( v );
+
+        if( m == 0 )
+        {
+            __m128i const lo = _mm_unpacklo_epi8( v, zero );
+            __m128i const hi = _mm_unpackhi_epi8( v, zero );
+
+            L::store( dst + i +  0, _mm_unpacklo_epi16( lo, zero ) );
+            L::store( dst + i +  4, _mm_unpackhi_epi16( lo, zero ) );
+            L::store( dst + i +  8, _mm_unpacklo_epi16( hi, zero ) );
+            L::store( dst + i + 12, _mm_unpackhi_epi16( hi, zero ) );
+
+            i += 16;
+            j += 16;
+
+            continue;
+        }
+
+        varint_entry const e = t.decode[ m & 0xFFF ];
+
+        if( e.kind == 1 )
+        {
+            __m128i x = _mm_shuffle_epi8( v, _mm_loadu_si128( reinterpret_cast<__m128i const*>( t.shuffle2[ e.pattern ] ) ) );
+
+            x = _mm_or_si128(
+                _mm_and_si128( x, _mm_set1_epi16( 0x7F ) ),
+                _mm_srli_epi16( _mm_and_si128( x, _mm_set1_epi16( 0x7F00 ) ), 1 ) );
+
+            // eight lanes, of which the last two are written over next
+
+            L::store( dst + i, _mm_unpacklo_epi16( x, zero ) );
+            L::store( dst + i + 4, _mm_unpackhi_epi16( x, zero ) );
+
+            i += 6;
+            j += e.length;
+        }
+        else if( e.kind == 2 )
+        {
+            __m128i x = _mm_shuffle_epi8( v, _mm_loadu_si128( reinterpret_cast<__m128i const*>( t.shuffle3[ e.pattern ] ) ) );
+
+            x = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_and_si128( x, _mm_set1_epi32( 0x7F ) ),
+                    _mm_srli_epi32( _mm_and_si128( x, _mm_set1_epi32( 0x7F00 ) ), 1 ) ),
+                _mm_srli_epi32( _mm_and_si128( x, _mm_set1_epi32( 0x7F0000 ) ), 2 ) );
+
+            L::store( dst + i, x );
+
+            i += 4;
+            j += e.length;
+        }
+        else
+        {
+            std::size_t const k = varint_load_one( src + j, size - j, dst[ i ] );
+
+            if( k == 0 )
+            {
+                *r = 0;
+                return;
+            }
+
+            i += 1;
+            j += k;
+        }
+    }
+
+    std::size_t k = 0;
+    endian_load_varint_n_scalar( src + j, size - j, dst + i, n - i, &k );
+
+    *r = k == 0 && i < n? 0: j + k;
+}
+
+template<class T>
+BOOST_ENDIAN_TARGET_SSSE3 inline void endian_store_varint_n_ssse3( T const * src, unsigned char * dst, std::size_t n, std::size_t * r ) noexcept
+{
+    typedef varint_lanes<T> L;
+
+    varint_tables const & t = varint_get_tables();
+
+    __m128i const zero = _mm_setzero_si128();
+
+    std::size_t i = 0, j = 0;
+
+    for( ; i + 4 <= n; i += 4 )
+    {
+        __m128i x;
+
+        if( !L::load( src + i, x ) )
+        {
+            for( std::size_t k = 0; k < 4; ++k )
+            {
+                j += varint_store_one( dst + j, src[ i + k ] );
+            }
+
+            continue;
+        }
+
+        __m128i const two = _mm_cmpeq_epi32( _mm_srli_epi32( x, 7 ), zero );    // one byte
+        __m128i const three = _mm_cmpeq_epi32( _mm_srli_epi32( x, 14 ), zero ); // at most two
+
+        __m128i y = _mm_or_si128(
+            _mm_or_si128(
+                _mm_and_si128( x, _mm_set1_epi32( 0x7F ) ),
+                _mm_and_si128( _mm_slli_epi32( x, 1 ), _mm_set1_epi32( 0x7F00 ) ) ),
+            _mm_and_si128( _mm_slli_epi32( x, 2 ), _mm_set1_epi32( 0x7F0000 ) ) );
+
+        y = _mm_or_si128( y, _mm_andnot_si128( two, _mm_set1_epi32( 0x80 ) ) );
+        y = _mm_or_si128( y, _mm_andnot_si128( three, _mm_set1_epi32( 0x8000 ) ) );
+
+        unsigned const m = ( ~_mm_movemask_ps( _mm_castsi128_ps( two ) ) & 0xF ) | ( ~_mm_movemask_ps( _mm_castsi128_ps( three ) ) & 0xF ) << 4;
+
+        // dst has room for four values of at least five bytes
+
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + j ), _mm_shuffle_epi8( y, _mm_loadu_si128( reinterpret_cast<__m128i const*>( t.pack[ m ] ) ) ) );
+
+        j += t.pack_length[ m ];
+    }
+
+    std::size_t k = 0;
+    endian_store_varint_n_scalar( src + i, dst + j, n - i, &k );
+
+    *r = j + k;
+}
+
+#endif
+
+// the wider instruction sets offer nothing that the SSSE3 kernels use
+
+template<class T> struct endian_load_varint_n_simd
+{
+    static void scalar( unsigned char const * src, std::size_t size, T * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_load_varint_n_scalar( src, size, dst, n, r );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( unsigned char const * src, std::size_t size, T * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_load_varint_n_ssse3( src, size, dst, n, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( unsigned char const * src, std::size_t size, T * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_load_varint_n_ssse3( src, size, dst, n, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( unsigned char const * src, std::size_t size, T * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_load_varint_n_ssse3( src, size, dst, n, r );
+    }
+
+#endif
+};
+
+template<class T> struct endian_store_varint_n_simd
+{
+    static void scalar( T const * src, unsigned char * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_store_varint_n_scalar( src, dst, n, r );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    static void ssse3( T const * src, unsigned char * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_store_varint_n_ssse3( src, dst, n, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    static void avx2( T const * src, unsigned char * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_store_varint_n_ssse3( src, dst, n, r );
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    static void avx512( T const * src, unsigned char * dst, std::size_t n, std::size_t * r ) noexcept
+    {
+        endian_store_varint_n_ssse3( src, dst, n, r );
+    }
+
+#endif
+};
+
+// the vector kernels handle 4 and 8 byte integers
+
+template<class T> struct endian_varint_vectorizable: integral_constant<bool,
+    order::native == order::little && ( sizeof(T) == 4 || sizeof(T) == 8 )>
+{
+};
+
+template<class T>
+inline std::size_t endian_load_varint_n_impl( unsigned char const * src, std::size_t size, T * dst, std::size_t n, integral_constant<bool, false> ) noexcept
+{
+    std::size_t r = 0;
+    endian_load_varint_n_scalar( src, size, dst, n, &r );
+
+    return r;
+}
+
+template<class T>
+inline std::size_t endian_load_varint_n_impl( unsigned char const * src, std::size_t size, T * dst, std::size_t n, integral_constant<bool, true> ) noexcept
+{
+    std::size_t r = 0;
+    simd_invoke< endian_load_varint_n_simd<T> >( src, size, dst, n, &r );
+
+    return r;
+}
+
+template<class T>
+inline std::size_t endian_store_varint_n_impl( T const * src, unsigned char * dst, std::size_t n, integral_constant<bool, false> ) noexcept
+{
+    std::size_t r = 0;
+    endian_store_varint_n_scalar( src, dst, n, &r );
+
+    return r;
+}
+
+template<class T>
+inline std::size_t endian_store_varint_n_impl( T const * src, unsigned char * dst, std::size_t n, integral_constant<bool, true> ) noexcept
+{
+    std::size_t r = 0;
+    simd_invoke< endian_store_varint_n_simd<T> >( src, dst, n, &r );
+
+    return r;
+}
+
+} // namespace detail
+
+// Requires:
+//
+//    T is an integral type other than bool
+//    src points to size readable bytes, dst to n elements
+//
+// Effects:
+//
+//    decodes n varints of T from the bytes at src into dst; signed values
+//    are zigzag decoded
+//
+// Returns:
+//
+//    the number of bytes read, or 0 when the bytes do not begin with n valid
+//    varints, in which case the contents of dst are unspecified
+
+template<class T>
+inline std::size_t load_varint_n( unsigned char const * src, std::size_t size, T * dst, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT(( detail::is_integral<T>::value && !detail::is_same<T, bool>::value ));
+
+    return detail::endian_load_varint_n_impl( src, size, dst, n, detail::endian_varint_vectorizable<T>() );
+}
+
+// Requires:
+//
+//    T is an integral type other than bool
+//    src points to n elements, dst to n * varint_max_size<T>::value writable bytes
+//
+// Effects:
+//
+//    encodes src[ i ] for i in [0, n) as varints into the bytes at dst; signed
+//    values are zigzag encoded
+//
+// Returns:
+//
+//    the number of bytes written
+
+template<class T>
+inline std::size_t store_varint_n( T const * src, unsigned char * dst, std::size_t n ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT(( detail::is_integral<T>::value && !detail::is_same<T, bool>::value ));
+
+    return detail::endian_store_varint_n_impl( src, dst, n, detail::endian_varint_vectorizable<T>() );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_ENDIAN_VARINT_HPP_INCLUDED
@@ -0,0 +1,305 @@
+#ifndef BOOST_ENDIAN_DETAIL_IO_RING_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_IO_RING_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// A minimal io_uring, for the reads and writes of <boost/endian/pipeline.hpp>,
+// made with raw system calls so that no library needs to be linked. Only
+// Linux 5.6 or later is supported; where the kernel does not support it, or
+// forbids it, open() fails and the pipeline uses threads instead.
+
+#include <cstddef>
+
+#if defined(__linux__) && !defined(BOOST_ENDIAN_NO_IO_URING) && defined(__has_include)
+# if __has_include(<linux/io_uring.h>)
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <cerrno>
+#  include <cstring>
+#  if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(IORING_FEAT_RW_CUR_POS)
+#   define BOOST_ENDIAN_HAS_IO_URING
+#  endif
+# endif
+#endif
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+#if defined(BOOST_ENDIAN_HAS_IO_URING)
+
+class io_ring
+{
+private:
+
+    int fd_;
+
+    void * sq_ring_;
+    std::size_t sq_ring_size_;
+    void * cq_ring_;
+    std::size_t cq_ring_size_;
+
+    io_uring_sqe * sqes_;
+    std::size_t sqes_size_;
+
+    unsigned * sq_head_;
+    unsigned * sq_tail_;
+    unsigned sq_mask_;
+    unsigned * sq_array_;
+
+    unsigned * cq_head_;
+    unsigned * cq_tail_;
+    unsigned cq_mask_;
+    io_uring_cqe * cqes_;
+
+    // the entries queued since the last submit
+    unsigned pending_;
+
+    static unsigned * at( void * ring, unsigned offset ) noexcept
+    {
+        return reinterpret_cast<unsigned*>( static_cast<unsigned char*>( ring ) + offset );
+    }
+
+    int enter( unsigned submit, unsigned wait ) noexcept
+    {
+        for( ;; )
+        {
+            long r = ::syscall( __NR_io_uring_enter, fd_, submit, wait, wait != 0? IORING_ENTER_GETEVENTS: 0u, static_cast<void*>( 0 ), 0 );
+
+            if( r >= 0 )
+            {
+                return static_cast<int>( r );
+            }
+
+            if( errno != EINTR )
+            {
+                return -errno;
+            }
+        }
+    }
+
+public:
+
+    io_ring() noexcept: fd_( -1 ), sq_ring_( 0 ), sq_ring_size_( 0 ), cq_ring_( 0 ), cq_ring_size_( 0 ), sqes_( 0 ), sqes_size_( 0 ), pending_( 0 )
+    {
+    }
+
+    ~io_ring() noexcept
+    {
+        close();
+    }
+
+    io_ring( io_ring const & ) = delete;
+    io_ring & operator=( io_ring const & ) = delete;
+
+    // a ring for at least `entries` operations in flight; returns 0 or an
+    // errno
+
+    int open( unsigned entries ) noexcept
+    {
+        close();
+
+        io_uring_params p;
+        std::memset( &p, 0, sizeof(p) );
+
+        long r = ::syscall( __NR_io_uring_setup, entries, &p );
+
+        if( r < 0 )
+        {
+            return errno;
+        }
+
+        fd_ = static_cast<int>( r );
+
+        // IORING_OP_READ and IORING_OP_WRITE came with IORING_FEAT_RW_CUR_POS
+
+        if( !( p.features & IORING_FEAT_RW_CUR_POS ) )
+        {
+            close();
+            return ENOSYS;
+        }
+
+        sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+        if( p.features & IORING_FEAT_SINGLE_MMAP )
+        {
+            if( cq_ring_size_ > sq_ring_size_ )
+            {
+                sq_ring_size_ = cq_ring_size_;
+            }
+
+            cq_ring_size_ = 0;
+        }
+
+        sq_ring_ = ::mmap( 0, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING );
+
+        if( sq_ring_ == MAP_FAILED )
+        {
+            sq_ring_ = 0;
+
+            int const e = errno;
+            close();
+            return e;
+        }
+
+        if( cq_ring_size_ == 0 )
+        {
+            cq_ring_ = sq_ring_;
+        }
+        else
+        {
+            cq_ring_ = ::mmap( 0, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING );
+
+            if( cq_ring_ == MAP_FAILED )
+            {
+                cq_ring_ = 0;
+
+                int const e = errno;
+                close();
+                return e;
+            }
+        }
+
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+
+        void * s = ::mmap( 0, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES );
+
+        if( s == MAP_FAILED )
+        {
+            int const e = errno;
+            close();
+            return e;
+        }
+
+        sqes_ = static_cast<io_uring_sqe*>( s );
+
+        sq_head_ = at( sq_ring_, p.sq_off.head );
+        sq_tail_ = at( sq_ring_, p.sq_off.tail );
+        sq_mask_ = *at( sq_ring_, p.sq_off.ring_mask );
+        sq_array_ = at( sq_ring_, p.sq_off.array );
+
+        cq_head_ = at( cq_ring_, p.cq_off.head );
+        cq_tail_ = at( cq_ring_, p.cq_off.tail );
+        cq_mask_ = *at( cq_ring_, p.cq_off.ring_mask );
+        cqes_ = reinterpret_cast<io_uring_cqe*>( static_cast<unsigned char*>( cq_ring_ ) + p.cq_off.cqes );
+
+        pending_ = 0;
+
+        return 0;
+    }
+
+    void close() noexcept
+    {
+        if( sqes_ != 0 )
+        {
+            ::munmap( sqes_, sqes_size_ );
+            sqes_ = 0;
+        }
+
+        if( cq_ring_ != 0 && cq_ring_ != sq_ring_ )
+        {
+            ::munmap( cq_ring_, cq_ring_size_ );
+        }
+
+        cq_ring_ = 0;
+
+        if( sq_ring_ != 0 )
+        {
+            ::munmap( sq_ring_, sq_ring_size_ );
+            sq_ring_ = 0;
+        }
+
+        if( fd_ >= 0 )
+        {
+            ::close( fd_ );
+            fd_ = -1;
+        }
+    }
+
+    bool is_open() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    // queues a read or write of n bytes at offset; at most `entries` may be
+    // queued between two calls to submit()
+
+    void prepare( bool write, int fd, void * p, std::size_t n, unsigned long long offset, unsigned long long user_data ) noexcept
+    {
+        unsigned const tail = *sq_tail_ + pending_;
+        unsigned const i = tail & sq_mask_;
+
+        io_uring_sqe & e = sqes_[ i ];
+        std::memset( &e, 0, sizeof(e) );
+
+        e.opcode = static_cast<unsigned char>( write? IORING_OP_WRITE: IORING_OP_READ );
+        e.fd = fd;
+        e.addr = reinterpret_cast<unsigned long long>( p );
+        e.len = static_cast<unsigned>( n );
+        e.off = offset;
+        e.user_data = user_data;
+
+        sq_array_[ i ] = i;
+        ++pending_;
+    }
+
+    // passes the queued operations, and any that the kernel did not take
+    // before, and waits for at least `wait` of those in flight to complete;
+    // returns 0 or an errno
+
+    int submit( unsigned wait = 0 ) noexcept
+    {
+        unsigned const tail = *sq_tail_ + pending_;
+
+        __atomic_store_n( sq_tail_, tail, __ATOMIC_RELEASE );
+        pending_ = 0;
+
+        unsigned const n = tail - __atomic_load_n( sq_head_, __ATOMIC_ACQUIRE );
+
+        if( n == 0 && wait == 0 )
+        {
+            return 0;
+        }
+
+        int const r = enter( n, wait );
+        return r < 0? -r: 0;
+    }
+
+    // takes a completion, if one is available; res is the result of the
+    // read or write, or minus an errno
+
+    bool complete( unsigned long long & user_data, int & res ) noexcept
+    {
+        unsigned const head = *cq_head_;
+
+        if( head == __atomic_load_n( cq_tail_, __ATOMIC_ACQUIRE ) )
+        {
+            return false;
+        }
+
+        io_uring_cqe const & c = cqes_[ head & cq_mask_ ];
+
+        user_data = c.user_data;
+        res = c.res;
+
+        __atomic_store_n( cq_head_, head + 1, __ATOMIC_RELEASE );
+        return true;
+    }
+};
+
+#endif // defined(BOOST_ENDIAN_HAS_IO_URING)
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_IO_RING_HPP_INCLUDED
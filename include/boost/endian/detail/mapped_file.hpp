@@ -0,0 +1,315 @@
+#ifndef BOOST_ENDIAN_DETAIL_MAPPED_FILE_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_MAPPED_FILE_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// A shared memory mapping of a whole file, made with the POSIX calls. Mappings
+// of 2 MB or more are placed at a 2 MB boundary, so that the kernel can back
+// them with huge pages when the file system supports it and MADV_HUGEPAGE is
+// given.
+
+#include <cstddef>
+#include <system_error>
+
+#if ( defined(__unix__) || defined(__APPLE__) ) && !defined(BOOST_ENDIAN_NO_MMAP)
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <cerrno>
+# define BOOST_ENDIAN_HAS_MMAP
+#endif
+
+namespace boost
+{
+namespace endian
+{
+
+// Hints for the paging of a mapped range; see madvise(2). hugepage asks
+// for transparent huge pages and is ignored where they are not available.
+
+enum class map_advice
+{
+    normal,
+    sequential,
+    random,
+    willneed,
+    dontneed,
+    hugepage
+};
+
+namespace detail
+{
+
+#if defined(BOOST_ENDIAN_HAS_MMAP)
+
+class mapped_file
+{
+private:
+
+    unsigned char * p_;
+    std::size_t n_;
+
+    static std::size_t const huge_page = std::size_t( 1 ) << 21;
+
+    static std::error_code last_error() noexcept
+    {
+        return std::error_code( errno, std::generic_category() );
+    }
+
+    // n bytes of fd, at a huge page boundary when n is at least one huge page
+
+    static void * map( int fd, std::size_t n, int prot ) noexcept
+    {
+        if( n < huge_page )
+        {
+            return ::mmap( 0, n, prot, MAP_SHARED, fd, 0 );
+        }
+
+        // reserve n plus a huge page of address space, map the file over the
+        // aligned part, and return the rest
+
+        void * r = ::mmap( 0, n + huge_page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+        if( r == MAP_FAILED )
+        {
+            return ::mmap( 0, n, prot, MAP_SHARED, fd, 0 );
+        }
+
+        unsigned char * const first = static_cast<unsigned char*>( r );
+        unsigned char * const last = first + n + huge_page;
+
+        unsigned char * const q = first + ( huge_page - reinterpret_cast<std::size_t>( first ) % huge_page ) % huge_page;
+
+        void * p = ::mmap( q, n, prot, MAP_SHARED | MAP_FIXED, fd, 0 );
+
+        if( p == MAP_FAILED )
+        {
+            int const e = errno;
+
+            ::munmap( r, n + huge_page );
+
+            errno = e;
+            return MAP_FAILED;
+        }
+
+        std::size_t const page = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+        unsigned char * const end = q + ( n + page - 1 ) / page * page;
+
+        if( q != first )
+        {
+            ::munmap( first, static_cast<std::size_t>( q - first ) );
+        }
+
+        if( end < last )
+        {
+            ::munmap( end, static_cast<std::size_t>( last - end ) );
+        }
+
+        return p;
+    }
+
+public:
+
+    mapped_file() noexcept: p_( 0 ), n_( 0 )
+    {
+    }
+
+    ~mapped_file() noexcept
+    {
+        close();
+    }
+
+    mapped_file( mapped_file && r ) noexcept: p_( r.p_ ), n_( r.n_ )
+    {
+        r.p_ = 0;
+        r.n_ = 0;
+    }
+
+    mapped_file & operator=( mapped_file && r ) noexcept
+    {
+        if( this != &r )
+        {
+            close();
+
+            p_ = r.p_;
+            n_ = r.n_;
+
+            r.p_ = 0;
+            r.n_ = 0;
+        }
+
+        return *this;
+    }
+
+    mapped_file( mapped_file const & ) = delete;
+    mapped_file & operator=( mapped_file const & ) = delete;
+
+    // maps the whole file; an empty file is open, with no bytes
+
+    bool open( char const * path, bool writable, std::error_code & ec ) noexcept
+    {
+        close();
+        ec.clear();
+
+        int const fd = ::open( path, writable? O_RDWR: O_RDONLY );
+
+        if( fd < 0 )
+        {
+            ec = last_error();
+            return false;
+        }
+
+        struct stat st;
+
+        if( ::fstat( fd, &st ) != 0 )
+        {
+            ec = last_error();
+            ::close( fd );
+            return false;
+        }
+
+        std::size_t const n = static_cast<std::size_t>( st.st_size );
+
+        if( n == 0 )
+        {
+            ::close( fd );
+
+            // a non-null pointer to no bytes, so that the mapping reads as open
+
+            static unsigned char empty;
+
+            p_ = &empty;
+            n_ = 0;
+
+            return true;
+        }
+
+        void * p = map( fd, n, writable? PROT_READ | PROT_WRITE: PROT_READ );
+
+        if( p == MAP_FAILED )
+        {
+            ec = last_error();
+            ::close( fd );
+            return false;
+        }
+
+        // the mapping holds its own reference to the file
+
+        ::close( fd );
+
+        p_ = static_cast<unsigned char*>( p );
+        n_ = n;
+
+        return true;
+    }
+
+    void close() noexcept
+    {
+        if( n_ != 0 )
+        {
+            ::munmap( p_, n_ );
+        }
+
+        p_ = 0;
+        n_ = 0;
+    }
+
+    bool is_open() const noexcept
+    {
+        return p_ != 0;
+    }
+
+    unsigned char * data() const noexcept
+    {
+        return p_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return n_;
+    }
+
+    // the pages that overlap [offset, offset + n)
+
+    bool advise( std::size_t offset, std::size_t n, map_advice a ) const noexcept
+    {
+        if( n_ == 0 || offset >= n_ )
+        {
+            return true;
+        }
+
+        if( n > n_ - offset )
+        {
+            n = n_ - offset;
+        }
+
+        std::size_t const page = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+        std::size_t const first = offset / page * page;
+
+        int advice = MADV_NORMAL;
+
+        switch( a )
+        {
+        case map_advice::normal: advice = MADV_NORMAL; break;
+        case map_advice::sequential: advice = MADV_SEQUENTIAL; break;
+        case map_advice::random: advice = MADV_RANDOM; break;
+        case map_advice::willneed: advice = MADV_WILLNEED; break;
+        case map_advice::dontneed: advice = MADV_DONTNEED; break;
+
+        case map_advice::hugepage:
+
+#if defined(MADV_HUGEPAGE)
+
+            advice = MADV_HUGEPAGE;
+            break;
+
+#else
+
+            return true;
+
+#endif
+        }
+
+        return ::madvise( p_ + first, offset + n - first, advice ) == 0;
+    }
+
+    // writes the modified pages of [offset, offset + n) back to the file
+
+    bool sync( std::size_t offset, std::size_t n, std::error_code & ec ) const noexcept
+    {
+        ec.clear();
+
+        if( n_ == 0 || offset >= n_ )
+        {
+            return true;
+        }
+
+        if( n > n_ - offset )
+        {
+            n = n_ - offset;
+        }
+
+        std::size_t const page = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+        std::size_t const first = offset / page * page;
+
+        if( ::msync( p_ + first, offset + n - first, MS_SYNC ) != 0 )
+        {
+            ec = last_error();
+            return false;
+        }
+
+        return true;
+    }
+};
+
+#endif // defined(BOOST_ENDIAN_HAS_MMAP)
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_MAPPED_FILE_HPP_INCLUDED
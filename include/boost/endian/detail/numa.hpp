@@ -0,0 +1,225 @@
+#ifndef BOOST_ENDIAN_DETAIL_NUMA_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_NUMA_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Minimal NUMA topology queries for the parallel bulk functions, made with
+// raw system calls so that no library needs to be linked. Only Linux is
+// supported; elsewhere, and on single node machines, numa_node_count()
+// returns 1 and the parallel functions ignore the NUMA option.
+
+#include <cstddef>
+
+#if defined(__linux__) && !defined(BOOST_ENDIAN_NO_NUMA)
+# include <sched.h>
+# include <unistd.h>
+# include <sys/syscall.h>
+# include <cstdio>
+# if defined(SYS_move_pages) && defined(SYS_getcpu) && defined(CPU_SET)
+#  define BOOST_ENDIAN_HAS_NUMA
+# endif
+#endif
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+#if defined(BOOST_ENDIAN_HAS_NUMA)
+
+// Calls f( i ) for each number i in a sysfs list such as "0-3,8,10-11"
+
+template<class F> inline void numa_parse_list( char const * s, F f )
+{
+    while( *s >= '0' && *s <= '9' )
+    {
+        unsigned first = 0;
+
+        for( ; *s >= '0' && *s <= '9'; ++s )
+        {
+            first = first * 10 + static_cast<unsigned>( *s - '0' );
+        }
+
+        unsigned last = first;
+
+        if( *s == '-' )
+        {
+            last = 0;
+
+            for( ++s; *s >= '0' && *s <= '9'; ++s )
+            {
+                last = last * 10 + static_cast<unsigned>( *s - '0' );
+            }
+        }
+
+        for( unsigned i = first; i <= last; ++i )
+        {
+            f( i );
+        }
+
+        if( *s != ',' )
+        {
+            break;
+        }
+
+        ++s;
+    }
+}
+
+// Reads a sysfs list file; returns false if it cannot be read
+
+template<class F> inline bool numa_read_list( char const * path, F f )
+{
+    std::FILE * file = std::fopen( path, "r" );
+
+    if( file == 0 )
+    {
+        return false;
+    }
+
+    char buffer[ 1024 ];
+    bool r = std::fgets( buffer, sizeof(buffer), file ) != 0;
+
+    std::fclose( file );
+
+    if( r )
+    {
+        numa_parse_list( buffer, f );
+    }
+
+    return r;
+}
+
+struct numa_max_node
+{
+    unsigned * max_;
+
+    void operator()( unsigned i ) const
+    {
+        if( i + 1 > *max_ )
+        {
+            *max_ = i + 1;
+        }
+    }
+};
+
+// One more than the highest online node number
+
+inline unsigned numa_node_count()
+{
+    unsigned r = 0;
+    numa_read_list( "/sys/devices/system/node/online", numa_max_node{ &r } );
+    return r == 0? 1: r;
+}
+
+// The node of the CPU the calling thread runs on
+
+inline int numa_current_node() noexcept
+{
+    unsigned cpu = 0, node = 0;
+
+    if( syscall( SYS_getcpu, &cpu, &node, static_cast<void*>( 0 ) ) != 0 )
+    {
+        return -1;
+    }
+
+    return static_cast<int>( node );
+}
+
+struct numa_cpu_set
+{
+    cpu_set_t * set_;
+
+    void operator()( unsigned i ) const
+    {
+        if( i < CPU_SETSIZE )
+        {
+            CPU_SET( i, set_ );
+        }
+    }
+};
+
+// Restricts the calling thread to the CPUs of the given node
+
+inline bool numa_bind_current_thread( unsigned node )
+{
+    char path[ 64 ];
+    std::snprintf( path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node );
+
+    cpu_set_t set;
+    CPU_ZERO( &set );
+
+    if( !numa_read_list( path, numa_cpu_set{ &set } ) || CPU_COUNT( &set ) == 0 )
+    {
+        return false;
+    }
+
+    return sched_setaffinity( 0, sizeof(set), &set ) == 0;
+}
+
+// Stores in nodes[ i ] the node of the page containing pages[ i ], or -1
+// when it is unknown, e.g. because the page has not been touched yet
+
+inline void numa_page_nodes( void const * const * pages, int * nodes, std::size_t n ) noexcept
+{
+    if( n == 0 )
+    {
+        return;
+    }
+
+    if( syscall( SYS_move_pages, 0, static_cast<unsigned long>( n ), pages, static_cast<int const*>( 0 ), nodes, 0 ) != 0 )
+    {
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            nodes[ i ] = -1;
+        }
+
+        return;
+    }
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        if( nodes[ i ] < 0 )
+        {
+            nodes[ i ] = -1;
+        }
+    }
+}
+
+#else
+
+inline unsigned numa_node_count()
+{
+    return 1;
+}
+
+inline int numa_current_node() noexcept
+{
+    return -1;
+}
+
+inline bool numa_bind_current_thread( unsigned /*node*/ )
+{
+    return false;
+}
+
+inline void numa_page_nodes( void const * const * /*pages*/, int * nodes, std::size_t n ) noexcept
+{
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        nodes[ i ] = -1;
+    }
+}
+
+#endif
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_NUMA_HPP_INCLUDED
@@ -0,0 +1,434 @@
+#ifndef BOOST_ENDIAN_DETAIL_PARALLEL_FOR_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_PARALLEL_FOR_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/numa.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost
+{
+namespace endian
+{
+
+// How the parallel bulk functions in <boost/endian/parallel.hpp> split the work
+
+struct parallel_options
+{
+    // Number of workers, the calling thread included; 0 means
+    // std::thread::hardware_concurrency()
+
+    unsigned threads;
+
+    // Approximate size of one unit of work, in destination bytes; 0 selects
+    // the default. Chunk boundaries fall on 64-byte boundaries of the
+    // destination, so that no two workers write to the same cache line.
+
+    std::size_t chunk_bytes;
+
+    // Converts each chunk on a worker running on the NUMA node that holds the
+    // chunk's destination pages, when that is known. Linux only.
+
+    bool numa;
+
+    // When set, runs the additional workers by calling executor( task ), for
+    // example to post them to a thread pool; otherwise, they run on new
+    // std::threads. Each task must eventually be run.
+
+    std::function<void( std::function<void()> )> executor;
+
+    explicit parallel_options( unsigned threads = 0 ): threads( threads ), chunk_bytes( 0 ), numa( false )
+    {
+    }
+};
+
+namespace detail
+{
+
+// Splits n elements of `size` bytes, starting at `anchor`, into chunks of
+// about chunk_bytes each. All chunks but the first start 64-byte aligned, if
+// any element of the first 64 / gcd( size, 64 ) is.
+
+class parallel_chunks
+{
+private:
+
+    std::size_t n_;
+    std::size_t head_;
+    std::size_t step_;
+    std::size_t count_;
+
+public:
+
+    static std::size_t const default_chunk_bytes = 256 * 1024;
+
+    parallel_chunks( unsigned char const * anchor, std::size_t size, std::size_t n, std::size_t chunk_bytes ) noexcept: n_( n ), head_( 0 )
+    {
+        if( chunk_bytes == 0 )
+        {
+            chunk_bytes = default_chunk_bytes;
+        }
+
+        std::size_t g = 64;
+
+        for( std::size_t a = size % 64; a != 0; )
+        {
+            std::size_t t = g % a;
+            g = a;
+            a = t;
+        }
+
+        std::size_t const l = 64 / g; // elements in lcm( size, 64 ) bytes
+
+        step_ = ( chunk_bytes / size + l - 1 ) / l * l;
+
+        if( step_ == 0 )
+        {
+            step_ = l;
+        }
+
+        std::size_t const mis = reinterpret_cast<std::size_t>( anchor ) % 64;
+
+        for( std::size_t h = 0; h < l; ++h )
+        {
+            if( ( mis + h * size ) % 64 == 0 )
+            {
+                head_ = h;
+                break;
+            }
+        }
+
+        count_ = n_ <= head_ + step_? 1: ( n_ - head_ + step_ - 1 ) / step_;
+    }
+
+    std::size_t count() const noexcept
+    {
+        return count_;
+    }
+
+    std::size_t begin( std::size_t k ) const noexcept
+    {
+        return k == 0? 0: head_ + k * step_;
+    }
+
+    std::size_t end( std::size_t k ) const noexcept
+    {
+        return k + 1 == count_? n_: head_ + ( k + 1 ) * step_;
+    }
+};
+
+// Hands out chunks to the workers. The chunks are grouped by the node holding
+// their pages, one bucket per node plus one for unknown nodes; a worker takes
+// chunks from its own node's bucket, then from the unknown bucket, and then
+// helps with the other nodes, so that no worker idles while chunks remain.
+// Without NUMA there is a single bucket.
+
+class parallel_queue
+{
+private:
+
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> first_;
+    std::unique_ptr< std::atomic<std::size_t>[] > cursor_;
+    std::size_t buckets_;
+
+    bool take_from( std::size_t b, std::size_t & chunk ) noexcept
+    {
+        std::size_t const last = first_[ b + 1 ];
+
+        if( cursor_[ b ].load( std::memory_order_relaxed ) >= last )
+        {
+            return false;
+        }
+
+        std::size_t i = cursor_[ b ].fetch_add( 1, std::memory_order_relaxed );
+
+        if( i >= last )
+        {
+            return false;
+        }
+
+        chunk = order_[ i ];
+        return true;
+    }
+
+public:
+
+    parallel_queue( parallel_chunks const & chunks, unsigned nodes, unsigned char const * anchor, std::size_t size ): buckets_( nodes > 1? nodes + 1: 1 )
+    {
+        std::size_t const n = chunks.count();
+
+        order_.resize( n );
+        first_.assign( buckets_ + 1, 0 );
+
+        if( buckets_ == 1 )
+        {
+            for( std::size_t k = 0; k < n; ++k )
+            {
+                order_[ k ] = k;
+            }
+
+            first_[ 1 ] = n;
+        }
+        else
+        {
+            std::vector<void const*> pages( n );
+            std::vector<int> node( n );
+
+            for( std::size_t k = 0; k < n; ++k )
+            {
+                pages[ k ] = anchor + chunks.begin( k ) * size;
+            }
+
+            numa_page_nodes( pages.data(), node.data(), n );
+
+            std::vector<std::size_t> bucket( n );
+
+            for( std::size_t k = 0; k < n; ++k )
+            {
+                bucket[ k ] = node[ k ] >= 0 && static_cast<unsigned>( node[ k ] ) < nodes? static_cast<std::size_t>( node[ k ] ): nodes;
+                ++first_[ bucket[ k ] + 1 ];
+            }
+
+            for( std::size_t b = 0; b < buckets_; ++b )
+            {
+                first_[ b + 1 ] += first_[ b ];
+            }
+
+            std::vector<std::size_t> pos( first_.begin(), first_.end() - 1 );
+
+            for( std::size_t k = 0; k < n; ++k )
+            {
+                order_[ pos[ bucket[ k ] ]++ ] = k;
+            }
+        }
+
+        cursor_.reset( new std::atomic<std::size_t>[ buckets_ ] );
+
+        for( std::size_t b = 0; b < buckets_; ++b )
+        {
+            cursor_[ b ].store( first_[ b ], std::memory_order_relaxed );
+        }
+    }
+
+    std::size_t buckets() const noexcept
+    {
+        return buckets_;
+    }
+
+    // home is the worker's node, or -1
+
+    bool take( int home, std::size_t & chunk ) noexcept
+    {
+        if( buckets_ == 1 )
+        {
+            return take_from( 0, chunk );
+        }
+
+        std::size_t const nodes = buckets_ - 1;
+
+        if( home >= 0 && static_cast<std::size_t>( home ) < nodes && take_from( static_cast<std::size_t>( home ), chunk ) )
+        {
+            return true;
+        }
+
+        if( take_from( nodes, chunk ) )
+        {
+            return true;
+        }
+
+        std::size_t const start = home >= 0? static_cast<std::size_t>( home ): 0;
+
+        for( std::size_t i = 1; i <= nodes; ++i )
+        {
+            if( take_from( ( start + i ) % nodes, chunk ) )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+// Counts finished executor tasks
+
+class parallel_latch
+{
+private:
+
+    std::mutex mx_;
+    std::condition_variable cv_;
+    unsigned pending_;
+
+public:
+
+    parallel_latch(): pending_( 0 )
+    {
+    }
+
+    void add()
+    {
+        std::lock_guard<std::mutex> lock( mx_ );
+        ++pending_;
+    }
+
+    void done()
+    {
+        std::lock_guard<std::mutex> lock( mx_ );
+
+        if( --pending_ == 0 )
+        {
+            cv_.notify_all();
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock( mx_ );
+
+        while( pending_ != 0 )
+        {
+            cv_.wait( lock );
+        }
+    }
+};
+
+// Calls f( first, count ) on disjoint subranges covering [0, n), from up to
+// opt.threads threads. f must not throw. Failure to start a worker is not an
+// error; the remaining workers, the calling thread included, do its share.
+
+template<class F>
+inline void parallel_for( parallel_options const & opt, unsigned char const * anchor, std::size_t size, std::size_t n, F const & f )
+{
+    if( n == 0 )
+    {
+        return;
+    }
+
+    parallel_chunks const chunks( anchor, size, n, opt.chunk_bytes );
+
+    std::size_t workers = opt.threads != 0? opt.threads: std::thread::hardware_concurrency();
+
+    if( workers > chunks.count() )
+    {
+        workers = chunks.count();
+    }
+
+    if( workers <= 1 )
+    {
+        f( 0, n );
+        return;
+    }
+
+    unsigned const nodes = opt.numa? numa_node_count(): 1;
+
+    parallel_queue queue( chunks, nodes, anchor, size );
+
+    auto work = [&]( int home )
+    {
+        std::size_t k;
+
+        while( queue.take( home, k ) )
+        {
+            f( chunks.begin( k ), chunks.end( k ) - chunks.begin( k ) );
+        }
+    };
+
+    bool const numa = queue.buckets() > 1;
+
+    if( opt.executor )
+    {
+        parallel_latch latch;
+
+        for( std::size_t w = 1; w < workers; ++w )
+        {
+            latch.add();
+
+            // set by whichever comes first, the task or the handler of an
+            // exception from the executor; the task may have run inline, or
+            // been stored and still run after the executor throws
+
+            std::shared_ptr< std::atomic<bool> > started;
+
+            try
+            {
+                started = std::make_shared< std::atomic<bool> >( false );
+
+                opt.executor( [&, started]()
+                {
+                    if( started->exchange( true ) ) return;
+
+                    work( numa? numa_current_node(): -1 );
+                    latch.done();
+                });
+            }
+            catch( ... )
+            {
+                if( !started || !started->exchange( true ) )
+                {
+                    latch.done();
+                }
+
+                break;
+            }
+        }
+
+        work( numa? numa_current_node(): -1 );
+        latch.wait();
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        threads.reserve( workers - 1 );
+
+        for( std::size_t w = 1; w < workers; ++w )
+        {
+            try
+            {
+                // spread the workers we own over the nodes, round robin
+
+                unsigned const node = static_cast<unsigned>( w % nodes );
+
+                threads.emplace_back( [&, node]()
+                {
+                    int home = -1;
+
+                    if( numa && numa_bind_current_thread( node ) )
+                    {
+                        home = static_cast<int>( node );
+                    }
+
+                    work( home );
+                });
+            }
+            catch( ... )
+            {
+                break;
+            }
+        }
+
+        work( numa? numa_current_node(): -1 );
+
+        for( std::size_t i = 0; i < threads.size(); ++i )
+        {
+            threads[ i ].join();
+        }
+    }
+}
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_PARALLEL_FOR_HPP_INCLUDED
@@ -0,0 +1,493 @@
+#ifndef BOOST_ENDIAN_DETAIL_PIPELINE_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_PIPELINE_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// The stages of <boost/endian/pipeline.hpp>: a set of buffers, each read from
+// the source, converted, and written to the destination at the same offset,
+// with the reads and writes made either through an io_uring or by a reader
+// and a writer thread.
+
+#include <boost/endian/parallel.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/io_ring.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if ( defined(__unix__) || defined(__APPLE__) ) && !defined(BOOST_ENDIAN_NO_PIPELINE)
+# include <sys/types.h>
+# include <unistd.h>
+# include <cerrno>
+# define BOOST_ENDIAN_HAS_PIPELINE
+#endif
+
+namespace boost
+{
+namespace endian
+{
+
+// How pipeline_convert in <boost/endian/pipeline.hpp> buffers and converts
+
+struct pipeline_options
+{
+    // the size of each buffer, rounded down to a whole number of values
+    std::size_t buffer_bytes;
+
+    // the number of buffers in rotation; at least 2
+    unsigned buffers;
+
+    // the workers that convert a buffer
+    parallel_options parallel;
+
+    // uses io_uring where available; otherwise, pread and pwrite on threads
+    bool io_uring;
+
+    pipeline_options(): buffer_bytes( std::size_t( 4 ) << 20 ), buffers( 4 ), io_uring( true )
+    {
+    }
+};
+
+#if defined(BOOST_ENDIAN_HAS_PIPELINE)
+
+namespace detail
+{
+
+struct pipeline_buffer
+{
+    enum state_type { idle, reading, full, writing };
+
+    unsigned char * p;
+    uint64_t offset;
+    std::size_t size;
+
+    // the bytes read or written so far
+    std::size_t done;
+
+    state_type state;
+};
+
+struct pipeline_state
+{
+    int src;
+    int dst;
+    uint64_t size;
+    std::size_t buffer_bytes;
+
+    std::vector<pipeline_buffer> buffers;
+
+    uint64_t written;
+};
+
+// pread or pwrite the rest of b; returns 0 or an errno
+
+inline int pipeline_transfer( bool write, int fd, pipeline_buffer & b ) noexcept
+{
+    while( b.done < b.size )
+    {
+        ssize_t const r = write?
+            ::pwrite( fd, b.p + b.done, b.size - b.done, static_cast<off_t>( b.offset + b.done ) ):
+            ::pread( fd, b.p + b.done, b.size - b.done, static_cast<off_t>( b.offset + b.done ) );
+
+        if( r < 0 )
+        {
+            if( errno == EINTR ) continue;
+            return errno;
+        }
+
+        if( r == 0 )
+        {
+            // the file has become shorter
+            return EIO;
+        }
+
+        b.done += static_cast<std::size_t>( r );
+    }
+
+    return 0;
+}
+
+#if defined(BOOST_ENDIAN_HAS_IO_URING)
+
+// One thread drives the ring: it keeps a read queued for every idle buffer,
+// converts a full buffer while the kernel works on the others, and queues
+// its write. Returns 0 or an errno; `abandoned` is set when the operations
+// in flight could not be waited for, and the buffers must not be freed. R is
+// io_ring, or a type with its prepare, submit and complete.
+
+template<class R, class F> int pipeline_run_ring( R & ring, pipeline_state & s, F const & convert, bool & abandoned )
+{
+    uint64_t next = 0;
+    unsigned inflight = 0;
+
+    int error = 0;
+    std::exception_ptr ex;
+
+    std::size_t const n = s.buffers.size();
+
+    for( ;; )
+    {
+        for( std::size_t i = 0; i < n && error == 0 && next < s.size; ++i )
+        {
+            pipeline_buffer & b = s.buffers[ i ];
+
+            if( b.state == pipeline_buffer::idle )
+            {
+                b.offset = next;
+                b.size = s.size - next < s.buffer_bytes? static_cast<std::size_t>( s.size - next ): s.buffer_bytes;
+                b.done = 0;
+                b.state = pipeline_buffer::reading;
+
+                ring.prepare( false, s.src, b.p, b.size, b.offset, i );
+                ++inflight;
+
+                next += b.size;
+            }
+        }
+
+        // the full buffer that comes first in the file
+
+        std::size_t f = n;
+
+        for( std::size_t i = 0; i < n && error == 0; ++i )
+        {
+            if( s.buffers[ i ].state == pipeline_buffer::full && ( f == n || s.buffers[ i ].offset < s.buffers[ f ].offset ) )
+            {
+                f = i;
+            }
+        }
+
+        int e = 0;
+
+        if( f != n )
+        {
+            // start the queued reads and writes before converting
+
+            e = ring.submit();
+
+            if( e == 0 )
+            {
+                pipeline_buffer & b = s.buffers[ f ];
+
+                try
+                {
+                    convert( b.p, b.size );
+                }
+                catch( ... )
+                {
+                    ex = std::current_exception();
+                    error = ECANCELED;
+                }
+
+                b.state = pipeline_buffer::writing;
+                b.done = 0;
+
+                if( error == 0 )
+                {
+                    ring.prepare( true, s.dst, b.p, b.size, b.offset, f );
+                    ++inflight;
+                }
+                else
+                {
+                    b.state = pipeline_buffer::idle;
+                }
+            }
+        }
+        else if( inflight != 0 )
+        {
+            e = ring.submit( 1 );
+        }
+        else
+        {
+            break;
+        }
+
+        // EAGAIN and EBUSY leave the entries the kernel did not take queued,
+        // and f full, for the next pass, after the completions are reaped
+
+        bool const busy = e == EAGAIN || e == EBUSY;
+
+        if( e != 0 && !busy )
+        {
+            if( error == 0 )
+            {
+                error = e;
+            }
+
+            abandoned = inflight != 0;
+            return error;
+        }
+
+        unsigned long long i;
+        int res;
+
+        bool reaped = false;
+
+        while( ring.complete( i, res ) )
+        {
+            reaped = true;
+            --inflight;
+
+            pipeline_buffer & b = s.buffers[ static_cast<std::size_t>( i ) ];
+            bool const write = b.state == pipeline_buffer::writing;
+
+            if( res == -EINTR || res == -EAGAIN )
+            {
+                res = 0;
+            }
+            else if( res < 0 || ( res == 0 && b.done < b.size ) )
+            {
+                if( error == 0 )
+                {
+                    error = res < 0? -res: EIO;
+                }
+
+                b.state = pipeline_buffer::idle;
+                continue;
+            }
+
+            b.done += static_cast<std::size_t>( res );
+
+            if( b.done < b.size )
+            {
+                if( error == 0 )
+                {
+                    ring.prepare( write, write? s.dst: s.src, b.p + b.done, b.size - b.done, b.offset + b.done, i );
+                    ++inflight;
+                }
+                else
+                {
+                    b.state = pipeline_buffer::idle;
+                }
+            }
+            else if( write )
+            {
+                s.written += b.size;
+                b.state = pipeline_buffer::idle;
+            }
+            else
+            {
+                b.state = pipeline_buffer::full;
+            }
+        }
+
+        if( busy && !reaped )
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if( ex )
+    {
+        std::rethrow_exception( ex );
+    }
+
+    return error;
+}
+
+#endif // defined(BOOST_ENDIAN_HAS_IO_URING)
+
+// A reader thread fills the idle buffers in order, the calling thread
+// converts them, and a writer thread writes them and returns them to the
+// reader. Returns 0 or an errno.
+
+template<class F> int pipeline_run_threads( pipeline_state & s, F const & convert )
+{
+    std::mutex m;
+    std::condition_variable cv;
+
+    std::vector<std::size_t> idle, full, converted;
+
+    for( std::size_t i = 0; i < s.buffers.size(); ++i )
+    {
+        idle.push_back( s.buffers.size() - 1 - i );
+    }
+
+    bool read_done = false;
+    bool convert_done = false;
+
+    int error = 0;
+    std::exception_ptr ex;
+
+    auto reader = [&]()
+    {
+        for( uint64_t next = 0; next < s.size; )
+        {
+            std::size_t i;
+
+            {
+                std::unique_lock<std::mutex> lock( m );
+                cv.wait( lock, [&]{ return !idle.empty() || error != 0; } );
+
+                if( error != 0 ) break;
+
+                i = idle.back();
+                idle.pop_back();
+            }
+
+            pipeline_buffer & b = s.buffers[ i ];
+
+            b.offset = next;
+            b.size = s.size - next < s.buffer_bytes? static_cast<std::size_t>( s.size - next ): s.buffer_bytes;
+            b.done = 0;
+
+            next += b.size;
+
+            int const e = pipeline_transfer( false, s.src, b );
+
+            std::lock_guard<std::mutex> lock( m );
+
+            if( e != 0 )
+            {
+                if( error == 0 ) error = e;
+                break;
+            }
+
+            full.insert( full.begin(), i );
+            cv.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock( m );
+
+        read_done = true;
+        cv.notify_all();
+    };
+
+    auto writer = [&]()
+    {
+        for( ;; )
+        {
+            std::size_t i;
+
+            {
+                std::unique_lock<std::mutex> lock( m );
+                cv.wait( lock, [&]{ return !converted.empty() || error != 0 || convert_done; } );
+
+                if( error != 0 || converted.empty() ) break;
+
+                i = converted.back();
+                converted.pop_back();
+            }
+
+            pipeline_buffer & b = s.buffers[ i ];
+
+            b.done = 0;
+
+            int const e = pipeline_transfer( true, s.dst, b );
+
+            std::lock_guard<std::mutex> lock( m );
+
+            if( e != 0 )
+            {
+                if( error == 0 ) error = e;
+                cv.notify_all();
+                break;
+            }
+
+            s.written += b.size;
+
+            idle.push_back( i );
+            cv.notify_all();
+        }
+    };
+
+    std::thread tr( reader );
+    std::thread tw;
+
+    try
+    {
+        tw = std::thread( writer );
+    }
+    catch( ... )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m );
+            error = ECANCELED;
+            cv.notify_all();
+        }
+
+        tr.join();
+        throw;
+    }
+
+    for( ;; )
+    {
+        std::size_t i;
+
+        {
+            std::unique_lock<std::mutex> lock( m );
+            cv.wait( lock, [&]{ return !full.empty() || error != 0 || read_done; } );
+
+            if( error != 0 || full.empty() ) break;
+
+            i = full.back();
+            full.pop_back();
+        }
+
+        pipeline_buffer & b = s.buffers[ i ];
+
+        try
+        {
+            convert( b.p, b.size );
+        }
+        catch( ... )
+        {
+            ex = std::current_exception();
+
+            std::lock_guard<std::mutex> lock( m );
+
+            if( error == 0 ) error = ECANCELED;
+            cv.notify_all();
+
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock( m );
+
+        converted.insert( converted.begin(), i );
+        cv.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( m );
+
+        convert_done = true;
+        cv.notify_all();
+    }
+
+    tr.join();
+    tw.join();
+
+    if( ex )
+    {
+        std::rethrow_exception( ex );
+    }
+
+    return error;
+}
+
+template<enum order From, enum order To, class T> struct pipeline_converter
+{
+    parallel_options const * opt;
+
+    void operator()( unsigned char * p, std::size_t n ) const
+    {
+        boost::endian::conditional_reverse_inplace_n<From, To>( *opt, reinterpret_cast<T*>( p ), n / sizeof(T) );
+    }
+};
+
+} // namespace detail
+
+#endif // defined(BOOST_ENDIAN_HAS_PIPELINE)
+
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_PIPELINE_HPP_INCLUDED
@@ -0,0 +1,41 @@
+#ifndef BOOST_ENDIAN_DETAIL_PREFETCH_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_PREFETCH_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/simd.hpp>
+
+namespace boost
+{
+namespace endian
+{
+namespace detail
+{
+
+// a hint to fetch the cache line at p; it never faults
+
+inline void prefetch( unsigned char const * p ) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+
+    __builtin_prefetch( p );
+
+#elif defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    _mm_prefetch( reinterpret_cast<char const*>( p ), _MM_HINT_T0 );
+
+#else
+
+    (void)p;
+
+#endif
+}
+
+} // namespace detail
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_PREFETCH_HPP_INCLUDED
@@ -0,0 +1,128 @@
+#ifndef BOOST_ENDIAN_DETAIL_SIMD_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_SIMD_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/intrinsic.hpp>
+
+//  Vector instruction sets used by the bulk (pointer + count) kernels.
+//
+//  BOOST_ENDIAN_SIMD_SSSE3, _AVX2 and _AVX512 are defined when the kernels for
+//  that instruction set are compiled in. When the compiler can generate code for
+//  instruction sets that are not enabled on the command line (GCC 4.9+, Clang
+//  3.8+ and MSVC on x86), all kernels are compiled and BOOST_ENDIAN_SIMD_DISPATCH
+//  is defined: the widest kernel supported by the CPU is then selected at run
+//  time, see detail/simd_dispatch.hpp. The AVX-512 kernels are left out of the
+//  selection with compilers older than GCC 5 and Clang 3.9. Otherwise only the instruction sets enabled at
+//  compile time (-mssse3, -mavx2, /arch:AVX2, ...) are used.
+//
+//  Define BOOST_ENDIAN_NO_SIMD_DISPATCH to disable run time selection, and
+//  BOOST_ENDIAN_NO_SIMD to fall back to the scalar kernels;
+//  BOOST_ENDIAN_NO_INTRINSICS implies BOOST_ENDIAN_NO_SIMD.
+
+#if defined(BOOST_ENDIAN_NO_INTRINSICS) && !defined(BOOST_ENDIAN_NO_SIMD)
+# define BOOST_ENDIAN_NO_SIMD
+#endif
+
+#if !defined(BOOST_ENDIAN_NO_SIMD)
+
+# if defined(__SSSE3__) || defined(__AVX__)
+#  define BOOST_ENDIAN_SIMD_SSSE3
+# endif
+
+# if defined(__AVX2__)
+#  define BOOST_ENDIAN_SIMD_AVX2
+# endif
+
+# if defined(__AVX512BW__)
+#  define BOOST_ENDIAN_SIMD_AVX512
+# endif
+
+# if !defined(BOOST_ENDIAN_SIMD_AVX512) && !defined(BOOST_ENDIAN_NO_SIMD_DISPATCH)
+
+//  The target attribute, and the AVX2 intrinsics under it, need GCC 4.9 or
+//  Clang 3.8; AVX-512BW needs GCC 5 or Clang 3.9. Apple numbers its Clang
+//  releases differently; Xcode 8 has both.
+
+#  if defined(__clang__) && defined(__apple_build_version__)
+#   define BOOST_ENDIAN_TARGET_AVX2_OK ( __clang_major__ >= 8 )
+#   define BOOST_ENDIAN_TARGET_AVX512_OK ( __clang_major__ >= 8 )
+#  elif defined(__clang__)
+#   define BOOST_ENDIAN_TARGET_AVX2_OK ( __clang_major__ > 3 || ( __clang_major__ == 3 && __clang_minor__ >= 8 ) )
+#   define BOOST_ENDIAN_TARGET_AVX512_OK ( __clang_major__ > 3 || ( __clang_major__ == 3 && __clang_minor__ >= 9 ) )
+#  elif defined(__GNUC__)
+#   define BOOST_ENDIAN_TARGET_AVX2_OK ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) )
+#   define BOOST_ENDIAN_TARGET_AVX512_OK ( __GNUC__ >= 5 )
+#  else
+#   define BOOST_ENDIAN_TARGET_AVX2_OK 0
+#   define BOOST_ENDIAN_TARGET_AVX512_OK 0
+#  endif
+
+#  if ( defined(__x86_64__) || defined(__i386__) ) && BOOST_ENDIAN_TARGET_AVX2_OK
+
+#   define BOOST_ENDIAN_SIMD_DISPATCH
+#   define BOOST_ENDIAN_TARGET_SSSE3 __attribute__((target("ssse3")))
+#   define BOOST_ENDIAN_TARGET_AVX2 __attribute__((target("avx2")))
+
+#   if BOOST_ENDIAN_TARGET_AVX512_OK
+#    define BOOST_ENDIAN_SIMD_DISPATCH_AVX512
+#    define BOOST_ENDIAN_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#   endif
+
+#  elif defined(_MSC_VER) && !defined(__clang__) && ( defined(_M_X64) || defined(_M_IX86) ) && _MSC_VER >= 1911
+
+#   define BOOST_ENDIAN_SIMD_DISPATCH
+#   define BOOST_ENDIAN_SIMD_DISPATCH_AVX512
+
+#  endif
+
+#  undef BOOST_ENDIAN_TARGET_AVX2_OK
+#  undef BOOST_ENDIAN_TARGET_AVX512_OK
+
+# endif
+
+# if defined(BOOST_ENDIAN_SIMD_DISPATCH)
+#  if !defined(BOOST_ENDIAN_SIMD_SSSE3)
+#   define BOOST_ENDIAN_SIMD_SSSE3
+#  endif
+#  if !defined(BOOST_ENDIAN_SIMD_AVX2)
+#   define BOOST_ENDIAN_SIMD_AVX2
+#  endif
+#  if defined(BOOST_ENDIAN_SIMD_DISPATCH_AVX512)
+#   define BOOST_ENDIAN_SIMD_AVX512
+#  endif
+# endif
+
+#endif
+
+#if !defined(BOOST_ENDIAN_TARGET_SSSE3)
+# define BOOST_ENDIAN_TARGET_SSSE3
+# define BOOST_ENDIAN_TARGET_AVX2
+#endif
+
+#if !defined(BOOST_ENDIAN_TARGET_AVX512)
+# define BOOST_ENDIAN_TARGET_AVX512
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3) || defined(BOOST_ENDIAN_SIMD_AVX2) || defined(BOOST_ENDIAN_SIMD_AVX512)
+# include <immintrin.h>
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_DISPATCH) && defined(BOOST_ENDIAN_SIMD_AVX512)
+# define BOOST_ENDIAN_SIMD_MSG "run time selection of SSSE3, AVX2, AVX-512BW"
+#elif defined(BOOST_ENDIAN_SIMD_DISPATCH)
+# define BOOST_ENDIAN_SIMD_MSG "run time selection of SSSE3, AVX2"
+#elif defined(BOOST_ENDIAN_SIMD_AVX512)
+# define BOOST_ENDIAN_SIMD_MSG "AVX-512BW"
+#elif defined(BOOST_ENDIAN_SIMD_AVX2)
+# define BOOST_ENDIAN_SIMD_MSG "AVX2"
+#elif defined(BOOST_ENDIAN_SIMD_SSSE3)
+# define BOOST_ENDIAN_SIMD_MSG "SSSE3"
+#else
+# define BOOST_ENDIAN_SIMD_MSG "no SIMD"
+#endif
+
+#endif  // BOOST_ENDIAN_DETAIL_SIMD_HPP_INCLUDED
@@ -0,0 +1,316 @@
+#ifndef BOOST_ENDIAN_DETAIL_SIMD_DISPATCH_HPP_INCLUDED
+#define BOOST_ENDIAN_DETAIL_SIMD_DISPATCH_HPP_INCLUDED
+
+// Copyright 2021 Zachary Lund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/simd.hpp>
+#include <atomic>
+
+#if defined(BOOST_ENDIAN_SIMD_DISPATCH)
+# if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+# else
+#  include <cpuid.h>
+# endif
+#endif
+
+namespace boost
+{
+namespace endian
+{
+
+// Instruction set used by the bulk kernels
+
+enum class simd_level
+{
+    none,
+    ssse3,
+    avx2,
+    avx512
+};
+
+namespace detail
+{
+
+inline simd_level simd_compiled_level() noexcept
+{
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    return simd_level::avx512;
+
+#elif defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    return simd_level::avx2;
+
+#elif defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    return simd_level::ssse3;
+
+#else
+
+    return simd_level::none;
+
+#endif
+}
+
+#if defined(BOOST_ENDIAN_SIMD_DISPATCH)
+
+inline void simd_cpuid( unsigned leaf, unsigned subleaf, unsigned r[ 4 ] ) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+
+    int tmp[ 4 ];
+    __cpuidex( tmp, static_cast<int>( leaf ), static_cast<int>( subleaf ) );
+
+    for( int i = 0; i < 4; ++i )
+    {
+        r[ i ] = static_cast<unsigned>( tmp[ i ] );
+    }
+
+#else
+
+    __cpuid_count( leaf, subleaf, r[0], r[1], r[2], r[3] );
+
+#endif
+}
+
+inline unsigned long long simd_xgetbv() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+
+    return _xgetbv( 0 );
+
+#else
+
+    unsigned eax, edx;
+    __asm__ __volatile__( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+    return ( static_cast<unsigned long long>( edx ) << 32 ) | eax;
+
+#endif
+}
+
+// Queries CPUID, and XCR0 for the register state the OS saves on context switch
+
+inline simd_level simd_detect_level() noexcept
+{
+    unsigned r[ 4 ];
+
+    simd_cpuid( 0, 0, r );
+    unsigned const max_leaf = r[ 0 ];
+
+    if( max_leaf < 1 )
+    {
+        return simd_level::none;
+    }
+
+    simd_cpuid( 1, 0, r );
+
+    bool const ssse3 = ( r[2] >> 9 ) & 1;
+    bool const osxsave = ( r[2] >> 27 ) & 1;
+    bool const avx = ( r[2] >> 28 ) & 1;
+
+    if( !ssse3 )
+    {
+        return simd_level::none;
+    }
+
+    if( !osxsave || !avx || max_leaf < 7 )
+    {
+        return simd_level::ssse3;
+    }
+
+    unsigned long long const xcr0 = simd_xgetbv();
+
+    if( ( xcr0 & 0x06 ) != 0x06 )
+    {
+        return simd_level::ssse3;
+    }
+
+    simd_cpuid( 7, 0, r );
+
+    bool const avx2 = ( r[1] >> 5 ) & 1;
+    bool const avx512f = ( r[1] >> 16 ) & 1;
+    bool const avx512bw = ( r[1] >> 30 ) & 1;
+
+    if( !avx2 )
+    {
+        return simd_level::ssse3;
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    if( avx512f && avx512bw && ( xcr0 & 0xE6 ) == 0xE6 )
+    {
+        return simd_level::avx512;
+    }
+
+#else
+
+    (void)avx512f;
+    (void)avx512bw;
+
+#endif
+
+    return simd_level::avx2;
+}
+
+#else
+
+inline simd_level simd_detect_level() noexcept
+{
+    return simd_compiled_level();
+}
+
+#endif
+
+struct simd_dispatch_state
+{
+    simd_level detected;
+    std::atomic<int> active;
+
+    simd_dispatch_state() noexcept: detected( simd_detect_level() ), active( static_cast<int>( detected ) )
+    {
+    }
+};
+
+// The state is a function-local static of an inline function, so there is one
+// instance per program and CPUID runs once, on first use
+
+inline simd_dispatch_state & simd_dispatch() noexcept
+{
+    static simd_dispatch_state state;
+    return state;
+}
+
+inline simd_level simd_active_level() noexcept
+{
+    return static_cast<simd_level>( simd_dispatch().active.load( std::memory_order_relaxed ) );
+}
+
+// Calls K::avx512, K::avx2, K::ssse3 or K::scalar with the given arguments,
+// according to the active level; K provides the members for the compiled
+// instruction sets
+
+template<class K, class... A> inline void simd_invoke( A... a ) noexcept
+{
+#if defined(BOOST_ENDIAN_SIMD_DISPATCH)
+
+    switch( simd_active_level() )
+    {
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    case simd_level::avx512:
+
+        K::avx512( a... );
+        break;
+
+#endif
+
+    case simd_level::avx2:
+
+        K::avx2( a... );
+        break;
+
+    case simd_level::ssse3:
+
+        K::ssse3( a... );
+        break;
+
+    default:
+
+        K::scalar( a... );
+        break;
+    }
+
+#elif defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    K::avx512( a... );
+
+#elif defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    K::avx2( a... );
+
+#elif defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    K::ssse3( a... );
+
+#else
+
+    K::scalar( a... );
+
+#endif
+}
+
+} // namespace detail
+
+// Probes the CPU, if that has not happened yet. Calling it at startup keeps
+// the probe out of the first bulk conversion.
+
+inline void init_simd_dispatch() noexcept
+{
+    detail::simd_dispatch();
+}
+
+// The widest instruction set supported by both the library build and the CPU
+
+inline simd_level simd_supported_level() noexcept
+{
+    return detail::simd_dispatch().detected;
+}
+
+// The instruction set the bulk kernels currently use
+
+inline simd_level simd_dispatch_level() noexcept
+{
+    return detail::simd_active_level();
+}
+
+inline char const * simd_level_name( simd_level level ) noexcept
+{
+    switch( level )
+    {
+    case simd_level::ssse3: return "SSSE3";
+    case simd_level::avx2: return "AVX2";
+    case simd_level::avx512: return "AVX-512BW";
+    default: return "scalar";
+    }
+}
+
+inline char const * simd_dispatch_name() noexcept
+{
+    return boost::endian::simd_level_name( boost::endian::simd_dispatch_level() );
+}
+
+// Restricts the bulk kernels to at most the given instruction set, e.g. for
+// testing or benchmarking. Has no effect without BOOST_ENDIAN_SIMD_DISPATCH.
+// Returns the level now in effect.
+
+inline simd_level set_simd_dispatch_level( simd_level level ) noexcept
+{
+#if defined(BOOST_ENDIAN_SIMD_DISPATCH)
+
+    detail::simd_dispatch_state & st = detail::simd_dispatch();
+
+    if( static_cast<int>( level ) > static_cast<int>( st.detected ) )
+    {
+        level = st.detected;
+    }
+
+    st.active.store( static_cast<int>( level ), std::memory_order_relaxed );
+    return level;
+
+#else
+
+    (void)level;
+    return detail::simd_active_level();
+
+#endif
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif  // BOOST_ENDIAN_DETAIL_SIMD_DISPATCH_HPP_INCLUDED
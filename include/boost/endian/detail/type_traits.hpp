@@ -12,6 +12,8 @@
 # include <boost/type_traits/is_signed.hpp>
 # include <boost/type_traits/is_integral.hpp>
 # include <boost/type_traits/is_enum.hpp>
+# include <boost/type_traits/is_const.hpp>
+# include <boost/type_traits/remove_const.hpp>
 #endif
 
 namespace boost
@@ -33,6 +35,8 @@ template<typename T, T v> struct integral_constant: std::integral_constant<T, v>
 template<bool B, typename T, typename F> struct conditional: std::conditional<B, T, F>{};
 template<typename T, typename U> struct is_same: std::is_same<T, U>{};
 template<bool B, typename T = void> struct enable_if: std::enable_if<B, T>{};
+template<typename T> struct is_const: std::is_const<T>{};
+template<typename T> struct remove_const: std::remove_const<T>{};
 typedef std::false_type false_type;
 typedef std::true_type true_type;
 #else
@@ -47,6 +51,8 @@ template<bool B, typename T, typename F> struct conditional: boost::conditional<
 template<typename T, typename U> struct is_same: boost::is_same<T, U>{};
 template<bool B, typename T = void> struct enable_if: boost::enable_if<B, T>{};
 template<typename T> struct is_class: boost::is_class<T>{};
+template<typename T> struct is_const: boost::is_const<T>{};
+template<typename T> struct remove_const: boost::remove_const<T>{};
 typedef boost::false_type false_type;
 typedef boost::true_type true_type;
 #endif
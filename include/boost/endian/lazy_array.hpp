@@ -0,0 +1,334 @@
+//  boost/endian/lazy_array.hpp  -------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_LAZY_ARRAY_HPP
+#define BOOST_ENDIAN_LAZY_ARRAY_HPP
+
+#include <boost/endian/span.hpp>
+#include <boost/endian/detail/mapped_file.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <system_error>
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  A native copy of an array of values of n_bits / 8 bytes each in Order, made
+  //  a page at a time: the first access to a page of the copy converts the page
+  //  from the source with endian_load_n, and later accesses read native values.
+  //  The cost of a query is that of the pages it touches, however large the
+  //  source. The source is an endian_span over memory the caller keeps alive or,
+  //  where BOOST_ENDIAN_HAS_MMAP is defined, a file mapped read-only.
+  //
+  //  Accesses convert pages and are not safe to make from several threads at
+  //  once; the source must not change while its pages are converted, and after
+  //  it changes, reset() discards the copy.
+
+  template <enum order Order, class T, std::size_t n_bits = sizeof(T) * CHAR_BIT>
+    class lazy_native_array;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+//  lazy_native_array  -----------------------------------------------------------------//
+
+template< enum order Order, class T, std::size_t n_bits >
+class lazy_native_array
+{
+public:
+
+    typedef endian_span<Order, T const, n_bits> span_type;
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    static const std::size_t element_size = span_type::element_size;
+
+    // the values converted together: 4 KB of the native copy
+
+    static const std::size_t page_size = 4096 / sizeof(T) != 0? 4096 / sizeof(T): 1;
+
+private:
+
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_const<T>::value );
+
+    span_type src_;
+
+#if defined(BOOST_ENDIAN_HAS_MMAP)
+
+    detail::mapped_file file_;
+
+#endif
+
+    // the copy is allocated but not initialized, so that the memory of
+    // the pages that are never converted is not touched
+
+    std::unique_ptr<T[]> copy_;
+
+    // bit k % 64 of converted_[ k / 64 ] is set when page k is converted
+
+    std::unique_ptr<detail::uint64_t[]> converted_;
+    size_type converted_count_;
+
+    static size_type pages( size_type n ) noexcept
+    {
+        return ( n + page_size - 1 ) / page_size;
+    }
+
+    bool is_page_converted( size_type k ) const noexcept
+    {
+        return ( converted_[ k / 64 ] >> k % 64 ) & 1;
+    }
+
+    // converts the pages in [first, last) that are not converted yet, with
+    // one bulk conversion for each run of consecutive pages
+
+    void convert( size_type first, size_type last ) noexcept
+    {
+        size_type const n = src_.size();
+
+        for( size_type k = first; k < last; )
+        {
+            if( is_page_converted( k ) )
+            {
+                ++k;
+                continue;
+            }
+
+            size_type j = k;
+
+            for( ; j < last && !is_page_converted( j ); ++j )
+            {
+                converted_[ j / 64 ] |= detail::uint64_t( 1 ) << j % 64;
+            }
+
+            size_type const i = k * page_size;
+            size_type const m = ( j * page_size < n? j * page_size: n ) - i;
+
+            boost::endian::endian_load_n<T, element_size, Order>( src_.data() + i * element_size, copy_.get() + i, m );
+
+            converted_count_ += j - k;
+            k = j;
+        }
+    }
+
+    bool allocate( std::error_code & ec ) noexcept
+    {
+        size_type const n = src_.size();
+        size_type const w = ( pages( n ) + 63 ) / 64;
+
+        copy_.reset( n != 0? new( std::nothrow ) T[ n ]: 0 );
+        converted_.reset( w != 0? new( std::nothrow ) detail::uint64_t[ w ](): 0 );
+        converted_count_ = 0;
+
+        if( ( n != 0 && !copy_ ) || ( w != 0 && !converted_ ) )
+        {
+            copy_.reset();
+            converted_.reset();
+            src_ = span_type();
+
+            ec = std::make_error_code( std::errc::not_enough_memory );
+            return false;
+        }
+
+        return true;
+    }
+
+public:
+
+    lazy_native_array() noexcept: converted_count_( 0 )
+    {
+    }
+
+    // throws std::bad_alloc
+
+    explicit lazy_native_array( span_type s ): converted_count_( 0 )
+    {
+        assign( s );
+    }
+
+    // a view of s; s must remain valid while the array refers to it
+
+    void assign( span_type s )
+    {
+        std::error_code ec;
+
+        if( !assign( s, ec ) )
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    bool assign( span_type s, std::error_code & ec ) noexcept
+    {
+        close();
+        ec.clear();
+
+        src_ = s;
+        return allocate( ec );
+    }
+
+#if defined(BOOST_ENDIAN_HAS_MMAP)
+
+    // throws std::system_error
+
+    explicit lazy_native_array( char const * path ): converted_count_( 0 )
+    {
+        open( path );
+    }
+
+    lazy_native_array( char const * path, std::error_code & ec ) noexcept: converted_count_( 0 )
+    {
+        open( path, ec );
+    }
+
+    // maps the file read-only, as mapped_endian_array<Order, T const, n_bits>
+
+    void open( char const * path )
+    {
+        std::error_code ec;
+
+        if( !open( path, ec ) )
+        {
+            throw std::system_error( ec, "lazy_native_array::open" );
+        }
+    }
+
+    bool open( char const * path, std::error_code & ec ) noexcept
+    {
+        close();
+
+        if( !file_.open( path, false, ec ) )
+        {
+            return false;
+        }
+
+        src_ = span_type( file_.data(), file_.size() / element_size );
+
+        if( !allocate( ec ) )
+        {
+            file_.close();
+            return false;
+        }
+
+        return true;
+    }
+
+#endif
+
+    void close() noexcept
+    {
+        src_ = span_type();
+
+        copy_.reset();
+        converted_.reset();
+        converted_count_ = 0;
+
+#if defined(BOOST_ENDIAN_HAS_MMAP)
+
+        file_.close();
+
+#endif
+    }
+
+    // observers
+
+    span_type source() const noexcept
+    {
+        return src_;
+    }
+
+    size_type size() const noexcept
+    {
+        return src_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return src_.empty();
+    }
+
+    size_type page_count() const noexcept
+    {
+        return pages( size() );
+    }
+
+    size_type converted_pages() const noexcept
+    {
+        return converted_count_;
+    }
+
+    bool is_converted( size_type i ) const noexcept
+    {
+        return is_page_converted( i / page_size );
+    }
+
+    // element access; converts the page of i on its first access
+
+    value_type const & operator[]( size_type i ) noexcept
+    {
+        size_type const k = i / page_size;
+
+        if( !is_page_converted( k ) )
+        {
+            convert( k, k + 1 );
+        }
+
+        return copy_[ i ];
+    }
+
+    // count consecutive values from first, converting the pages they span
+
+    value_type const * data( size_type first, size_type count ) noexcept
+    {
+        if( count != 0 )
+        {
+            convert( first / page_size, ( first + count - 1 ) / page_size + 1 );
+        }
+
+        return copy_.get() + first;
+    }
+
+    // forgets the converted pages, so that they are converted again from
+    // the source on their next access
+
+    void reset() noexcept
+    {
+        size_type const w = ( page_count() + 63 ) / 64;
+
+        for( size_type i = 0; i < w; ++i )
+        {
+            converted_[ i ] = 0;
+        }
+
+        converted_count_ = 0;
+    }
+};
+
+template< enum order Order, class T, std::size_t n_bits >
+const std::size_t lazy_native_array<Order, T, n_bits>::element_size;
+
+template< enum order Order, class T, std::size_t n_bits >
+const std::size_t lazy_native_array<Order, T, n_bits>::page_size;
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_LAZY_ARRAY_HPP
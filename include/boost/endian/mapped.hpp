@@ -0,0 +1,198 @@
+//  boost/endian/mapped.hpp  -----------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_MAPPED_HPP
+#define BOOST_ENDIAN_MAPPED_HPP
+
+#include <boost/endian/span.hpp>
+#include <boost/endian/detail/mapped_file.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <climits>
+#include <cstddef>
+#include <system_error>
+
+#if defined(BOOST_ENDIAN_HAS_MMAP)
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  A file of values of n_bits / 8 bytes each in Order, mapped into memory and
+  //  accessed in place as an endian_span: opening it reads nothing, and the pages
+  //  are read from the file as they are touched. When T is const the file is
+  //  opened and mapped read-only; otherwise writes go to the file. Trailing bytes
+  //  that do not make a whole value are not part of the array.
+  //
+  //  Available where BOOST_ENDIAN_HAS_MMAP is defined (POSIX systems).
+
+  template <enum order Order, class T, std::size_t n_bits = sizeof(T) * CHAR_BIT>
+    class mapped_endian_array;
+
+  template <class T, std::size_t n_bits = sizeof(T) * CHAR_BIT>
+    using mapped_big_array = mapped_endian_array<order::big, T, n_bits>;
+  template <class T, std::size_t n_bits = sizeof(T) * CHAR_BIT>
+    using mapped_little_array = mapped_endian_array<order::little, T, n_bits>;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+//  mapped_endian_array  ---------------------------------------------------------------//
+
+template< enum order Order, class T, std::size_t n_bits >
+class mapped_endian_array
+{
+public:
+
+    typedef endian_span<Order, T, n_bits> span_type;
+
+    typedef typename span_type::value_type value_type;
+    typedef typename span_type::reference reference;
+    typedef typename span_type::size_type size_type;
+    typedef typename span_type::iterator iterator;
+    typedef typename span_type::const_iterator const_iterator;
+
+    static const std::size_t element_size = span_type::element_size;
+
+private:
+
+    detail::mapped_file file_;
+
+public:
+
+    mapped_endian_array() noexcept
+    {
+    }
+
+    // throws std::system_error
+
+    explicit mapped_endian_array( char const * path )
+    {
+        open( path );
+    }
+
+    mapped_endian_array( char const * path, std::error_code & ec ) noexcept
+    {
+        open( path, ec );
+    }
+
+    // opening and closing
+
+    void open( char const * path )
+    {
+        std::error_code ec;
+
+        if( !open( path, ec ) )
+        {
+            throw std::system_error( ec, "mapped_endian_array::open" );
+        }
+    }
+
+    bool open( char const * path, std::error_code & ec ) noexcept
+    {
+        return file_.open( path, !detail::is_const<T>::value, ec );
+    }
+
+    void close() noexcept
+    {
+        file_.close();
+    }
+
+    bool is_open() const noexcept
+    {
+        return file_.is_open();
+    }
+
+    // observers
+
+    span_type span() const noexcept
+    {
+        return span_type( file_.data(), size() );
+    }
+
+    typename span_type::byte_type * data() const noexcept
+    {
+        return file_.data();
+    }
+
+    size_type size() const noexcept
+    {
+        return file_.size() / element_size;
+    }
+
+    size_type size_bytes() const noexcept
+    {
+        return size() * element_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // element access
+
+    reference operator[]( size_type i ) const noexcept
+    {
+        return span()[ i ];
+    }
+
+    iterator begin() const noexcept
+    {
+        return span().begin();
+    }
+
+    iterator end() const noexcept
+    {
+        return span().end();
+    }
+
+    // paging hints, for the whole array or for count elements from first
+
+    bool advise( map_advice a ) const noexcept
+    {
+        return file_.advise( 0, file_.size(), a );
+    }
+
+    bool advise( map_advice a, size_type first, size_type count ) const noexcept
+    {
+        return file_.advise( first * element_size, count * element_size, a );
+    }
+
+    // writes the modified pages back to the file
+
+    bool flush( std::error_code & ec ) const noexcept
+    {
+        return file_.sync( 0, file_.size(), ec );
+    }
+
+    void flush() const
+    {
+        std::error_code ec;
+
+        if( !flush( ec ) )
+        {
+            throw std::system_error( ec, "mapped_endian_array::flush" );
+        }
+    }
+};
+
+template< enum order Order, class T, std::size_t n_bits >
+const std::size_t mapped_endian_array<Order, T, n_bits>::element_size;
+
+} // namespace endian
+} // namespace boost
+
+#endif // defined(BOOST_ENDIAN_HAS_MMAP)
+
+#endif // BOOST_ENDIAN_MAPPED_HPP
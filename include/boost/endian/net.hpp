@@ -0,0 +1,435 @@
+//  boost/endian/net.hpp  --------------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_NET_HPP
+#define BOOST_ENDIAN_NET_HPP
+
+#include <boost/endian/bitfield.hpp>
+#include <boost/endian/buffers.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/prefetch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <cstddef>
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+namespace net
+{
+
+  //  Ethernet, 802.1Q VLAN, IPv4, IPv6, UDP and TCP headers, as structs of big
+  //  endian buffers. Each struct has the size and field offsets of the wire format
+  //  (checked at compile time) and an alignment of 1, so that a header may be read
+  //  in place from any address:
+  //
+  //    ipv4_header const & h = *reinterpret_cast<ipv4_header const*>( p + 14 );
+  //
+  //  Fields that are not whole bytes are read by member functions.
+
+  struct ethernet_header;
+  struct vlan_tag;
+  struct ipv4_header;
+  struct ipv6_header;
+  struct udp_header;
+  struct tcp_header;
+
+  //  The headers of up to 64 packets, parsed by parse_burst into one native array
+  //  per field.
+
+  struct packet_burst;
+
+  std::size_t parse_burst( unsigned char const * const * packets,
+    std::size_t const * lengths, std::size_t n, packet_burst & burst ) noexcept;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+// EtherType values
+
+namespace ether_type
+{
+
+const endian::detail::uint16_t ipv4 = 0x0800;
+const endian::detail::uint16_t arp = 0x0806;
+const endian::detail::uint16_t vlan = 0x8100;
+const endian::detail::uint16_t ipv6 = 0x86DD;
+const endian::detail::uint16_t qinq = 0x88A8;
+
+} // namespace ether_type
+
+// IPv4 protocol and IPv6 next header values
+
+namespace ip_protocol
+{
+
+const endian::detail::uint8_t icmp = 1;
+const endian::detail::uint8_t tcp = 6;
+const endian::detail::uint8_t udp = 17;
+const endian::detail::uint8_t icmpv6 = 58;
+
+} // namespace ip_protocol
+
+// the bits of tcp_header::flags()
+
+namespace tcp_flags
+{
+
+const endian::detail::uint16_t fin = 0x001;
+const endian::detail::uint16_t syn = 0x002;
+const endian::detail::uint16_t rst = 0x004;
+const endian::detail::uint16_t psh = 0x008;
+const endian::detail::uint16_t ack = 0x010;
+const endian::detail::uint16_t urg = 0x020;
+const endian::detail::uint16_t ece = 0x040;
+const endian::detail::uint16_t cwr = 0x080;
+const endian::detail::uint16_t ns = 0x100;
+
+} // namespace tcp_flags
+
+struct ethernet_header
+{
+    unsigned char destination[ 6 ];
+    unsigned char source[ 6 ];
+    big_uint16_buf_t ether_type;
+};
+
+// follows an ethernet_header whose ether_type is ether_type::vlan or
+// ether_type::qinq; its own ether_type is that of the payload, or of the
+// next tag
+
+struct vlan_tag
+{
+    big_uint16_buf_t tci;
+    big_uint16_buf_t ether_type;
+
+    typedef endian_bitfield<order::big, 0, 0, 3> pcp_field;
+    typedef endian_bitfield<order::big, 0, 3, 1> dei_field;
+    typedef endian_bitfield<order::big, 0, 4, 12> vid_field;
+
+    endian::detail::uint8_t pcp() const noexcept { return pcp_field::get( *this ); }
+    bool dei() const noexcept { return dei_field::get( *this ) != 0; }
+    endian::detail::uint16_t vid() const noexcept { return vid_field::get( *this ); }
+};
+
+struct ipv4_header
+{
+    big_uint8_buf_t version_ihl;
+    big_uint8_buf_t tos;
+    big_uint16_buf_t total_length;
+    big_uint16_buf_t identification;
+    big_uint16_buf_t flags_fragment_offset;
+    big_uint8_buf_t ttl;
+    big_uint8_buf_t protocol;
+    big_uint16_buf_t header_checksum;
+    big_uint32_buf_t source;
+    big_uint32_buf_t destination;
+
+    typedef endian_bitfield<order::big, 0, 0, 4> version_field;
+    typedef endian_bitfield<order::big, 0, 4, 4> ihl_field;
+    typedef endian_bitfield<order::big, 1, 0, 6> dscp_field;
+    typedef endian_bitfield<order::big, 1, 6, 2> ecn_field;
+    typedef endian_bitfield<order::big, 6, 1, 1> dont_fragment_field;
+    typedef endian_bitfield<order::big, 6, 2, 1> more_fragments_field;
+    typedef endian_bitfield<order::big, 6, 3, 13> fragment_offset_field;
+
+    endian::detail::uint8_t version() const noexcept { return version_field::get( *this ); }
+    endian::detail::uint8_t ihl() const noexcept { return ihl_field::get( *this ); }
+    endian::detail::uint8_t dscp() const noexcept { return dscp_field::get( *this ); }
+    endian::detail::uint8_t ecn() const noexcept { return ecn_field::get( *this ); }
+    bool dont_fragment() const noexcept { return dont_fragment_field::get( *this ) != 0; }
+    bool more_fragments() const noexcept { return more_fragments_field::get( *this ) != 0; }
+    endian::detail::uint16_t fragment_offset() const noexcept { return fragment_offset_field::get( *this ); }
+
+    // in bytes, options included
+    std::size_t header_length() const noexcept { return ihl() * 4u; }
+};
+
+struct ipv6_header
+{
+    big_uint32_buf_t version_class_flow;
+    big_uint16_buf_t payload_length;
+    big_uint8_buf_t next_header;
+    big_uint8_buf_t hop_limit;
+    unsigned char source[ 16 ];
+    unsigned char destination[ 16 ];
+
+    typedef endian_bitfield<order::big, 0, 0, 4> version_field;
+    typedef endian_bitfield<order::big, 0, 4, 8> traffic_class_field;
+    typedef endian_bitfield<order::big, 0, 12, 20> flow_label_field;
+
+    endian::detail::uint8_t version() const noexcept { return version_field::get( *this ); }
+    endian::detail::uint8_t traffic_class() const noexcept { return traffic_class_field::get( *this ); }
+    endian::detail::uint32_t flow_label() const noexcept { return flow_label_field::get( *this ); }
+};
+
+struct udp_header
+{
+    big_uint16_buf_t source_port;
+    big_uint16_buf_t destination_port;
+    big_uint16_buf_t length;
+    big_uint16_buf_t checksum;
+};
+
+struct tcp_header
+{
+    big_uint16_buf_t source_port;
+    big_uint16_buf_t destination_port;
+    big_uint32_buf_t sequence_number;
+    big_uint32_buf_t acknowledgment_number;
+    big_uint16_buf_t offset_flags;
+    big_uint16_buf_t window;
+    big_uint16_buf_t checksum;
+    big_uint16_buf_t urgent_pointer;
+
+    typedef endian_bitfield<order::big, 12, 0, 4> data_offset_field;
+    typedef endian_bitfield<order::big, 12, 7, 9> flags_field;
+
+    endian::detail::uint8_t data_offset() const noexcept { return data_offset_field::get( *this ); }
+    endian::detail::uint16_t flags() const noexcept { return flags_field::get( *this ); }
+
+    // in bytes, options included
+    std::size_t header_length() const noexcept { return data_offset() * 4u; }
+};
+
+// the wire layouts
+
+BOOST_ENDIAN_STATIC_ASSERT( sizeof( ethernet_header ) == 14 && alignof( ethernet_header ) == 1 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ethernet_header, ether_type ) == 12 );
+
+BOOST_ENDIAN_STATIC_ASSERT( sizeof( vlan_tag ) == 4 && alignof( vlan_tag ) == 1 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( vlan_tag, ether_type ) == 2 );
+
+BOOST_ENDIAN_STATIC_ASSERT( sizeof( ipv4_header ) == 20 && alignof( ipv4_header ) == 1 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv4_header, total_length ) == 2 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv4_header, flags_fragment_offset ) == 6 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv4_header, protocol ) == 9 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv4_header, source ) == 12 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv4_header, destination ) == 16 );
+
+BOOST_ENDIAN_STATIC_ASSERT( sizeof( ipv6_header ) == 40 && alignof( ipv6_header ) == 1 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv6_header, payload_length ) == 4 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv6_header, next_header ) == 6 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv6_header, source ) == 8 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( ipv6_header, destination ) == 24 );
+
+BOOST_ENDIAN_STATIC_ASSERT( sizeof( udp_header ) == 8 && alignof( udp_header ) == 1 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( udp_header, checksum ) == 6 );
+
+BOOST_ENDIAN_STATIC_ASSERT( sizeof( tcp_header ) == 20 && alignof( tcp_header ) == 1 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( tcp_header, sequence_number ) == 4 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( tcp_header, offset_flags ) == 12 );
+BOOST_ENDIAN_STATIC_ASSERT( offsetof( tcp_header, urgent_pointer ) == 18 );
+
+// Element i of each array describes packet i. The offsets are from the start of
+// the packet, and are 0 when the layer was not found; the fields of a layer
+// that was not found are 0.
+
+struct packet_burst
+{
+    enum: std::size_t { capacity = 64 };
+
+    std::size_t size;
+
+    endian::detail::uint16_t l3_offset[ capacity ];
+    endian::detail::uint16_t l4_offset[ capacity ];
+    endian::detail::uint16_t payload_offset[ capacity ];
+
+    // after the VLAN tags, if any; vlan_id is that of the outer tag
+    endian::detail::uint16_t ether_type[ capacity ];
+    endian::detail::uint16_t vlan_id[ capacity ];
+
+    // 4 or 6; protocol is the IPv4 protocol or the IPv6 next header; ip_length
+    // includes the header, so that of IPv6 can exceed 65535
+    endian::detail::uint8_t ip_version[ capacity ];
+    endian::detail::uint8_t protocol[ capacity ];
+    endian::detail::uint8_t ttl[ capacity ];
+    endian::detail::uint32_t ip_length[ capacity ];
+
+    // IPv4 only; the IPv6 addresses are read in place, at l3_offset
+    endian::detail::uint32_t source_ipv4[ capacity ];
+    endian::detail::uint32_t destination_ipv4[ capacity ];
+
+    // UDP and TCP
+    endian::detail::uint16_t source_port[ capacity ];
+    endian::detail::uint16_t destination_port[ capacity ];
+    endian::detail::uint16_t tcp_flags[ capacity ];
+};
+
+namespace detail
+{
+
+template<class H> inline H const & header_at( unsigned char const * p ) noexcept
+{
+    return *reinterpret_cast<H const*>( p );
+}
+
+// UDP or TCP at q, with n bytes left
+
+inline void parse_l4( unsigned char const * p, unsigned char const * q, std::size_t n, endian::detail::uint8_t protocol, packet_burst & b, std::size_t i ) noexcept
+{
+    if( protocol == ip_protocol::udp && n >= sizeof( udp_header ) )
+    {
+        udp_header const & h = header_at<udp_header>( q );
+
+        b.l4_offset[ i ] = static_cast<endian::detail::uint16_t>( q - p );
+        b.payload_offset[ i ] = static_cast<endian::detail::uint16_t>( q - p + sizeof( udp_header ) );
+        b.source_port[ i ] = h.source_port.value();
+        b.destination_port[ i ] = h.destination_port.value();
+    }
+    else if( protocol == ip_protocol::tcp && n >= sizeof( tcp_header ) )
+    {
+        tcp_header const & h = header_at<tcp_header>( q );
+
+        std::size_t const k = h.header_length();
+
+        if( k < sizeof( tcp_header ) || k > n ) return;
+
+        b.l4_offset[ i ] = static_cast<endian::detail::uint16_t>( q - p );
+        b.payload_offset[ i ] = static_cast<endian::detail::uint16_t>( q - p + k );
+        b.source_port[ i ] = h.source_port.value();
+        b.destination_port[ i ] = h.destination_port.value();
+        b.tcp_flags[ i ] = h.flags();
+    }
+}
+
+inline void parse_packet( unsigned char const * p, std::size_t n, packet_burst & b, std::size_t i ) noexcept
+{
+    b.l3_offset[ i ] = 0;
+    b.l4_offset[ i ] = 0;
+    b.payload_offset[ i ] = 0;
+    b.ether_type[ i ] = 0;
+    b.vlan_id[ i ] = 0;
+    b.ip_version[ i ] = 0;
+    b.protocol[ i ] = 0;
+    b.ttl[ i ] = 0;
+    b.ip_length[ i ] = 0;
+    b.source_ipv4[ i ] = 0;
+    b.destination_ipv4[ i ] = 0;
+    b.source_port[ i ] = 0;
+    b.destination_port[ i ] = 0;
+    b.tcp_flags[ i ] = 0;
+
+    if( n < sizeof( ethernet_header ) ) return;
+
+    std::size_t k = sizeof( ethernet_header );
+    endian::detail::uint16_t type = header_at<ethernet_header>( p ).ether_type.value();
+
+    // at most two tags, as with 802.1ad
+
+    for( int j = 0; j < 2 && ( type == ether_type::vlan || type == ether_type::qinq ) && n - k >= sizeof( vlan_tag ); ++j )
+    {
+        vlan_tag const & t = header_at<vlan_tag>( p + k );
+
+        if( j == 0 )
+        {
+            b.vlan_id[ i ] = t.vid();
+        }
+
+        type = t.ether_type.value();
+        k += sizeof( vlan_tag );
+    }
+
+    b.ether_type[ i ] = type;
+
+    if( type == ether_type::ipv4 && n - k >= sizeof( ipv4_header ) )
+    {
+        ipv4_header const & h = header_at<ipv4_header>( p + k );
+
+        std::size_t const m = h.header_length();
+
+        if( h.version() != 4 || m < sizeof( ipv4_header ) || m > n - k ) return;
+
+        b.l3_offset[ i ] = static_cast<endian::detail::uint16_t>( k );
+        b.ip_version[ i ] = 4;
+        b.protocol[ i ] = h.protocol.value();
+        b.ttl[ i ] = h.ttl.value();
+        b.ip_length[ i ] = h.total_length.value();
+        b.source_ipv4[ i ] = h.source.value();
+        b.destination_ipv4[ i ] = h.destination.value();
+
+        // only the first fragment has the transport header
+
+        if( h.fragment_offset() == 0 )
+        {
+            detail::parse_l4( p, p + k + m, n - k - m, h.protocol.value(), b, i );
+        }
+    }
+    else if( type == ether_type::ipv6 && n - k >= sizeof( ipv6_header ) )
+    {
+        ipv6_header const & h = header_at<ipv6_header>( p + k );
+
+        if( h.version() != 6 ) return;
+
+        b.l3_offset[ i ] = static_cast<endian::detail::uint16_t>( k );
+        b.ip_version[ i ] = 6;
+        b.protocol[ i ] = h.next_header.value();
+        b.ttl[ i ] = h.hop_limit.value();
+        b.ip_length[ i ] = static_cast<endian::detail::uint32_t>( h.payload_length.value() + sizeof( ipv6_header ) );
+
+        // extension headers are not followed
+
+        detail::parse_l4( p, p + k + sizeof( ipv6_header ), n - k - sizeof( ipv6_header ), h.next_header.value(), b, i );
+    }
+}
+
+} // namespace detail
+
+// Requires:
+//
+//    packets[ i ] points to lengths[ i ] readable bytes, for i in [0, n)
+//
+// Effects:
+//
+//    Parses the first min( n, packet_burst::capacity ) packets, which start with
+//    an Ethernet header, into element i of the arrays of burst, and sets
+//    burst.size to their number. Malformed or truncated headers end the parse
+//    of a packet at the preceding layer.
+//
+// Returns:
+//
+//    burst.size
+
+inline std::size_t parse_burst( unsigned char const * const * packets, std::size_t const * lengths, std::size_t n, packet_burst & burst ) noexcept
+{
+    if( n > packet_burst::capacity )
+    {
+        n = packet_burst::capacity;
+    }
+
+    // the headers of the burst are fetched in parallel, rather than one
+    // cache miss at a time as each packet is parsed
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        boost::endian::detail::prefetch( packets[ i ] );
+
+        if( lengths[ i ] > 64 )
+        {
+            boost::endian::detail::prefetch( packets[ i ] + 63 );
+        }
+    }
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        detail::parse_packet( packets[ i ], lengths[ i ], burst, i );
+    }
+
+    burst.size = n;
+    return n;
+}
+
+} // namespace net
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_NET_HPP
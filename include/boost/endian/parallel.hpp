@@ -0,0 +1,292 @@
+//  boost/endian/parallel.hpp  ---------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_PARALLEL_HPP
+#define BOOST_ENDIAN_PARALLEL_HPP
+
+#include <boost/endian/conversion.hpp>
+#include <boost/endian/detail/parallel_for.hpp>
+#include <cstddef>
+
+//------------------------------------- synopsis ---------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //------------------------------------------------------------------------------------//
+  //                                                                                    //
+  //  Multi-threaded forms of the bulk functions in conversion.hpp. The array is split  //
+  //  into chunks on cache line boundaries of the destination; the workers take chunks  //
+  //  from a shared queue until none remain, so that a slow worker delays the others by //
+  //  at most one chunk. Each chunk is converted with the single-threaded function.     //
+  //                                                                                    //
+  //  Requirements and effects are those of the single-threaded functions.              //
+  //                                                                                    //
+  //------------------------------------------------------------------------------------//
+
+  //  in detail/parallel_for.hpp
+  //
+  //  struct parallel_options
+  //  {
+  //      unsigned threads;
+  //      std::size_t chunk_bytes;
+  //      bool numa;
+  //      std::function<void( std::function<void()> )> executor;
+  //
+  //      explicit parallel_options( unsigned threads = 0 );
+  //  };
+
+  template <class EndianReversibleInplace>
+    void endian_reverse_inplace_n(parallel_options const& opt,
+      EndianReversibleInplace* p, std::size_t n);
+
+  template <class EndianReversibleInplace>
+    void big_to_native_inplace_n(parallel_options const& opt,
+      EndianReversibleInplace* p, std::size_t n);
+  template <class EndianReversibleInplace>
+    void native_to_big_inplace_n(parallel_options const& opt,
+      EndianReversibleInplace* p, std::size_t n);
+  template <class EndianReversibleInplace>
+    void little_to_native_inplace_n(parallel_options const& opt,
+      EndianReversibleInplace* p, std::size_t n);
+  template <class EndianReversibleInplace>
+    void native_to_little_inplace_n(parallel_options const& opt,
+      EndianReversibleInplace* p, std::size_t n);
+
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    void conditional_reverse_inplace_n(parallel_options const& opt,
+      EndianReversibleInplace* p, std::size_t n);
+
+  template <class EndianReversibleInplace>
+    void endian_reverse_n(parallel_options const& opt,
+      EndianReversibleInplace const* src, EndianReversibleInplace* dst, std::size_t n,
+      store_hint hint = store_hint::normal);
+
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    void conditional_reverse_n(parallel_options const& opt,
+      EndianReversibleInplace const* src, EndianReversibleInplace* dst, std::size_t n,
+      store_hint hint = store_hint::normal);
+
+  template <class T>
+    void big_to_native_n(parallel_options const& opt,
+      unsigned char const* src, T* dst, std::size_t n,
+      store_hint hint = store_hint::normal);
+  template <class T>
+    void little_to_native_n(parallel_options const& opt,
+      unsigned char const* src, T* dst, std::size_t n,
+      store_hint hint = store_hint::normal);
+  template <class T>
+    void native_to_big_n(parallel_options const& opt,
+      T const* src, unsigned char* dst, std::size_t n,
+      store_hint hint = store_hint::normal);
+  template <class T>
+    void native_to_little_n(parallel_options const& opt,
+      T const* src, unsigned char* dst, std::size_t n,
+      store_hint hint = store_hint::normal);
+
+  template <class T, std::size_t N, enum order Order>
+    void endian_load_n(parallel_options const& opt,
+      unsigned char const* src, T* dst, std::size_t n);
+  template <class T, std::size_t N, enum order Order>
+    void endian_store_n(parallel_options const& opt,
+      T const* src, unsigned char* dst, std::size_t n);
+
+//----------------------------------- end synopsis -------------------------------------//
+
+namespace detail
+{
+
+// The chunk functions; each converts [first, first + count)
+
+template<enum order From, enum order To, class T> struct parallel_reverse_inplace
+{
+    T * p_;
+
+    void operator()( std::size_t first, std::size_t count ) const noexcept
+    {
+        boost::endian::conditional_reverse_inplace_n<From, To>( p_ + first, count );
+    }
+};
+
+template<enum order From, enum order To, class T> struct parallel_reverse_copy
+{
+    T const * src_;
+    T * dst_;
+    store_hint hint_;
+
+    void operator()( std::size_t first, std::size_t count ) const noexcept
+    {
+        boost::endian::conditional_reverse_n<From, To>( src_ + first, dst_ + first, count, hint_ );
+    }
+};
+
+template<enum order Order, class T> struct parallel_to_native
+{
+    unsigned char const * src_;
+    T * dst_;
+    store_hint hint_;
+
+    void operator()( std::size_t first, std::size_t count ) const noexcept
+    {
+        detail::conditional_reverse_n_bytes<sizeof(T)>( src_ + first * sizeof(T), reinterpret_cast<unsigned char*>( dst_ + first ), count, hint_,
+            detail::integral_constant<bool, Order == order::native>() );
+    }
+};
+
+template<enum order Order, class T> struct parallel_from_native
+{
+    T const * src_;
+    unsigned char * dst_;
+    store_hint hint_;
+
+    void operator()( std::size_t first, std::size_t count ) const noexcept
+    {
+        detail::conditional_reverse_n_bytes<sizeof(T)>( reinterpret_cast<unsigned char const*>( src_ + first ), dst_ + first * sizeof(T), count, hint_,
+            detail::integral_constant<bool, Order == order::native>() );
+    }
+};
+
+template<class T, std::size_t N, enum order Order> struct parallel_load
+{
+    unsigned char const * src_;
+    T * dst_;
+
+    void operator()( std::size_t first, std::size_t count ) const noexcept
+    {
+        boost::endian::endian_load_n<T, N, Order>( src_ + first * N, dst_ + first, count );
+    }
+};
+
+template<class T, std::size_t N, enum order Order> struct parallel_store
+{
+    T const * src_;
+    unsigned char * dst_;
+
+    void operator()( std::size_t first, std::size_t count ) const noexcept
+    {
+        boost::endian::endian_store_n<T, N, Order>( src_ + first, dst_ + first * N, count );
+    }
+};
+
+template<enum order From, enum order To, class T>
+inline void parallel_reverse_inplace_n( parallel_options const & opt, T * p, std::size_t n )
+{
+    parallel_reverse_inplace<From, To, T> f = { p };
+    detail::parallel_for( opt, reinterpret_cast<unsigned char const*>( p ), sizeof(T), n, f );
+}
+
+} // namespace detail
+
+template <class EndianReversibleInplace>
+inline void endian_reverse_inplace_n( parallel_options const & opt, EndianReversibleInplace * p, std::size_t n )
+{
+    detail::parallel_reverse_inplace_n<order::little, order::big>( opt, p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void big_to_native_inplace_n( parallel_options const & opt, EndianReversibleInplace * p, std::size_t n )
+{
+    detail::parallel_reverse_inplace_n<order::big, order::native>( opt, p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void native_to_big_inplace_n( parallel_options const & opt, EndianReversibleInplace * p, std::size_t n )
+{
+    detail::parallel_reverse_inplace_n<order::native, order::big>( opt, p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void little_to_native_inplace_n( parallel_options const & opt, EndianReversibleInplace * p, std::size_t n )
+{
+    detail::parallel_reverse_inplace_n<order::little, order::native>( opt, p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void native_to_little_inplace_n( parallel_options const & opt, EndianReversibleInplace * p, std::size_t n )
+{
+    detail::parallel_reverse_inplace_n<order::native, order::little>( opt, p, n );
+}
+
+template <enum order From, enum order To, class EndianReversibleInplace>
+inline void conditional_reverse_inplace_n( parallel_options const & opt, EndianReversibleInplace * p, std::size_t n )
+{
+    detail::parallel_reverse_inplace_n<From, To>( opt, p, n );
+}
+
+template <class EndianReversibleInplace>
+inline void endian_reverse_n( parallel_options const & opt, EndianReversibleInplace const * src, EndianReversibleInplace * dst, std::size_t n, store_hint hint )
+{
+    boost::endian::conditional_reverse_n<order::little, order::big>( opt, src, dst, n, hint );
+}
+
+template <enum order From, enum order To, class EndianReversibleInplace>
+inline void conditional_reverse_n( parallel_options const & opt, EndianReversibleInplace const * src, EndianReversibleInplace * dst, std::size_t n, store_hint hint )
+{
+    detail::parallel_reverse_copy<From, To, EndianReversibleInplace> f = { src, dst, hint };
+    detail::parallel_for( opt, reinterpret_cast<unsigned char const*>( dst ), sizeof(EndianReversibleInplace), n, f );
+}
+
+template <class T>
+inline void big_to_native_n( parallel_options const & opt, unsigned char const * src, T * dst, std::size_t n, store_hint hint )
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::parallel_to_native<order::big, T> f = { src, dst, hint };
+    detail::parallel_for( opt, reinterpret_cast<unsigned char const*>( dst ), sizeof(T), n, f );
+}
+
+template <class T>
+inline void little_to_native_n( parallel_options const & opt, unsigned char const * src, T * dst, std::size_t n, store_hint hint )
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::parallel_to_native<order::little, T> f = { src, dst, hint };
+    detail::parallel_for( opt, reinterpret_cast<unsigned char const*>( dst ), sizeof(T), n, f );
+}
+
+template <class T>
+inline void native_to_big_n( parallel_options const & opt, T const * src, unsigned char * dst, std::size_t n, store_hint hint )
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::parallel_from_native<order::big, T> f = { src, dst, hint };
+    detail::parallel_for( opt, dst, sizeof(T), n, f );
+}
+
+template <class T>
+inline void native_to_little_n( parallel_options const & opt, T const * src, unsigned char * dst, std::size_t n, store_hint hint )
+{
+    BOOST_ENDIAN_STATIC_ASSERT( !detail::is_class<T>::value && detail::is_endian_reversible_inplace<T>::value );
+
+    detail::parallel_from_native<order::little, T> f = { src, dst, hint };
+    detail::parallel_for( opt, dst, sizeof(T), n, f );
+}
+
+template <class T, std::size_t N, enum order Order>
+inline void endian_load_n( parallel_options const & opt, unsigned char const * src, T * dst, std::size_t n )
+{
+    detail::parallel_load<T, N, Order> f = { src, dst };
+    detail::parallel_for( opt, reinterpret_cast<unsigned char const*>( dst ), sizeof(T), n, f );
+}
+
+template <class T, std::size_t N, enum order Order>
+inline void endian_store_n( parallel_options const & opt, T const * src, unsigned char * dst, std::size_t n )
+{
+    detail::parallel_store<T, N, Order> f = { src, dst };
+    detail::parallel_for( opt, dst, N, n, f );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_PARALLEL_HPP
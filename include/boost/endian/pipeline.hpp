@@ -0,0 +1,275 @@
+//  boost/endian/pipeline.hpp  ---------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_PIPELINE_HPP
+#define BOOST_ENDIAN_PIPELINE_HPP
+
+#include <boost/endian/detail/pipeline.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <cstddef>
+#include <memory>
+#include <system_error>
+
+#if defined(BOOST_ENDIAN_HAS_PIPELINE)
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  Streaming conversion of a file of values: the reads, the conversion and the
+  //  writes of successive buffers overlap, so that neither the disk nor the CPU
+  //  waits for the other. A fixed set of buffers rotates between the stages. The
+  //  reads and writes go through io_uring where the kernel supports it (Linux
+  //  5.6 and later), and otherwise through pread and pwrite on a reader and a
+  //  writer thread; each buffer is converted with the parallel bulk functions.
+  //
+  //  Available where BOOST_ENDIAN_HAS_PIPELINE is defined (POSIX systems).
+
+  //  in detail/pipeline.hpp
+  //
+  //  struct pipeline_options
+  //  {
+  //      std::size_t buffer_bytes;    // 4 MB
+  //      unsigned buffers;            // 4
+  //      parallel_options parallel;   // all cores
+  //      bool io_uring;               // true
+  //
+  //      pipeline_options();
+  //  };
+
+  //  Reads src from its start to its end, converts the whole values of type
+  //  EndianReversibleInplace from From to To order, and writes them to dst at
+  //  the same offsets; trailing bytes that do not make a whole value are copied.
+  //  src is a regular file, and dst supports pwrite. Returns the number of bytes
+  //  written; ec is ESPIPE when src is not a regular file.
+
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    detail::uint64_t pipeline_convert(int src, int dst,
+      pipeline_options const& opt, std::error_code& ec);
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    detail::uint64_t pipeline_convert(int src, int dst,
+      pipeline_options const& opt = pipeline_options());
+
+  //  As above, with dst created or truncated
+
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    detail::uint64_t pipeline_convert_file(char const* src, char const* dst,
+      pipeline_options const& opt, std::error_code& ec);
+  template <enum order From, enum order To, class EndianReversibleInplace>
+    detail::uint64_t pipeline_convert_file(char const* src, char const* dst,
+      pipeline_options const& opt = pipeline_options());
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+//  pipeline_convert  ------------------------------------------------------------------//
+
+template<enum order From, enum order To, class EndianReversibleInplace>
+inline detail::uint64_t pipeline_convert( int src, int dst, pipeline_options const & opt, std::error_code & ec )
+{
+    typedef EndianReversibleInplace T;
+
+    ec.clear();
+
+    // the size of the file, without moving its offset
+
+    struct stat st;
+
+    if( ::fstat( src, &st ) != 0 )
+    {
+        ec = std::error_code( errno, std::generic_category() );
+        return 0;
+    }
+
+    if( !S_ISREG( st.st_mode ) )
+    {
+        ec = std::error_code( ESPIPE, std::generic_category() );
+        return 0;
+    }
+
+    detail::pipeline_state s;
+
+    s.src = src;
+    s.dst = dst;
+    s.size = static_cast<detail::uint64_t>( st.st_size );
+    s.written = 0;
+
+    s.buffer_bytes = opt.buffer_bytes / sizeof(T) * sizeof(T);
+
+    if( s.buffer_bytes == 0 )
+    {
+        s.buffer_bytes = sizeof(T);
+    }
+
+    // no more buffers than the file needs
+
+    std::size_t n = opt.buffers < 2? 2: opt.buffers;
+
+    if( s.size / s.buffer_bytes < n )
+    {
+        n = static_cast<std::size_t>( ( s.size + s.buffer_bytes - 1 ) / s.buffer_bytes );
+    }
+
+    if( n == 0 )
+    {
+        return 0;
+    }
+
+    // page aligned, as some files opened with O_DIRECT require
+
+    std::size_t const page = 4096;
+
+    std::unique_ptr<unsigned char[]> storage( new unsigned char[ n * s.buffer_bytes + page ] );
+    unsigned char * p = storage.get() + ( page - reinterpret_cast<std::size_t>( storage.get() ) % page ) % page;
+
+    s.buffers.resize( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        detail::pipeline_buffer & b = s.buffers[ i ];
+
+        b.p = p + i * s.buffer_bytes;
+        b.offset = 0;
+        b.size = 0;
+        b.done = 0;
+        b.state = detail::pipeline_buffer::idle;
+    }
+
+    detail::pipeline_converter<From, To, T> const convert = { &opt.parallel };
+
+    int e = 0;
+    bool done = false;
+
+#if defined(BOOST_ENDIAN_HAS_IO_URING)
+
+    if( opt.io_uring )
+    {
+        detail::io_ring ring;
+
+        if( ring.open( static_cast<unsigned>( n ) ) == 0 )
+        {
+            bool abandoned = false;
+
+            e = detail::pipeline_run_ring( ring, s, convert, abandoned );
+            done = true;
+
+            if( abandoned )
+            {
+                // the kernel may still write to the buffers
+                storage.release();
+            }
+        }
+    }
+
+#endif
+
+    if( !done )
+    {
+        e = detail::pipeline_run_threads( s, convert );
+    }
+
+    if( e != 0 )
+    {
+        ec = std::error_code( e, std::generic_category() );
+    }
+
+    return s.written;
+}
+
+template<enum order From, enum order To, class EndianReversibleInplace>
+inline detail::uint64_t pipeline_convert( int src, int dst, pipeline_options const & opt )
+{
+    std::error_code ec;
+
+    detail::uint64_t const r = boost::endian::pipeline_convert<From, To, EndianReversibleInplace>( src, dst, opt, ec );
+
+    if( ec )
+    {
+        throw std::system_error( ec, "pipeline_convert" );
+    }
+
+    return r;
+}
+
+template<enum order From, enum order To, class EndianReversibleInplace>
+inline detail::uint64_t pipeline_convert_file( char const * src, char const * dst, pipeline_options const & opt, std::error_code & ec )
+{
+    ec.clear();
+
+    int const in = ::open( src, O_RDONLY );
+
+    if( in < 0 )
+    {
+        ec = std::error_code( errno, std::generic_category() );
+        return 0;
+    }
+
+    int const out = ::open( dst, O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+
+    if( out < 0 )
+    {
+        ec = std::error_code( errno, std::generic_category() );
+        ::close( in );
+        return 0;
+    }
+
+    detail::uint64_t r = 0;
+
+    try
+    {
+        r = boost::endian::pipeline_convert<From, To, EndianReversibleInplace>( in, out, opt, ec );
+    }
+    catch( ... )
+    {
+        ::close( in );
+        ::close( out );
+        throw;
+    }
+
+    ::close( in );
+
+    if( ::close( out ) != 0 && !ec )
+    {
+        ec = std::error_code( errno, std::generic_category() );
+    }
+
+    return r;
+}
+
+template<enum order From, enum order To, class EndianReversibleInplace>
+inline detail::uint64_t pipeline_convert_file( char const * src, char const * dst, pipeline_options const & opt )
+{
+    std::error_code ec;
+
+    detail::uint64_t const r = boost::endian::pipeline_convert_file<From, To, EndianReversibleInplace>( src, dst, opt, ec );
+
+    if( ec )
+    {
+        throw std::system_error( ec, "pipeline_convert_file" );
+    }
+
+    return r;
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif // defined(BOOST_ENDIAN_HAS_PIPELINE)
+
+#endif // BOOST_ENDIAN_PIPELINE_HPP
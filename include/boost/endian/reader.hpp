@@ -0,0 +1,294 @@
+//  boost/endian/reader.hpp  -----------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_READER_HPP
+#define BOOST_ENDIAN_READER_HPP
+
+#include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_load_n.hpp>
+#include <boost/endian/detail/endian_value_traits.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/prefetch.hpp>
+#include <cstddef>
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  Whether reserve also prefetches the bytes that follow the reserved block.
+
+  enum class read_hint
+  {
+    normal,
+    prefetch
+  };
+
+  //  A cursor over the bytes [first, last). Values are read with their type given
+  //  as an endian_buffer or endian_arithmetic type, as in r.read<big_uint32_t>(),
+  //  and every read checks that the bytes are there. A read that would go past
+  //  last fails, and so do all the reads after it: the reader is then false, and
+  //  the values read are 0, so that a sequence of reads needs a single check at
+  //  its end.
+  //
+  //  reserve(n) checks n bytes once and returns an endian_block_reader, whose
+  //  reads inside those n bytes are not checked.
+
+  class endian_reader;
+  class endian_block_reader;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+namespace detail
+{
+
+// the lines of the block after a reserved one, up to 16 of them; the
+// hardware prefetcher follows longer sequential runs on its own
+
+inline void prefetch_block( unsigned char const * p, std::size_t n ) noexcept
+{
+    if( n > 1024 )
+    {
+        n = 1024;
+    }
+
+    for( std::size_t i = 0; i < n; i += 64 )
+    {
+        detail::prefetch( p + i );
+    }
+
+    if( n != 0 )
+    {
+        detail::prefetch( p + n - 1 );
+    }
+}
+
+} // namespace detail
+
+//  endian_block_reader  ---------------------------------------------------------------//
+
+class endian_block_reader
+{
+private:
+
+    unsigned char const * p_;
+    unsigned char const * last_;
+
+public:
+
+    // a block that failed to be reserved
+
+    endian_block_reader() noexcept: p_( 0 ), last_( 0 )
+    {
+    }
+
+    // p points to n readable bytes
+
+    endian_block_reader( unsigned char const * p, std::size_t n ) noexcept: p_( p ), last_( p + n )
+    {
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return p_ != 0;
+    }
+
+    // the position, and the bytes left in the block
+
+    unsigned char const * data() const noexcept
+    {
+        return p_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return static_cast<std::size_t>( last_ - p_ );
+    }
+
+    // Requires: size() >= the size of E
+
+    template<class E> typename detail::endian_value_traits<E>::value_type read() noexcept
+    {
+        typedef detail::endian_value_traits<E> traits;
+
+        typename traits::value_type v = boost::endian::endian_load<typename traits::value_type, traits::size, traits::byte_order>( p_ );
+
+        p_ += traits::size;
+        return v;
+    }
+
+    // Requires: size() >= n * the size of E
+
+    template<class E> void read_n( typename detail::endian_value_traits<E>::value_type * dst, std::size_t n ) noexcept
+    {
+        typedef detail::endian_value_traits<E> traits;
+
+        boost::endian::endian_load_n<typename traits::value_type, traits::size, traits::byte_order>( p_, dst, n );
+
+        p_ += n * traits::size;
+    }
+
+    // Requires: size() >= n
+
+    void skip( std::size_t n ) noexcept
+    {
+        p_ += n;
+    }
+};
+
+//  endian_reader  ---------------------------------------------------------------------//
+
+class endian_reader
+{
+private:
+
+    unsigned char const * first_;
+    unsigned char const * p_;
+    unsigned char const * last_;
+    bool failed_;
+
+    // a failed reader is at last, so that no later read fits
+
+    void fail() noexcept
+    {
+        failed_ = true;
+        p_ = last_;
+    }
+
+public:
+
+    endian_reader() noexcept: first_( 0 ), p_( 0 ), last_( 0 ), failed_( false )
+    {
+    }
+
+    // [first, last) is a readable range
+
+    endian_reader( unsigned char const * first, unsigned char const * last ) noexcept:
+        first_( first ), p_( first ), last_( last ), failed_( false )
+    {
+    }
+
+    // p points to n readable bytes
+
+    endian_reader( unsigned char const * p, std::size_t n ) noexcept:
+        first_( p ), p_( p ), last_( p + n ), failed_( false )
+    {
+    }
+
+    // observers
+
+    explicit operator bool() const noexcept
+    {
+        return !failed_;
+    }
+
+    bool failed() const noexcept
+    {
+        return failed_;
+    }
+
+    unsigned char const * data() const noexcept
+    {
+        return p_;
+    }
+
+    // the bytes left
+
+    std::size_t size() const noexcept
+    {
+        return static_cast<std::size_t>( last_ - p_ );
+    }
+
+    bool empty() const noexcept
+    {
+        return p_ == last_;
+    }
+
+    // the bytes read or skipped
+
+    std::size_t position() const noexcept
+    {
+        return static_cast<std::size_t>( p_ - first_ );
+    }
+
+    // reads
+
+    template<class E> typename detail::endian_value_traits<E>::value_type read() noexcept
+    {
+        typedef detail::endian_value_traits<E> traits;
+
+        if( size() < traits::size )
+        {
+            fail();
+            return typename traits::value_type();
+        }
+
+        typename traits::value_type v = boost::endian::endian_load<typename traits::value_type, traits::size, traits::byte_order>( p_ );
+
+        p_ += traits::size;
+        return v;
+    }
+
+    template<class E> bool read_n( typename detail::endian_value_traits<E>::value_type * dst, std::size_t n ) noexcept
+    {
+        typedef detail::endian_value_traits<E> traits;
+
+        if( size() / traits::size < n )
+        {
+            fail();
+            return false;
+        }
+
+        boost::endian::endian_load_n<typename traits::value_type, traits::size, traits::byte_order>( p_, dst, n );
+
+        p_ += n * traits::size;
+        return true;
+    }
+
+    bool skip( std::size_t n ) noexcept
+    {
+        if( size() < n )
+        {
+            fail();
+            return false;
+        }
+
+        p_ += n;
+        return true;
+    }
+
+    endian_block_reader reserve( std::size_t n, read_hint hint = read_hint::normal ) noexcept
+    {
+        if( size() < n )
+        {
+            fail();
+            return endian_block_reader();
+        }
+
+        endian_block_reader b( p_, n );
+
+        p_ += n;
+
+        if( hint == read_hint::prefetch )
+        {
+            detail::prefetch_block( p_, size() < n? size(): n );
+        }
+
+        return b;
+    }
+};
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_READER_HPP
@@ -0,0 +1,610 @@
+//  boost/endian/record.hpp  -----------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_RECORD_HPP
+#define BOOST_ENDIAN_RECORD_HPP
+
+#include <boost/endian/span.hpp>
+#include <boost/endian/detail/endian_gather_n.hpp>
+#include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_store.hpp>
+#include <boost/endian/detail/endian_reverse_n.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/simd.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+
+# if CHAR_BIT != 8
+#   error Platforms with CHAR_BIT != 8 are not supported
+# endif
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  A field of a record: a T stored in n_bits / 8 bytes in Order, at byte Offset
+  //  from the start of the record. A field is named by deriving a type from it:
+  //
+  //    struct length: endian_field<4, order::big, boost::uint32_t> {};
+
+  template <std::size_t Offset, enum order Order, class T,
+    std::size_t n_bits = sizeof(T) * CHAR_BIT>
+      struct endian_field;
+
+  //  The fields of a record. The fields may be listed in any order, must be distinct
+  //  and must not overlap. The record size is the end of the field that ends last;
+  //  a type derived from the layout may declare a larger `size`, for trailing bytes.
+
+  template <class... Fields>
+    struct endian_layout;
+
+  //  A view of one record with the given layout, starting at p. The fields are read
+  //  with endian_load and written with endian_store, at offsets known at compile
+  //  time. When Layout is const, the view is read-only and refers to const bytes.
+
+  template <class Layout>
+    class endian_record_view;
+
+  //  Decodes the n records with the given layout stored back to back at p into
+  //  one native array per field, in the order the fields are listed in the layout:
+  //  columns[k][i] is field k of record i.
+
+  template <class Layout, class... T>
+    void endian_load_records( unsigned char const * p, std::size_t n, T *... columns ) noexcept;
+
+  //  The inverse of endian_load_records: encodes n records into p from one native
+  //  array per field. store_hint::nontemporal writes p with streaming stores of
+  //  whole cache lines, and zeroes the bytes of the records not covered by a field.
+
+  template <class Layout, class... T>
+    void endian_store_records( unsigned char * p, std::size_t n, T const *... columns ) noexcept;
+  template <class Layout, class... T>
+    void endian_store_records( unsigned char * p, std::size_t n, store_hint hint,
+      T const *... columns ) noexcept;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+template< std::size_t Offset, enum order Order, class T, std::size_t n_bits >
+struct endian_field
+{
+    BOOST_ENDIAN_STATIC_ASSERT( n_bits % 8 == 0 );
+    BOOST_ENDIAN_STATIC_ASSERT( n_bits / 8 >= 1 && n_bits / 8 <= sizeof(T) );
+
+    typedef T value_type;
+
+    static const std::size_t offset = Offset;
+    static const std::size_t size = n_bits / 8;
+    static const order byte_order = Order;
+};
+
+template< std::size_t Offset, enum order Order, class T, std::size_t n_bits >
+const std::size_t endian_field<Offset, Order, T, n_bits>::offset;
+
+template< std::size_t Offset, enum order Order, class T, std::size_t n_bits >
+const std::size_t endian_field<Offset, Order, T, n_bits>::size;
+
+template< std::size_t Offset, enum order Order, class T, std::size_t n_bits >
+const order endian_field<Offset, Order, T, n_bits>::byte_order;
+
+namespace detail
+{
+
+// The endian_field a field name derives from. The properties of a field are
+// always taken from it, so that fields may be called `offset` or `size`.
+
+template<std::size_t Offset, order Order, class T, std::size_t n_bits>
+endian_field<Offset, Order, T, n_bits> endian_field_base( endian_field<Offset, Order, T, n_bits> const * );
+
+template<class F> struct endian_field_of
+{
+    typedef decltype( detail::endian_field_base( static_cast<F*>( 0 ) ) ) type;
+};
+
+template<class... F> struct endian_layout_end;
+
+template<> struct endian_layout_end<>: integral_constant<std::size_t, 0>
+{
+};
+
+template<class F, class... R> struct endian_layout_end<F, R...>
+{
+    typedef typename endian_field_of<F>::type B;
+
+    static const std::size_t value = B::offset + B::size > endian_layout_end<R...>::value? B::offset + B::size: endian_layout_end<R...>::value;
+};
+
+// whether F is one of R...
+
+template<class F, class... R> struct endian_layout_contains;
+
+template<class F> struct endian_layout_contains<F>: false_type
+{
+};
+
+template<class F, class G, class... R> struct endian_layout_contains<F, G, R...>: integral_constant<bool,
+    is_same<F, G>::value || endian_layout_contains<F, R...>::value>
+{
+};
+
+// whether F is distinct from, and does not overlap, each of R...
+
+template<class F, class... R> struct endian_layout_disjoint;
+
+template<class F> struct endian_layout_disjoint<F>: true_type
+{
+};
+
+template<class F, class G, class... R> struct endian_layout_disjoint<F, G, R...>
+{
+    typedef typename endian_field_of<F>::type A;
+    typedef typename endian_field_of<G>::type B;
+
+    static const bool value = !is_same<F, G>::value &&
+        ( A::offset + A::size <= B::offset || B::offset + B::size <= A::offset ) &&
+        endian_layout_disjoint<F, R...>::value;
+};
+
+// the number of bytes covered by the fields
+
+template<class... F> struct endian_layout_covered;
+
+template<> struct endian_layout_covered<>: integral_constant<std::size_t, 0>
+{
+};
+
+template<class F, class... R> struct endian_layout_covered<F, R...>: integral_constant<std::size_t,
+    endian_field_of<F>::type::size + endian_layout_covered<R...>::value>
+{
+};
+
+template<class... F> struct endian_layout_valid;
+
+template<> struct endian_layout_valid<>: true_type
+{
+};
+
+template<class F, class... R> struct endian_layout_valid<F, R...>: integral_constant<bool,
+    endian_layout_disjoint<F, R...>::value && endian_layout_valid<R...>::value>
+{
+};
+
+} // namespace detail
+
+template< class... Fields >
+struct endian_layout
+{
+    BOOST_ENDIAN_STATIC_ASSERT( detail::endian_layout_valid<Fields...>::value );
+
+    static const std::size_t size = detail::endian_layout_end<Fields...>::value;
+    static const std::size_t field_count = sizeof...(Fields);
+
+    template<class F> struct contains: detail::endian_layout_contains<F, Fields...>
+    {
+    };
+};
+
+template< class... Fields >
+const std::size_t endian_layout<Fields...>::size;
+
+template< class... Fields >
+const std::size_t endian_layout<Fields...>::field_count;
+
+namespace detail
+{
+
+template<class L> struct endian_record_traits
+{
+    typedef unsigned char byte_type;
+    typedef L layout_type;
+};
+
+template<class L> struct endian_record_traits<L const>
+{
+    typedef unsigned char const byte_type;
+    typedef L layout_type;
+};
+
+template<class F, class B> struct endian_record_field_reference
+{
+    typedef endian_span_reference<F::byte_order, typename F::value_type, F::size> type;
+};
+
+template<class F> struct endian_record_field_reference<F, unsigned char const>
+{
+    typedef typename F::value_type type;
+};
+
+template<class F, class L> struct endian_record_field_deref
+{
+    typedef endian_span_deref<F::byte_order, typename F::value_type, F::size> type;
+};
+
+template<class F, class L> struct endian_record_field_deref<F, L const>
+{
+    typedef endian_span_deref<F::byte_order, typename F::value_type const, F::size> type;
+};
+
+} // namespace detail
+
+template< class Layout >
+class endian_record_view
+{
+private:
+
+    typedef detail::endian_record_traits<Layout> traits;
+
+    template<class F> using field = typename detail::endian_field_of<F>::type;
+
+public:
+
+    typedef typename traits::layout_type layout_type;
+    typedef typename traits::byte_type byte_type;
+
+    // the value of a field; reference<F> is a proxy for a mutable view
+
+    template<class F> using value_type = typename field<F>::value_type;
+    template<class F> using reference = typename detail::endian_record_field_reference<field<F>, byte_type>::type;
+
+    static const std::size_t record_size = layout_type::size;
+
+private:
+
+    byte_type * p_;
+
+    template<class F> static void check_field() noexcept
+    {
+        BOOST_ENDIAN_STATIC_ASSERT( layout_type::template contains<F>::value );
+    }
+
+public:
+
+    endian_record_view() noexcept: p_( 0 )
+    {
+    }
+
+    // p points to record_size bytes
+
+    explicit endian_record_view( byte_type * p ) noexcept: p_( p )
+    {
+    }
+
+    // mutable to const
+
+    template<class U> endian_record_view( endian_record_view<U> const & r,
+        typename detail::enable_if< detail::is_same<Layout, U const>::value && !detail::is_const<U>::value >::type * = 0 ) noexcept:
+        p_( r.data() )
+    {
+    }
+
+    byte_type * data() const noexcept
+    {
+        return p_;
+    }
+
+    // the bytes of field F
+
+    template<class F> byte_type * field_data() const noexcept
+    {
+        check_field<F>();
+        return p_ + field<F>::offset;
+    }
+
+    // field access
+
+    template<class F> value_type<F> get() const noexcept
+    {
+        check_field<F>();
+        return boost::endian::endian_load<value_type<F>, field<F>::size, field<F>::byte_order>( p_ + field<F>::offset );
+    }
+
+    template<class F> void set( value_type<F> v ) const noexcept
+    {
+        BOOST_ENDIAN_STATIC_ASSERT( !detail::is_const<Layout>::value );
+
+        check_field<F>();
+        boost::endian::endian_store<value_type<F>, field<F>::size, field<F>::byte_order>( p_ + field<F>::offset, v );
+    }
+
+    // view[ F() ]; usable without the `template` keyword in generic code
+
+    template<class F> reference<F> operator[]( F ) const noexcept
+    {
+        check_field<F>();
+        return detail::endian_record_field_deref<field<F>, Layout>::type::apply( p_ + field<F>::offset );
+    }
+
+    // the record that follows this one, in an array of records
+
+    endian_record_view next() const noexcept
+    {
+        return endian_record_view( p_ + record_size );
+    }
+};
+
+template< class Layout >
+const std::size_t endian_record_view<Layout>::record_size;
+
+namespace detail
+{
+
+// The endian_layout a layout derives from
+
+template<class... F>
+inline endian_layout<F...> const * endian_layout_base( endian_layout<F...> const * p ) noexcept
+{
+    return p;
+}
+
+// The records are converted a tile of about 4 KB at a time. Each cache line
+// of the tile is fetched from memory by the first field that reads it, and
+// the other fields of the tile are then read from L1; each field of the tile
+// is converted by endian_gather_n, which uses the vector gather kernels for
+// 4 and 8 byte fields.
+
+template<std::size_t R> struct endian_records_tile: integral_constant<std::size_t,
+    R >= 4096? 1: 4096 / ( R == 0? 1: R )>
+{
+};
+
+template<class F>
+inline void endian_load_records_field( unsigned char const * p, std::size_t stride, typename endian_field_of<F>::type::value_type * dst, std::size_t n ) noexcept
+{
+    typedef typename endian_field_of<F>::type B;
+
+    boost::endian::endian_gather_n<typename B::value_type, B::size, B::byte_order>( p, stride, B::offset, dst, n );
+}
+
+template<std::size_t R, class... F>
+inline void endian_load_records_impl( endian_layout<F...> const *, unsigned char const * p, std::size_t n,
+    typename endian_field_of<F>::type::value_type *... columns ) noexcept
+{
+    std::size_t const K = endian_records_tile<R>::value;
+
+    for( std::size_t i = 0; i < n; i += K )
+    {
+        std::size_t const m = n - i < K? n - i: K;
+
+        int const tmp[] = { 0, ( detail::endian_load_records_field<F>( p + i * R, R, columns + i, m ), 0 )... };
+        (void)tmp;
+    }
+}
+
+template<class F>
+inline void endian_store_records_field( typename endian_field_of<F>::type::value_type const * src, unsigned char * p, std::size_t stride, std::size_t n ) noexcept
+{
+    typedef typename endian_field_of<F>::type B;
+
+    boost::endian::endian_scatter_n<typename B::value_type, B::size, B::byte_order>( src, p, stride, B::offset, n );
+}
+
+template<std::size_t R, class... F>
+inline void endian_store_records_tile( endian_layout<F...> const *, unsigned char * p, std::size_t i, std::size_t n,
+    typename endian_field_of<F>::type::value_type const *... columns ) noexcept
+{
+    int const tmp[] = { 0, ( detail::endian_store_records_field<F>( columns + i, p, R, n ), 0 )... };
+    (void)tmp;
+}
+
+// as above, but also zeroes the bytes not covered by a field
+
+template<std::size_t R, class... F>
+inline void endian_store_records_tile_nt( endian_layout<F...> const * layout, unsigned char * p, std::size_t i, std::size_t n,
+    typename endian_field_of<F>::type::value_type const *... columns ) noexcept
+{
+    if( endian_layout_covered<F...>::value != R )
+    {
+        std::memset( p, 0, n * R );
+    }
+
+    detail::endian_store_records_tile<R>( layout, p, i, n, columns... );
+}
+
+// Copies n 64-byte lines from the aligned src to the aligned dst with
+// streaming stores, which do not read the destination lines into the cache
+
+struct endian_stream_lines_simd
+{
+    static void scalar( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        std::memcpy( dst, src, n * 64 );
+    }
+
+#if defined(BOOST_ENDIAN_SIMD_SSSE3)
+
+    BOOST_ENDIAN_TARGET_SSSE3 static void ssse3( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        for( std::size_t i = 0; i < n * 64; i += 16 )
+        {
+            _mm_stream_si128( reinterpret_cast<__m128i*>( dst + i ), _mm_load_si128( reinterpret_cast<__m128i const*>( src + i ) ) );
+        }
+
+        _mm_sfence();
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX2)
+
+    BOOST_ENDIAN_TARGET_AVX2 static void avx2( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        for( std::size_t i = 0; i < n * 64; i += 32 )
+        {
+            _mm256_stream_si256( reinterpret_cast<__m256i*>( dst + i ), _mm256_load_si256( reinterpret_cast<__m256i const*>( src + i ) ) );
+        }
+
+        _mm_sfence();
+    }
+
+#endif
+
+#if defined(BOOST_ENDIAN_SIMD_AVX512)
+
+    BOOST_ENDIAN_TARGET_AVX512 static void avx512( unsigned char const * src, unsigned char * dst, std::size_t n ) noexcept
+    {
+        for( std::size_t i = 0; i < n * 64; i += 64 )
+        {
+            _mm512_stream_si512( reinterpret_cast<__m512i*>( dst + i ), _mm512_load_si512( src + i ) );
+        }
+
+        _mm_sfence();
+    }
+
+#endif
+};
+
+// With streaming stores, each tile is encoded into an aligned buffer in L1,
+// placed at the same offset modulo 64 as its destination, and the whole
+// destination lines are then streamed out; the bytes of the records that
+// are not covered by a field are written as zero. The bytes of the last, partial,
+// line are carried over to the start of the buffer for the next tile; the
+// partial lines at both ends of p are written with memcpy.
+
+template<std::size_t R, class L, class... T>
+inline void endian_store_records_nt( L const * layout, unsigned char * p, std::size_t n, T const *... columns ) noexcept
+{
+    std::size_t const K = endian_records_tile<R>::value;
+
+    struct alignas( 64 ) buffer_type
+    {
+        unsigned char data[ ( ( K * R + 63 ) / 64 + 1 ) * 64 ];
+    };
+
+    buffer_type buffer;
+    unsigned char * const b = buffer.data;
+
+    // p[ j ] is encoded into b[ j + h - w ]; b[ 0 ] corresponds to the
+    // first destination line that has not been written yet
+
+    std::size_t const h = reinterpret_cast<std::size_t>( p ) % 64;
+
+    std::size_t w = 0; // the bytes of p written so far, plus h, rounded down to 64
+    bool head = h != 0;
+
+    for( std::size_t i = 0; i < n; i += K )
+    {
+        std::size_t const m = n - i < K? n - i: K;
+
+        unsigned char * const q = b + ( i * R + h - w );
+
+        detail::endian_store_records_tile_nt<R>( layout, q, i, m, columns... );
+
+        std::size_t const end = ( i + m ) * R + h - w; // bytes of b in use
+        std::size_t const lines = end / 64;
+
+        std::size_t k = 0;
+
+        if( head && lines != 0 )
+        {
+            // the first line of p is not ours in full
+
+            std::memcpy( p, b + h, 64 - h );
+
+            k = 1;
+            head = false;
+        }
+
+        if( lines > k )
+        {
+            simd_invoke< endian_stream_lines_simd >( b + k * 64, p + ( w + k * 64 - h ), lines - k );
+        }
+
+        std::memmove( b, b + lines * 64, end - lines * 64 );
+        w += lines * 64;
+    }
+
+    // the last partial line
+
+    std::size_t const total = n * R + h;
+
+    if( total > w )
+    {
+        std::size_t const first = head? h: 0;
+        std::memcpy( p + ( w + first - h ), b + first, total - w - first );
+    }
+}
+
+} // namespace detail
+
+// Requires:
+//
+//    Layout is an endian_layout, or a class derived from one
+//    sizeof...(T) == Layout::field_count, and each T is the value_type of the
+//    corresponding field
+//    p points to n * Layout::size readable bytes
+//    columns[k] points to n writable T[k]
+//
+// Effects:
+//
+//    columns[k][i] = endian_record_view<Layout const>( p + i * Layout::size ).get<F[k]>()
+//    for each field F[k] and i in [0, n)
+
+template< class Layout, class... T >
+inline void endian_load_records( unsigned char const * p, std::size_t n, T *... columns ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof...(T) == Layout::field_count );
+
+    detail::endian_load_records_impl<Layout::size>( detail::endian_layout_base( static_cast<Layout const*>( 0 ) ), p, n, columns... );
+}
+
+// Requires:
+//
+//    Layout is an endian_layout, or a class derived from one
+//    sizeof...(T) == Layout::field_count, and each T is the value_type of the
+//    corresponding field
+//    p points to n * Layout::size writable bytes
+//    columns[k] points to n readable T[k]
+//
+// Effects:
+//
+//    endian_record_view<Layout>( p + i * Layout::size ).set<F[k]>( columns[k][i] )
+//    for each field F[k] and i in [0, n); with store_hint::nontemporal, the other
+//    bytes of the n records are set to zero
+
+template< class Layout, class... T >
+inline void endian_store_records( unsigned char * p, std::size_t n, store_hint hint, T const *... columns ) noexcept
+{
+    BOOST_ENDIAN_STATIC_ASSERT( sizeof...(T) == Layout::field_count );
+
+    std::size_t const R = Layout::size;
+    auto const layout = detail::endian_layout_base( static_cast<Layout const*>( 0 ) );
+
+    if( hint == store_hint::nontemporal )
+    {
+        detail::endian_store_records_nt<R>( layout, p, n, columns... );
+        return;
+    }
+
+    std::size_t const K = detail::endian_records_tile<R>::value;
+
+    for( std::size_t i = 0; i < n; i += K )
+    {
+        std::size_t const m = n - i < K? n - i: K;
+        detail::endian_store_records_tile<R>( layout, p + i * R, i, m, columns... );
+    }
+}
+
+template< class Layout, class... T >
+inline void endian_store_records( unsigned char * p, std::size_t n, T const *... columns ) noexcept
+{
+    boost::endian::endian_store_records<Layout>( p, n, store_hint::normal, columns... );
+}
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_RECORD_HPP
@@ -0,0 +1,441 @@
+//  boost/endian/span.hpp  -------------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_SPAN_HPP
+#define BOOST_ENDIAN_SPAN_HPP
+
+#include <boost/endian/detail/endian_load.hpp>
+#include <boost/endian/detail/endian_load_n.hpp>
+#include <boost/endian/detail/endian_store.hpp>
+#include <boost/endian/detail/endian_store_n.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <climits>
+#include <cstddef>
+#include <iterator>
+
+# if CHAR_BIT != 8
+#   error Platforms with CHAR_BIT != 8 are not supported
+# endif
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  A view of n values of n_bits / 8 bytes each, stored back to back in Order
+  //  starting at p. Elements are read with endian_load and written with
+  //  endian_store; copy_to and assign_from convert the whole view with the bulk
+  //  kernels. When T is const, the view is read-only and refers to const bytes.
+
+  template <enum order Order, class T, std::size_t n_bits = sizeof(T) * CHAR_BIT>
+    class endian_span;
+
+  // typedefs for the common cases
+
+  template <class T, std::size_t n_bits = sizeof(T) * CHAR_BIT>
+    using big_span = endian_span<order::big, T, n_bits>;
+  template <class T, std::size_t n_bits = sizeof(T) * CHAR_BIT>
+    using little_span = endian_span<order::little, T, n_bits>;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+namespace detail
+{
+
+// the object returned by dereferencing a mutable span iterator
+
+template<order Order, class T, std::size_t N> class endian_span_reference
+{
+private:
+
+    unsigned char * p_;
+
+public:
+
+    explicit endian_span_reference( unsigned char * p ) noexcept: p_( p )
+    {
+    }
+
+    endian_span_reference( endian_span_reference const & ) = default;
+
+    operator T() const noexcept
+    {
+        return boost::endian::endian_load<T, N, Order>( p_ );
+    }
+
+    endian_span_reference const & operator=( T v ) const noexcept
+    {
+        boost::endian::endian_store<T, N, Order>( p_, v );
+        return *this;
+    }
+
+    // assigns the value, not the reference
+
+    endian_span_reference const & operator=( endian_span_reference const & r ) const noexcept
+    {
+        return *this = static_cast<T>( r );
+    }
+
+    unsigned char * data() const noexcept
+    {
+        return p_;
+    }
+};
+
+// swaps the referenced values, so that std::sort and friends work
+
+template<order Order, class T, std::size_t N>
+inline void swap( endian_span_reference<Order, T, N> a, endian_span_reference<Order, T, N> b ) noexcept
+{
+    T tmp = a;
+    a = static_cast<T>( b );
+    b = tmp;
+}
+
+template<order Order, class T, std::size_t N> struct endian_span_traits
+{
+    typedef T value_type;
+    typedef unsigned char byte_type;
+    typedef endian_span_reference<Order, T, N> reference;
+};
+
+template<order Order, class T, std::size_t N> struct endian_span_traits<Order, T const, N>
+{
+    typedef T value_type;
+    typedef unsigned char const byte_type;
+    typedef T reference;
+};
+
+template<order Order, class T, std::size_t N, class R = typename endian_span_traits<Order, T, N>::reference>
+struct endian_span_deref
+{
+    static R apply( unsigned char * p ) noexcept
+    {
+        return R( p );
+    }
+};
+
+template<order Order, class T, std::size_t N> struct endian_span_deref<Order, T const, N, T>
+{
+    static T apply( unsigned char const * p ) noexcept
+    {
+        return boost::endian::endian_load<T, N, Order>( p );
+    }
+};
+
+template<order Order, class T, std::size_t N> class endian_span_iterator
+{
+private:
+
+    typedef endian_span_traits<Order, T, N> traits;
+    typedef typename traits::byte_type byte_type;
+
+    byte_type * p_;
+
+    template<order, class, std::size_t> friend class endian_span_iterator;
+
+public:
+
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename traits::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename traits::reference reference;
+    typedef void pointer;
+
+    endian_span_iterator() noexcept: p_( 0 )
+    {
+    }
+
+    explicit endian_span_iterator( byte_type * p ) noexcept: p_( p )
+    {
+    }
+
+    // mutable to const
+
+    template<class U> endian_span_iterator( endian_span_iterator<Order, U, N> const & it,
+        typename enable_if< is_same<T, U const>::value && !is_const<U>::value >::type * = 0 ) noexcept: p_( it.p_ )
+    {
+    }
+
+    byte_type * data() const noexcept
+    {
+        return p_;
+    }
+
+    reference operator*() const noexcept
+    {
+        return endian_span_deref<Order, T, N>::apply( p_ );
+    }
+
+    reference operator[]( difference_type i ) const noexcept
+    {
+        return endian_span_deref<Order, T, N>::apply( p_ + i * static_cast<difference_type>( N ) );
+    }
+
+    endian_span_iterator & operator++() noexcept
+    {
+        p_ += N;
+        return *this;
+    }
+
+    endian_span_iterator operator++( int ) noexcept
+    {
+        endian_span_iterator r( *this );
+        p_ += N;
+        return r;
+    }
+
+    endian_span_iterator & operator--() noexcept
+    {
+        p_ -= N;
+        return *this;
+    }
+
+    endian_span_iterator operator--( int ) noexcept
+    {
+        endian_span_iterator r( *this );
+        p_ -= N;
+        return r;
+    }
+
+    endian_span_iterator & operator+=( difference_type i ) noexcept
+    {
+        p_ += i * static_cast<difference_type>( N );
+        return *this;
+    }
+
+    endian_span_iterator & operator-=( difference_type i ) noexcept
+    {
+        p_ -= i * static_cast<difference_type>( N );
+        return *this;
+    }
+
+    friend endian_span_iterator operator+( endian_span_iterator it, difference_type i ) noexcept
+    {
+        return it += i;
+    }
+
+    friend endian_span_iterator operator+( difference_type i, endian_span_iterator it ) noexcept
+    {
+        return it += i;
+    }
+
+    friend endian_span_iterator operator-( endian_span_iterator it, difference_type i ) noexcept
+    {
+        return it -= i;
+    }
+
+    friend difference_type operator-( endian_span_iterator const & a, endian_span_iterator const & b ) noexcept
+    {
+        return ( a.p_ - b.p_ ) / static_cast<difference_type>( N );
+    }
+
+    friend bool operator==( endian_span_iterator const & a, endian_span_iterator const & b ) noexcept
+    {
+        return a.p_ == b.p_;
+    }
+
+    friend bool operator!=( endian_span_iterator const & a, endian_span_iterator const & b ) noexcept
+    {
+        return a.p_ != b.p_;
+    }
+
+    friend bool operator<( endian_span_iterator const & a, endian_span_iterator const & b ) noexcept
+    {
+        return a.p_ < b.p_;
+    }
+
+    friend bool operator>( endian_span_iterator const & a, endian_span_iterator const & b ) noexcept
+    {
+        return a.p_ > b.p_;
+    }
+
+    friend bool operator<=( endian_span_iterator const & a, endian_span_iterator const & b ) noexcept
+    {
+        return a.p_ <= b.p_;
+    }
+
+    friend bool operator>=( endian_span_iterator const & a, endian_span_iterator const & b ) noexcept
+    {
+        return a.p_ >= b.p_;
+    }
+};
+
+} // namespace detail
+
+//  endian_span  -----------------------------------------------------------------------//
+
+template< enum order Order, class T, std::size_t n_bits >
+class endian_span
+{
+private:
+
+    BOOST_ENDIAN_STATIC_ASSERT( n_bits % 8 == 0 );
+
+    static const std::size_t N = n_bits / 8;
+
+    typedef detail::endian_span_traits<Order, T, N> traits;
+
+public:
+
+    typedef typename traits::value_type value_type;
+    typedef typename traits::byte_type byte_type;
+    typedef typename traits::reference reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef detail::endian_span_iterator<Order, T, N> iterator;
+    typedef detail::endian_span_iterator<Order, value_type const, N> const_iterator;
+
+    BOOST_ENDIAN_STATIC_ASSERT( N >= 1 && N <= sizeof(value_type) );
+
+    static const std::size_t element_size = N;
+
+private:
+
+    byte_type * p_;
+    size_type n_;
+
+public:
+
+    endian_span() noexcept: p_( 0 ), n_( 0 )
+    {
+    }
+
+    // p points to n * element_size bytes
+
+    endian_span( byte_type * p, size_type n ) noexcept: p_( p ), n_( n )
+    {
+    }
+
+    // mutable to const
+
+    template<class U> endian_span( endian_span<Order, U, n_bits> const & s,
+        typename detail::enable_if< detail::is_same<T, U const>::value && !detail::is_const<U>::value >::type * = 0 ) noexcept:
+        p_( s.data() ), n_( s.size() )
+    {
+    }
+
+    // observers
+
+    byte_type * data() const noexcept
+    {
+        return p_;
+    }
+
+    size_type size() const noexcept
+    {
+        return n_;
+    }
+
+    size_type size_bytes() const noexcept
+    {
+        return n_ * N;
+    }
+
+    bool empty() const noexcept
+    {
+        return n_ == 0;
+    }
+
+    // element access
+
+    reference operator[]( size_type i ) const noexcept
+    {
+        return begin()[ static_cast<difference_type>( i ) ];
+    }
+
+    reference front() const noexcept
+    {
+        return *begin();
+    }
+
+    reference back() const noexcept
+    {
+        return begin()[ static_cast<difference_type>( n_ - 1 ) ];
+    }
+
+    // iterators
+
+    iterator begin() const noexcept
+    {
+        return iterator( p_ );
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator( p_ + n_ * N );
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return const_iterator( p_ );
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return const_iterator( p_ + n_ * N );
+    }
+
+    // subviews
+
+    endian_span first( size_type count ) const noexcept
+    {
+        return endian_span( p_, count );
+    }
+
+    endian_span last( size_type count ) const noexcept
+    {
+        return endian_span( p_ + ( n_ - count ) * N, count );
+    }
+
+    endian_span subspan( size_type offset, size_type count ) const noexcept
+    {
+        return endian_span( p_ + offset * N, count );
+    }
+
+    endian_span subspan( size_type offset ) const noexcept
+    {
+        return endian_span( p_ + offset * N, n_ - offset );
+    }
+
+    // bulk conversion
+
+    // dst points to size() values
+
+    void copy_to( value_type * dst ) const noexcept
+    {
+        boost::endian::endian_load_n<value_type, N, Order>( p_, dst, n_ );
+    }
+
+    // src points to size() values
+
+    void assign_from( value_type const * src ) const noexcept
+    {
+        BOOST_ENDIAN_STATIC_ASSERT( !detail::is_const<T>::value );
+
+        boost::endian::endian_store_n<value_type, N, Order>( src, p_, n_ );
+    }
+};
+
+template< enum order Order, class T, std::size_t n_bits >
+const std::size_t endian_span<Order, T, n_bits>::N;
+
+template< enum order Order, class T, std::size_t n_bits >
+const std::size_t endian_span<Order, T, n_bits>::element_size;
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_SPAN_HPP
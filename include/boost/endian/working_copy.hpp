@@ -0,0 +1,327 @@
+//  boost/endian/working_copy.hpp  -----------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_WORKING_COPY_HPP
+#define BOOST_ENDIAN_WORKING_COPY_HPP
+
+#include <boost/endian/conversion.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <boost/endian/detail/static_assert.hpp>
+#include <boost/endian/detail/type_traits.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  A native copy of an array of records stored in Order, for the "convert in
+  //  anticipation of need" approach without converting every record twice. The
+  //  copy is converted from the source once; changes are made through modify,
+  //  which marks the 64-byte lines of the copy that they touch, and flush
+  //  converts back to the source, in bulk with conditional_reverse_n, only the
+  //  records that overlap a marked line.
+  //
+  //  T is an EndianReversibleInplace type: an integral, enumeration, float or
+  //  double type, or a trivially copyable type described with
+  //  BOOST_ENDIAN_DESCRIBE_STRUCT or BOOST_ENDIAN_DESCRIBE_CLASS. Records are
+  //  converted whole, so a record larger than a line is written back whole
+  //  when any of its lines is marked.
+
+  template <enum order Order, class T>
+    class endian_working_copy;
+
+  template <class T>
+    using big_working_copy = endian_working_copy<order::big, T>;
+  template <class T>
+    using little_working_copy = endian_working_copy<order::little, T>;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+//  endian_working_copy  ---------------------------------------------------------------//
+
+template< enum order Order, class T >
+class endian_working_copy
+{
+public:
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    // the granularity of the change tracking, in bytes of the copy
+
+    static const std::size_t line_size = 64;
+
+private:
+
+    T * src_;
+    size_type n_;
+
+    std::unique_ptr<T[]> copy_;
+
+    // bit k % 64 of dirty_[ k / 64 ] is set when line k has changed
+
+    std::vector<detail::uint64_t> dirty_;
+
+    size_type lines() const noexcept
+    {
+        return ( n_ * sizeof(T) + line_size - 1 ) / line_size;
+    }
+
+    bool is_line_dirty( size_type k ) const noexcept
+    {
+        return ( dirty_[ k / 64 ] >> k % 64 ) & 1;
+    }
+
+    // the bytes [offset, offset + n) of the copy
+
+    void mark( size_type offset, size_type n ) noexcept
+    {
+        if( n == 0 ) return;
+
+        for( size_type k = offset / line_size, last = ( offset + n - 1 ) / line_size; k <= last; ++k )
+        {
+            dirty_[ k / 64 ] |= detail::uint64_t( 1 ) << k % 64;
+        }
+    }
+
+    static unsigned lowest_bit( detail::uint64_t w ) noexcept
+    {
+#if defined(__GNUC__)
+
+        return static_cast<unsigned>( __builtin_ctzll( w ) );
+
+#else
+
+        unsigned r = 0;
+
+        for( ; !( w & 1 ); w >>= 1 )
+        {
+            ++r;
+        }
+
+        return r;
+
+#endif
+    }
+
+    // the first line from k that is dirty, or clean, or lines(); a word of
+    // the bitmap at a time
+
+    size_type find( size_type k, bool dirty ) const noexcept
+    {
+        size_type const m = lines();
+
+        while( k < m )
+        {
+            detail::uint64_t w = dirty? dirty_[ k / 64 ]: ~dirty_[ k / 64 ];
+
+            w &= ~detail::uint64_t( 0 ) << k % 64;
+
+            if( w != 0 )
+            {
+                k = k / 64 * 64 + lowest_bit( w );
+                break;
+            }
+
+            k = ( k / 64 + 1 ) * 64;
+        }
+
+        return k < m? k: m;
+    }
+
+    // converts the records that overlap a dirty line from the copy to the
+    // source, if store, or from the source to the copy; one conversion per
+    // run of dirty lines, and each record at most once
+
+    size_type transfer( bool store ) noexcept
+    {
+        size_type const m = lines();
+
+        size_type r = 0;
+        size_type next = 0;
+
+        for( size_type a = find( 0, true ); a < m; )
+        {
+            size_type const b = find( a, false );
+
+            size_type first = a * line_size / sizeof(T);
+            size_type last = ( b * line_size + sizeof(T) - 1 ) / sizeof(T);
+
+            if( first < next ) first = next;
+            if( last > n_ ) last = n_;
+
+            if( first < last )
+            {
+                if( store )
+                {
+                    boost::endian::conditional_reverse_n<order::native, Order>( copy_.get() + first, src_ + first, last - first );
+                }
+                else
+                {
+                    boost::endian::conditional_reverse_n<Order, order::native>( src_ + first, copy_.get() + first, last - first );
+                }
+
+                r += last - first;
+                next = last;
+            }
+
+            a = find( b, true );
+        }
+
+        std::fill( dirty_.begin(), dirty_.end(), detail::uint64_t( 0 ) );
+
+        return r;
+    }
+
+public:
+
+    endian_working_copy() noexcept: src_( 0 ), n_( 0 )
+    {
+    }
+
+    // throws std::bad_alloc
+
+    endian_working_copy( T * src, size_type n ): src_( 0 ), n_( 0 )
+    {
+        assign( src, n );
+    }
+
+    // src points to n records in Order, which remain valid while the copy
+    // refers to them; converts them all
+
+    void assign( T * src, size_type n )
+    {
+        std::unique_ptr<T[]> copy( n != 0? new T[ n ]: 0 );
+        std::vector<detail::uint64_t> dirty( ( ( n * sizeof(T) + line_size - 1 ) / line_size + 63 ) / 64 );
+
+        boost::endian::conditional_reverse_n<Order, order::native>( src, copy.get(), n );
+
+        src_ = src;
+        n_ = n;
+
+        copy_.swap( copy );
+        dirty_.swap( dirty );
+    }
+
+    // observers
+
+    T * source() const noexcept
+    {
+        return src_;
+    }
+
+    size_type size() const noexcept
+    {
+        return n_;
+    }
+
+    bool empty() const noexcept
+    {
+        return n_ == 0;
+    }
+
+    T const * data() const noexcept
+    {
+        return copy_.get();
+    }
+
+    T const & operator[]( size_type i ) const noexcept
+    {
+        return copy_[ i ];
+    }
+
+    // changes; the references and pointers returned are valid until the
+    // next assign, and the changes made through them after flush are not
+    // tracked
+
+    T & modify( size_type i ) noexcept
+    {
+        mark( i * sizeof(T), sizeof(T) );
+        return copy_[ i ];
+    }
+
+    template<class M, class U> M & modify( size_type i, M U::* m ) noexcept
+    {
+        BOOST_ENDIAN_STATIC_ASSERT( (detail::is_same<U, T>::value) );
+
+        M & r = copy_[ i ].*m;
+
+        mark( static_cast<size_type>( reinterpret_cast<unsigned char*>( &r ) - reinterpret_cast<unsigned char*>( copy_.get() ) ), sizeof(M) );
+        return r;
+    }
+
+    T * modify( size_type first, size_type count ) noexcept
+    {
+        mark( first * sizeof(T), count * sizeof(T) );
+        return copy_.get() + first;
+    }
+
+    // change tracking
+
+    size_type line_count() const noexcept
+    {
+        return lines();
+    }
+
+    size_type dirty_lines() const noexcept
+    {
+        size_type r = 0;
+
+        for( size_type k = find( 0, true ), m = lines(); k < m; k = find( k + 1, true ) )
+        {
+            ++r;
+        }
+
+        return r;
+    }
+
+    bool is_dirty( size_type i ) const noexcept
+    {
+        for( size_type k = i * sizeof(T) / line_size, last = ( ( i + 1 ) * sizeof(T) - 1 ) / line_size; k <= last; ++k )
+        {
+            if( is_line_dirty( k ) ) return true;
+        }
+
+        return false;
+    }
+
+    // writes the records that overlap a changed line back to the source;
+    // returns the number of records written
+
+    size_type flush() noexcept
+    {
+        return transfer( true );
+    }
+
+    // converts the records that overlap a changed line again from the
+    // source, undoing the changes since the last flush; returns the number
+    // of records converted
+
+    size_type discard() noexcept
+    {
+        return transfer( false );
+    }
+};
+
+template< enum order Order, class T >
+const std::size_t endian_working_copy<Order, T>::line_size;
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_WORKING_COPY_HPP
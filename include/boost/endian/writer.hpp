@@ -0,0 +1,359 @@
+//  boost/endian/writer.hpp  -----------------------------------------------------------//
+
+//  Copyright 2021 Zachary Lund
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See http://www.boost.org/LICENSE_1_0.txt
+
+//  See library home page at http://www.boost.org/libs/endian
+
+//--------------------------------------------------------------------------------------//
+
+#ifndef BOOST_ENDIAN_WRITER_HPP
+#define BOOST_ENDIAN_WRITER_HPP
+
+#include <boost/endian/detail/endian_store.hpp>
+#include <boost/endian/detail/endian_store_n.hpp>
+#include <boost/endian/detail/endian_value_traits.hpp>
+#include <boost/endian/detail/order.hpp>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if ( defined(__unix__) || defined(__APPLE__) ) && !defined(BOOST_ENDIAN_NO_IOVEC)
+# include <sys/uio.h>
+# define BOOST_ENDIAN_HAS_IOVEC
+#endif
+
+//----------------------------------  synopsis  ----------------------------------------//
+
+namespace boost
+{
+namespace endian
+{
+
+  //  An output cursor that appends values, typed as in endian_reader, to a list
+  //  of chunks. A full chunk is left as it is and a larger one is started, so
+  //  that growing never moves or copies what was written, and a pointer to a
+  //  reserved range stays valid until clear() or destruction: a length prefix
+  //  can be reserved first and stored once the length is known. The chunks are
+  //  exported as an iovec array, for writev, or visited with for_each_chunk.
+  //  clear() keeps the chunks, so that a writer reused for many messages stops
+  //  allocating once it has grown to the largest of them.
+
+  class endian_writer;
+
+//----------------------------------  end synopsis  ------------------------------------//
+
+//  endian_writer  ---------------------------------------------------------------------//
+
+class endian_writer
+{
+private:
+
+    struct chunk
+    {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t capacity;
+        std::size_t size;
+    };
+
+    // chunks_[0, used_) hold the output; the last of them is being written,
+    // at p_, and its size is only updated when it is left. The chunks after
+    // them are kept by clear() for reuse
+
+    std::vector<chunk> chunks_;
+    std::size_t used_;
+
+    unsigned char * first_;
+    unsigned char * p_;
+    unsigned char * last_;
+
+    // the bytes in the chunks before the current one
+
+    std::size_t base_;
+
+    std::size_t chunk_size_;
+
+    // the first chunk is chunk_size bytes, and each one after it twice the
+    // size of the one before, up to 1 MB or chunk_size, whichever is larger
+
+    std::size_t next_capacity() const noexcept
+    {
+        std::size_t const m = chunk_size_ > ( 1u << 20 )? chunk_size_: ( 1u << 20 );
+
+        std::size_t c = chunk_size_;
+
+        for( std::size_t i = 0; i < used_ && c < m; ++i )
+        {
+            c *= 2;
+        }
+
+        return c < m? c: m;
+    }
+
+    // makes a chunk with at least n free bytes the current one; the chunk is
+    // allocated first, so that nothing changes when the allocation fails
+
+    void grow( std::size_t n )
+    {
+        if( used_ == chunks_.size() || chunks_[ used_ ].capacity < n )
+        {
+            std::size_t c = next_capacity();
+
+            if( c < n )
+            {
+                c = n;
+            }
+
+            chunk h = { std::unique_ptr<unsigned char[]>( new unsigned char[ c ] ), c, 0 };
+            chunks_.insert( chunks_.begin() + static_cast<std::ptrdiff_t>( used_ ), std::move( h ) );
+        }
+
+        if( used_ != 0 )
+        {
+            std::size_t const k = static_cast<std::size_t>( p_ - first_ );
+
+            chunks_[ used_ - 1 ].size = k;
+            base_ += k;
+        }
+
+        chunk & h = chunks_[ used_++ ];
+
+        first_ = p_ = h.data.get();
+        last_ = first_ + h.capacity;
+    }
+
+    std::size_t room() const noexcept
+    {
+        return static_cast<std::size_t>( last_ - p_ );
+    }
+
+    // the size of chunk i, which is in use
+
+    std::size_t chunk_size( std::size_t i ) const noexcept
+    {
+        return i + 1 == used_? static_cast<std::size_t>( p_ - first_ ): chunks_[ i ].size;
+    }
+
+public:
+
+    // chunk_size is the size of the first chunk
+
+    explicit endian_writer( std::size_t chunk_size = 4096 ) noexcept:
+        used_( 0 ), first_( 0 ), p_( 0 ), last_( 0 ), base_( 0 ), chunk_size_( chunk_size != 0? chunk_size: 1 )
+    {
+    }
+
+    // the writer moved from is left empty, with no chunks
+
+    endian_writer( endian_writer && r ) noexcept:
+        chunks_( std::move( r.chunks_ ) ), used_( r.used_ ), first_( r.first_ ), p_( r.p_ ), last_( r.last_ ), base_( r.base_ ), chunk_size_( r.chunk_size_ )
+    {
+        r.chunks_.clear();
+        r.clear();
+    }
+
+    endian_writer & operator=( endian_writer && r ) noexcept
+    {
+        if( this != &r )
+        {
+            chunks_ = std::move( r.chunks_ );
+            used_ = r.used_;
+            first_ = r.first_;
+            p_ = r.p_;
+            last_ = r.last_;
+            base_ = r.base_;
+            chunk_size_ = r.chunk_size_;
+
+            r.chunks_.clear();
+            r.clear();
+        }
+
+        return *this;
+    }
+
+    endian_writer( endian_writer const & ) = delete;
+    endian_writer & operator=( endian_writer const & ) = delete;
+
+    // observers
+
+    // the bytes written
+
+    std::size_t size() const noexcept
+    {
+        return base_ + static_cast<std::size_t>( p_ - first_ );
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // the number of chunks that hold the output; every one of them is
+    // non-empty
+
+    std::size_t chunk_count() const noexcept
+    {
+        return used_;
+    }
+
+    // the bytes allocated, including chunks kept by clear()
+
+    std::size_t capacity() const noexcept
+    {
+        std::size_t r = 0;
+
+        for( std::size_t i = 0; i < chunks_.size(); ++i )
+        {
+            r += chunks_[ i ].capacity;
+        }
+
+        return r;
+    }
+
+    // writes
+
+    template<class E> void write( typename detail::endian_value_traits<E>::value_type v )
+    {
+        typedef detail::endian_value_traits<E> traits;
+
+        if( room() < traits::size )
+        {
+            grow( traits::size );
+        }
+
+        boost::endian::endian_store<typename traits::value_type, traits::size, traits::byte_order>( p_, v );
+        p_ += traits::size;
+    }
+
+    // a value is never split across chunks
+
+    template<class E> void write_n( typename detail::endian_value_traits<E>::value_type const * src, std::size_t n )
+    {
+        typedef detail::endian_value_traits<E> traits;
+
+        while( n != 0 )
+        {
+            std::size_t k = room() / traits::size;
+
+            if( k == 0 )
+            {
+                grow( traits::size );
+                k = room() / traits::size;
+            }
+
+            if( k > n )
+            {
+                k = n;
+            }
+
+            boost::endian::endian_store_n<typename traits::value_type, traits::size, traits::byte_order>( src, p_, k );
+
+            src += k;
+            p_ += k * traits::size;
+            n -= k;
+        }
+    }
+
+    void write_bytes( unsigned char const * p, std::size_t n )
+    {
+        while( n != 0 )
+        {
+            if( room() == 0 )
+            {
+                grow( 1 );
+            }
+
+            std::size_t const k = room() < n? room(): n;
+
+            std::memcpy( p_, p, k );
+
+            p += k;
+            p_ += k;
+            n -= k;
+        }
+    }
+
+    // n contiguous bytes, to be stored into later; their contents are
+    // unspecified until then
+
+    unsigned char * reserve( std::size_t n )
+    {
+        if( room() < n )
+        {
+            grow( n );
+        }
+
+        unsigned char * r = p_;
+
+        p_ += n;
+        return r;
+    }
+
+    // discards the output and keeps the chunks
+
+    void clear() noexcept
+    {
+        used_ = 0;
+        first_ = p_ = last_ = 0;
+        base_ = 0;
+    }
+
+    // frees the chunks kept by clear()
+
+    void shrink_to_fit()
+    {
+        chunks_.erase( chunks_.begin() + static_cast<std::ptrdiff_t>( used_ ), chunks_.end() );
+    }
+
+    // output
+
+    // calls f( unsigned char const * p, std::size_t n ) for each chunk, in order
+
+    template<class F> void for_each_chunk( F f ) const
+    {
+        for( std::size_t i = 0; i < used_; ++i )
+        {
+            f( static_cast<unsigned char const*>( chunks_[ i ].data.get() ), chunk_size( i ) );
+        }
+    }
+
+    // dst points to size() writable bytes
+
+    void copy_to( unsigned char * dst ) const noexcept
+    {
+        for( std::size_t i = 0; i < used_; ++i )
+        {
+            std::size_t const k = chunk_size( i );
+
+            std::memcpy( dst, chunks_[ i ].data.get(), k );
+            dst += k;
+        }
+    }
+
+#if defined(BOOST_ENDIAN_HAS_IOVEC)
+
+    // fills iov with the first min( n, chunk_count() ) chunks; returns
+    // chunk_count(). writev accepts at most IOV_MAX entries per call
+
+    std::size_t export_iovec( iovec * iov, std::size_t n ) const noexcept
+    {
+        for( std::size_t i = 0; i < n && i < used_; ++i )
+        {
+            iov[ i ].iov_base = chunks_[ i ].data.get();
+            iov[ i ].iov_len = chunk_size( i );
+        }
+
+        return used_;
+    }
+
+#endif
+};
+
+} // namespace endian
+} // namespace boost
+
+#endif // BOOST_ENDIAN_WRITER_HPP
@@ -0,0 +1,838 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Compares the bulk (pointer + count) functions against a loop over the
+// corresponding scalar function, for each available instruction set.
+//
+// Usage: bulk_speed_test [values [repetitions]]
+
+#include <boost/endian/conversion.hpp>
+#include <boost/endian/bitfield.hpp>
+#include <boost/endian/checksum.hpp>
+#include <boost/endian/describe.hpp>
+#include <boost/endian/record.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/timer/timer.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace boost::endian;
+
+static std::size_t values = 1 << 20;
+static int repetitions = 100;
+
+// keeps the results alive
+
+static unsigned sink;
+
+static double mvalues_per_second( boost::timer::cpu_timer const & t )
+{
+    double s = t.elapsed().wall / 1e9;
+    return s > 0? static_cast<double>( values ) * repetitions / s / 1e6: 0;
+}
+
+template<class T, std::size_t N, order Order> void time_load( char const * name )
+{
+    std::vector<unsigned char> src( values * N );
+
+    for( std::size_t i = 0; i < src.size(); ++i )
+    {
+        src[ i ] = static_cast<unsigned char>( i * 0x9D );
+    }
+
+    std::vector<T> dst( values );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        unsigned char const * p = src.data();
+
+        for( std::size_t i = 0; i < values; ++i, p += N )
+        {
+            dst[ i ] = endian_load<T, N, Order>( p );
+        }
+
+        sink += static_cast<unsigned>( dst[ r ] );
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            endian_load_n<T, N, Order>( src.data(), dst.data(), values );
+            sink += static_cast<unsigned>( dst[ r ] );
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+template<class T, std::size_t N, order Order> void time_store( char const * name )
+{
+    std::vector<T> src( values );
+
+    for( std::size_t i = 0; i < values; ++i )
+    {
+        src[ i ] = static_cast<T>( i * 0x9E3779B97F4A7C15ull );
+    }
+
+    std::vector<unsigned char> dst( values * N );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        unsigned char * p = dst.data();
+
+        for( std::size_t i = 0; i < values; ++i, p += N )
+        {
+            endian_store<T, N, Order>( p, src[ i ] );
+        }
+
+        sink += dst[ r ];
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            endian_store_n<T, N, Order>( src.data(), dst.data(), values );
+            sink += dst[ r ];
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+// one field at the start of each `stride`-byte record
+
+template<class T, std::size_t N, order Order> void time_gather( char const * name, std::size_t stride )
+{
+    std::vector<unsigned char> src( values * stride );
+
+    for( std::size_t i = 0; i < src.size(); ++i )
+    {
+        src[ i ] = static_cast<unsigned char>( i * 0x9D );
+    }
+
+    std::vector<T> dst( values );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        unsigned char const * p = src.data();
+
+        for( std::size_t i = 0; i < values; ++i, p += stride )
+        {
+            dst[ i ] = endian_load<T, N, Order>( p );
+        }
+
+        sink += static_cast<unsigned>( dst[ r ] );
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            endian_gather_n<T, N, Order>( src.data(), stride, 0, dst.data(), values );
+            sink += static_cast<unsigned>( dst[ r ] );
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+template<class T, std::size_t N, order Order> void time_scatter( char const * name, std::size_t stride )
+{
+    std::vector<T> src( values );
+
+    for( std::size_t i = 0; i < values; ++i )
+    {
+        src[ i ] = static_cast<T>( i * 0x9E3779B97F4A7C15ull );
+    }
+
+    std::vector<unsigned char> dst( values * stride );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        unsigned char * p = dst.data();
+
+        for( std::size_t i = 0; i < values; ++i, p += stride )
+        {
+            endian_store<T, N, Order>( p, src[ i ] );
+        }
+
+        sink += dst[ r ];
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            endian_scatter_n<T, N, Order>( src.data(), dst.data(), stride, 0, values );
+            sink += dst[ r ];
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+// one bitfield of each `stride`-byte header
+
+template<class F> void time_bitfield( char const * name, std::size_t stride )
+{
+    std::vector<unsigned char> src( values * stride + 8 );
+
+    for( std::size_t i = 0; i < src.size(); ++i )
+    {
+        src[ i ] = static_cast<unsigned char>( i * 0x9D );
+    }
+
+    std::vector<typename F::value_type> dst( values );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        unsigned char const * p = src.data();
+
+        for( std::size_t i = 0; i < values; ++i, p += stride )
+        {
+            dst[ i ] = F::get( p );
+        }
+
+        sink += static_cast<unsigned>( dst[ r ] );
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            F::get_n( src.data(), stride, dst.data(), values );
+            sink += static_cast<unsigned>( dst[ r ] );
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+struct ihl: endian_bitfield<order::big, 0, 4, 4> {};
+struct fragment_offset: endian_bitfield<order::big, 6, 3, 13> {};
+struct flow_label: endian_bitfield<order::big, 0, 12, 20> {};
+
+// described records
+
+namespace records
+{
+
+struct small
+{
+    boost::uint16_t a, b, c;
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( small, a, b, c )
+
+struct header
+{
+    boost::uint16_t kind;
+    boost::uint16_t flags;
+    boost::uint32_t length;
+    boost::int64_t timestamp;
+    boost::uint16_t checksum;
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( header, kind, flags, length, timestamp, checksum )
+
+struct named
+{
+    boost::int32_t id;
+    boost::int64_t value;
+    char name[ 56 ];
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( named, id, value, name )
+
+// a packed 24-byte wire record
+
+struct id: endian_field<0, order::big, boost::uint32_t> {};
+struct timestamp: endian_field<4, order::big, boost::int64_t> {};
+struct kind: endian_field<12, order::big, boost::uint16_t> {};
+struct value: endian_field<14, order::big, double> {};
+struct length: endian_field<22, order::big, boost::uint16_t> {};
+
+typedef endian_layout<id, timestamp, kind, value, length> wire;
+
+struct columns
+{
+    std::vector<boost::uint32_t> id;
+    std::vector<boost::int64_t> timestamp;
+    std::vector<boost::uint16_t> kind;
+    std::vector<double> value;
+    std::vector<boost::uint16_t> length;
+};
+
+} // namespace records
+
+template<class T> void time_described( char const * name )
+{
+    std::vector<T> v( values );
+
+    unsigned char * q = reinterpret_cast<unsigned char*>( v.data() );
+
+    for( std::size_t i = 0; i < values * sizeof(T); ++i )
+    {
+        q[ i ] = static_cast<unsigned char>( i * 0x9D );
+    }
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        for( std::size_t i = 0; i < values; ++i )
+        {
+            endian_reverse_inplace( v[ i ] );
+        }
+
+        sink += q[ r ];
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            endian_reverse_inplace_n( v.data(), values );
+            sink += q[ r ];
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+// one native array per field, from the wire records
+
+template<class F> void load_field( unsigned char const * p, typename detail::endian_field_of<F>::type::value_type * dst )
+{
+    typedef typename detail::endian_field_of<F>::type B;
+
+    for( std::size_t i = 0; i < values; ++i, p += records::wire::size )
+    {
+        dst[ i ] = endian_load<typename B::value_type, B::size, B::byte_order>( p + B::offset );
+    }
+}
+
+void time_load_records( char const * name )
+{
+    std::vector<unsigned char> src( values * records::wire::size );
+
+    for( std::size_t i = 0; i < src.size(); ++i )
+    {
+        src[ i ] = static_cast<unsigned char>( i * 0x9D );
+    }
+
+    records::columns c;
+
+    c.id.resize( values );
+    c.timestamp.resize( values );
+    c.kind.resize( values );
+    c.value.resize( values );
+    c.length.resize( values );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        load_field<records::id>( src.data(), c.id.data() );
+        load_field<records::timestamp>( src.data(), c.timestamp.data() );
+        load_field<records::kind>( src.data(), c.kind.data() );
+        load_field<records::value>( src.data(), c.value.data() );
+        load_field<records::length>( src.data(), c.length.data() );
+
+        sink += c.id[ r ];
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            endian_load_records<records::wire>( src.data(), values, c.id.data(), c.timestamp.data(), c.kind.data(), c.value.data(), c.length.data() );
+            sink += c.id[ r ];
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+// the wire records, from one native array per field
+
+template<class F> void store_field( typename detail::endian_field_of<F>::type::value_type const * src, unsigned char * p )
+{
+    typedef typename detail::endian_field_of<F>::type B;
+
+    for( std::size_t i = 0; i < values; ++i, p += records::wire::size )
+    {
+        endian_store<typename B::value_type, B::size, B::byte_order>( p + B::offset, src[ i ] );
+    }
+}
+
+void time_store_records( char const * name, store_hint hint )
+{
+    records::columns c;
+
+    c.id.resize( values );
+    c.timestamp.resize( values );
+    c.kind.resize( values );
+    c.value.resize( values );
+    c.length.resize( values );
+
+    for( std::size_t i = 0; i < values; ++i )
+    {
+        c.id[ i ] = static_cast<boost::uint32_t>( i );
+        c.timestamp[ i ] = static_cast<boost::int64_t>( i * 0x9D );
+        c.kind[ i ] = static_cast<boost::uint16_t>( i );
+        c.value[ i ] = static_cast<double>( i );
+        c.length[ i ] = static_cast<boost::uint16_t>( i * 3 );
+    }
+
+    std::vector<unsigned char> dst( values * records::wire::size );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        store_field<records::id>( c.id.data(), dst.data() );
+        store_field<records::timestamp>( c.timestamp.data(), dst.data() );
+        store_field<records::kind>( c.kind.data(), dst.data() );
+        store_field<records::value>( c.value.data(), dst.data() );
+        store_field<records::length>( c.length.data(), dst.data() );
+
+        sink += dst[ r ];
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            endian_store_records<records::wire>( dst.data(), values, hint, c.id.data(), c.timestamp.data(), c.kind.data(), c.value.data(), c.length.data() );
+            sink += dst[ r ];
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+// checksums; the loop column is the conversion followed by a second pass
+// over the bytes for the checksum, at the widest level, and the other
+// columns the fused conversion
+
+template<class T, class C> void time_checksum( char const * name )
+{
+    std::vector<unsigned char> src( values * sizeof(T) );
+
+    for( std::size_t i = 0; i < src.size(); ++i )
+    {
+        src[ i ] = static_cast<unsigned char>( i * 0x9D );
+    }
+
+    std::vector<T> dst( values );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        C c;
+
+        big_to_native_n( src.data(), dst.data(), values );
+        c.update( src.data(), src.size() );
+
+        sink += static_cast<unsigned>( dst[ r ] ) + c.value();
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            C c;
+
+            big_to_native_n( src.data(), dst.data(), values, c );
+            sink += static_cast<unsigned>( dst[ r ] ) + c.value();
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+// varints of up to `bits` significant bits; the loop column decodes or
+// encodes one value at a time, and the fixed-width rows next to them are
+// the alternative for the same column
+
+template<class T> static std::vector<T> varint_values( int bits )
+{
+    std::vector<T> v( values );
+
+    for( std::size_t i = 0; i < values; ++i )
+    {
+        boost::uint64_t x = i * 0x9E3779B97F4A7C15ull;
+        x ^= x >> 29;
+
+        v[ i ] = static_cast<T>( bits >= 64? x: ( x >> 7 ) & ( ( 1ull << ( x % bits + 1 ) ) - 1 ) );
+    }
+
+    return v;
+}
+
+template<class T> void time_varint_load( char const * name, int bits )
+{
+    std::vector<T> const x = varint_values<T>( bits );
+
+    std::vector<unsigned char> src( values * varint_max_size<T>::value );
+    std::size_t const size = store_varint_n( x.data(), src.data(), values );
+
+    std::vector<T> dst( values );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        unsigned char const * p = src.data();
+        unsigned char const * last = p + size;
+
+        for( std::size_t i = 0; i < values; ++i )
+        {
+            p += detail::varint_load_one( p, last - p, dst[ i ] );
+        }
+
+        sink += static_cast<unsigned>( dst[ r ] );
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            sink += static_cast<unsigned>( load_varint_n( src.data(), size, dst.data(), values ) );
+            sink += static_cast<unsigned>( dst[ r ] );
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+template<class T> void time_varint_store( char const * name, int bits )
+{
+    std::vector<T> const src = varint_values<T>( bits );
+    std::vector<unsigned char> dst( values * varint_max_size<T>::value );
+
+    boost::timer::cpu_timer t1;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        unsigned char * p = dst.data();
+
+        for( std::size_t i = 0; i < values; ++i )
+        {
+            p += detail::varint_store_one( p, src[ i ] );
+        }
+
+        sink += dst[ r ];
+    }
+
+    t1.stop();
+
+    std::printf( "%-28s %10.1f", name, mvalues_per_second( t1 ) );
+
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        boost::timer::cpu_timer t2;
+
+        for( int r = 0; r < repetitions; ++r )
+        {
+            sink += static_cast<unsigned>( store_varint_n( src.data(), dst.data(), values ) );
+            sink += dst[ r ];
+        }
+
+        t2.stop();
+
+        std::printf( " %10.1f", mvalues_per_second( t2 ) );
+    }
+
+    set_simd_dispatch_level( supported );
+
+    std::printf( "\n" );
+}
+
+int main( int argc, char const * argv[] )
+{
+    if( argc > 1 )
+    {
+        values = std::strtoul( argv[ 1 ], 0, 10 );
+    }
+
+    if( argc > 2 )
+    {
+        repetitions = std::atoi( argv[ 2 ] );
+    }
+
+    if( values < static_cast<std::size_t>( repetitions ) )
+    {
+        values = repetitions;
+    }
+
+    std::printf( "%s; %lu values, %d repetitions; Mvalues/s\n\n", BOOST_ENDIAN_SIMD_MSG, static_cast<unsigned long>( values ), repetitions );
+
+    std::printf( "%-28s %10s", "", "loop" );
+
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        std::printf( " %10s", simd_level_name( static_cast<simd_level>( level ) ) );
+    }
+
+    std::printf( "\n" );
+
+    time_load<boost::int32_t, 3, order::big>( "load int32 <- big 24" );
+    time_load<boost::uint32_t, 3, order::big>( "load uint32 <- big 24" );
+    time_load<boost::int32_t, 3, order::little>( "load int32 <- little 24" );
+    time_load<boost::int64_t, 5, order::big>( "load int64 <- big 40" );
+    time_load<boost::int64_t, 6, order::big>( "load int64 <- big 48" );
+    time_load<boost::uint64_t, 6, order::big>( "load uint64 <- big 48" );
+    time_load<boost::uint64_t, 6, order::little>( "load uint64 <- little 48" );
+    time_load<boost::int64_t, 7, order::big>( "load int64 <- big 56" );
+    time_load<float, 4, order::big>( "load float <- big 32" );
+    time_load<double, 8, order::big>( "load double <- big 64" );
+
+    time_store<boost::int32_t, 3, order::big>( "store int32 -> big 24" );
+    time_store<boost::int32_t, 3, order::little>( "store int32 -> little 24" );
+    time_store<boost::int64_t, 5, order::big>( "store int64 -> big 40" );
+    time_store<boost::int64_t, 6, order::big>( "store int64 -> big 48" );
+    time_store<boost::int64_t, 6, order::little>( "store int64 -> little 48" );
+    time_store<boost::int64_t, 7, order::big>( "store int64 -> big 56" );
+    time_store<double, 8, order::big>( "store double -> big 64" );
+
+    std::printf( "\n" );
+
+    time_gather<boost::int32_t, 4, order::big>( "gather int32 <- big 32/8", 8 );
+    time_gather<boost::int32_t, 4, order::big>( "gather int32 <- big 32/28", 28 );
+    time_gather<boost::int32_t, 3, order::big>( "gather int32 <- big 24/16", 16 );
+    time_gather<boost::int64_t, 6, order::big>( "gather int64 <- big 48/16", 16 );
+    time_gather<double, 8, order::big>( "gather double <- big 64/24", 24 );
+
+    time_scatter<boost::int32_t, 4, order::big>( "scatter int32 -> big 32/8", 8 );
+    time_scatter<boost::int32_t, 4, order::big>( "scatter int32 -> big 32/28", 28 );
+    time_scatter<boost::int32_t, 3, order::big>( "scatter int32 -> big 24/16", 16 );
+    time_scatter<boost::int64_t, 6, order::big>( "scatter int64 -> big 48/16", 16 );
+
+    std::printf( "\n" );
+
+    time_bitfield<ihl>( "bitfield 4 <- big 8/20", 20 );
+    time_bitfield<fragment_offset>( "bitfield 13 <- big 16/20", 20 );
+    time_bitfield<flow_label>( "bitfield 20 <- big 32/40", 40 );
+
+    std::printf( "\n" );
+
+    time_described<records::small>( "reverse 3 x 16 bits" );
+    time_described<records::header>( "reverse 24-byte header" );
+    time_described<records::named>( "reverse 72-byte named" );
+
+    std::printf( "\n" );
+
+    time_load_records( "load 24-byte wire records" );
+    time_store_records( "store 24-byte wire records", store_hint::normal );
+    time_store_records( "store 24-byte wire, nt", store_hint::nontemporal );
+
+    std::printf( "\n" );
+
+    time_checksum<boost::uint32_t, internet_checksum>( "load uint32 + inet checksum" );
+    time_checksum<boost::uint64_t, internet_checksum>( "load uint64 + inet checksum" );
+    time_checksum<boost::uint32_t, crc32c>( "load uint32 + crc32c" );
+    time_checksum<boost::uint64_t, crc32c>( "load uint64 + crc32c" );
+
+    std::printf( "\n" );
+
+    time_load<boost::uint32_t, 4, order::little>( "load uint32 <- little 32" );
+    time_varint_load<boost::uint32_t>( "load uint32 <- varint 7", 7 );
+    time_varint_load<boost::uint32_t>( "load uint32 <- varint 14", 14 );
+    time_varint_load<boost::uint32_t>( "load uint32 <- varint 21", 21 );
+    time_varint_load<boost::uint32_t>( "load uint32 <- varint 32", 32 );
+    time_load<boost::uint64_t, 8, order::little>( "load uint64 <- little 64" );
+    time_varint_load<boost::uint64_t>( "load uint64 <- varint 14", 14 );
+    time_varint_load<boost::uint64_t>( "load uint64 <- varint 64", 64 );
+
+    time_store<boost::uint32_t, 4, order::little>( "store uint32 -> little 32" );
+    time_varint_store<boost::uint32_t>( "store uint32 -> varint 7", 7 );
+    time_varint_store<boost::uint32_t>( "store uint32 -> varint 21", 21 );
+    time_varint_store<boost::uint32_t>( "store uint32 -> varint 32", 32 );
+    time_store<boost::uint64_t, 8, order::little>( "store uint64 -> little 64" );
+    time_varint_store<boost::uint64_t>( "store uint64 -> varint 14", 14 );
+    time_varint_store<boost::uint64_t>( "store uint64 -> varint 64", 64 );
+
+    return sink == 0x12345678? 1: 0;
+}
@@ -0,0 +1,175 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+static std::size_t const sizes[] = { 0, 1, 3, 8, 17, 33, 64, 129, 257, 1000 };
+
+namespace user
+{
+
+// reversible in place only, as the EndianReversibleInplace requirements allow
+
+struct pair32
+{
+    boost::uint32_t a;
+    boost::int32_t b;
+};
+
+inline void endian_reverse_inplace( pair32 & x ) noexcept
+{
+    boost::endian::endian_reverse_inplace( x.a );
+    boost::endian::endian_reverse_inplace( x.b );
+}
+
+} // namespace user
+
+template<class T> void test( store_hint hint )
+{
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t n = sizes[ k ];
+
+        // the extra bytes let us start src and dst at every offset
+
+        std::vector<unsigned char> bytes( n * sizeof(T) + 64 );
+
+        for( std::size_t i = 0; i < bytes.size(); ++i )
+        {
+            bytes[ i ] = static_cast<unsigned char>( i * 7 + 3 );
+        }
+
+        for( std::size_t offset = 0; offset < 64; offset += 9 )
+        {
+            unsigned char const * src = bytes.data() + offset;
+
+            std::vector<T> v( n + 1 );
+
+            big_to_native_n( src, v.data() + 1, n, hint );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                BOOST_TEST_EQ( v[ i + 1 ], ( endian_load<T, sizeof(T), order::big>( src + i * sizeof(T) ) ) );
+            }
+
+            std::vector<unsigned char> out( n * sizeof(T) + 64 );
+
+            native_to_big_n( v.data() + 1, out.data() + offset, n, hint );
+            BOOST_TEST( n == 0 || std::memcmp( out.data() + offset, src, n * sizeof(T) ) == 0 );
+
+            little_to_native_n( src, v.data(), n, hint );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                BOOST_TEST_EQ( v[ i ], ( endian_load<T, sizeof(T), order::little>( src + i * sizeof(T) ) ) );
+            }
+
+            native_to_little_n( v.data(), out.data() + offset, n, hint );
+            BOOST_TEST( n == 0 || std::memcmp( out.data() + offset, src, n * sizeof(T) ) == 0 );
+
+            std::vector<T> w( n );
+
+            conditional_reverse_n<order::big, order::little>( v.data(), w.data(), n, hint );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                BOOST_TEST_EQ( w[ i ], endian_reverse( v[ i ] ) );
+            }
+
+            conditional_reverse_n( w.data(), w.data(), n, order::little, order::big );
+            conditional_reverse_n<order::big, order::big>( w.data(), v.data() + 1, n );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                BOOST_TEST_EQ( w[ i ], ( endian_load<T, sizeof(T), order::little>( src + i * sizeof(T) ) ) );
+                BOOST_TEST_EQ( v[ i + 1 ], w[ i ] );
+            }
+        }
+    }
+}
+
+static void test_udt()
+{
+    std::size_t const n = 100;
+
+    std::vector<user::pair32> v( n ), w( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        v[ i ].a = static_cast<boost::uint32_t>( i * 0x01020304 );
+        v[ i ].b = static_cast<boost::int32_t>( i * 1000 ) - 7;
+    }
+
+    endian_reverse_n( v.data(), w.data(), n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( w[ i ].a, endian_reverse( v[ i ].a ) );
+        BOOST_TEST_EQ( w[ i ].b, endian_reverse( v[ i ].b ) );
+    }
+
+    conditional_reverse_n<order::little, order::big>( w.data(), w.data(), n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( w[ i ].a, v[ i ].a );
+        BOOST_TEST_EQ( w[ i ].b, v[ i ].b );
+    }
+
+    std::vector<user::pair32> x( n );
+
+    conditional_reverse_n( v.data(), x.data(), n, order::big, order::little );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( x[ i ].a, endian_reverse( v[ i ].a ) );
+        BOOST_TEST_EQ( x[ i ].b, endian_reverse( v[ i ].b ) );
+    }
+}
+
+int main()
+{
+    test_udt();
+
+    store_hint const hints[] = { store_hint::normal, store_hint::nontemporal };
+
+    for( int i = 0; i < 2; ++i )
+    {
+        test<boost::int8_t>( hints[ i ] );
+        test<boost::uint16_t>( hints[ i ] );
+        test<boost::int16_t>( hints[ i ] );
+        test<boost::uint32_t>( hints[ i ] );
+        test<boost::int32_t>( hints[ i ] );
+        test<boost::uint64_t>( hints[ i ] );
+        test<boost::int64_t>( hints[ i ] );
+    }
+
+    {
+        float const f[ 2 ] = { 1.5f, -2.25f };
+        unsigned char b[ 8 ];
+
+        native_to_big_n( f, b, 2 );
+
+        BOOST_TEST_EQ( b[0], 0x3F );
+        BOOST_TEST_EQ( b[1], 0xC0 );
+        BOOST_TEST_EQ( b[4], 0xC0 );
+        BOOST_TEST_EQ( b[5], 0x10 );
+
+        float g[ 2 ];
+        big_to_native_n( b, g, 2 );
+
+        BOOST_TEST_EQ( g[0], f[0] );
+        BOOST_TEST_EQ( g[1], f[1] );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,272 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/binary_io.hpp>
+#include <boost/endian/arithmetic.hpp>
+#include <boost/endian/buffers.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace boost::endian;
+
+// a streambuf that counts the calls that move bytes
+
+class counting_buf: public std::stringbuf
+{
+public:
+
+    int puts;
+    int gets;
+
+    counting_buf(): puts( 0 ), gets( 0 )
+    {
+    }
+
+protected:
+
+    std::streamsize xsputn( char const * p, std::streamsize n )
+    {
+        ++puts;
+        return std::stringbuf::xsputn( p, n );
+    }
+
+    std::streamsize xsgetn( char * p, std::streamsize n )
+    {
+        ++gets;
+        return std::stringbuf::xsgetn( p, n );
+    }
+};
+
+template<class T> static std::vector<T> make_values( std::size_t n )
+{
+    std::vector<T> v( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        v[ i ] = static_cast<T>( i * 0x9E3779B97F4A7C15ull + ( i >> 3 ) );
+    }
+
+    return v;
+}
+
+// the bytes of the values in the format of E, one at a time
+
+template<class E> static std::string expected( std::vector<typename E::value_type> const & v )
+{
+    std::string s;
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        E const e( v[ i ] );
+        s.append( reinterpret_cast<char const*>( e.data() ), sizeof(E) );
+    }
+
+    return s;
+}
+
+template<class E> static void test_stream( std::size_t n )
+{
+    typedef typename E::value_type T;
+
+    // values that E represents exactly
+
+    std::vector<T> v = make_values<T>( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        v[ i ] = E( v[ i ] ).value();
+    }
+
+    counting_buf sb;
+
+    BOOST_TEST_EQ( write_binary<E>( sb, v.data(), n ), n );
+    BOOST_TEST( sb.str() == expected<E>( v ) );
+
+    // one transfer per staging buffer, whatever the number of values
+
+    std::size_t const k = binary_staging_bytes / sizeof(E);
+
+    BOOST_TEST_LE( sb.puts, static_cast<int>( ( n + k - 1 ) / k ) );
+
+    std::vector<T> w( n );
+
+    BOOST_TEST_EQ( read_binary<E>( sb, w.data(), n ), n );
+    BOOST_TEST( w == v );
+    BOOST_TEST_LE( sb.gets, static_cast<int>( ( n + k - 1 ) / k ) );
+
+    // the endian objects themselves, in one transfer each way
+
+    std::vector<E> e( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        e[ i ] = v[ i ];
+    }
+
+    counting_buf sb2;
+
+    BOOST_TEST_EQ( write_binary( sb2, e.data(), n ), n );
+    BOOST_TEST( sb2.str() == sb.str() );
+    BOOST_TEST_LE( sb2.puts, 1 );
+
+    std::vector<E> f( n );
+
+    BOOST_TEST_EQ( read_binary( sb2, f.data(), n ), n );
+    BOOST_TEST_LE( sb2.gets, 1 );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( f[ i ].value(), v[ i ] );
+    }
+}
+
+template<class E> static void test_sizes()
+{
+    test_stream<E>( 0 );
+    test_stream<E>( 1 );
+    test_stream<E>( 37 );
+    test_stream<E>( 100000 );
+}
+
+static void test_iostream()
+{
+    std::vector<boost::int32_t> const v = make_values<boost::int32_t>( 1000 );
+
+    std::stringstream ss;
+
+    BOOST_TEST_EQ( write_binary<big_int32_t>( ss, v.data(), v.size() ), v.size() );
+
+    std::vector<boost::int32_t> w( v.size() );
+
+    BOOST_TEST_EQ( read_binary<big_int32_t>( ss, w.data(), w.size() ), w.size() );
+    BOOST_TEST( w == v );
+
+    // the input ends in the middle of a value
+
+    std::istringstream is( ss.str().substr( 0, 4 * 10 + 3 ) );
+
+    std::vector<boost::int32_t> x( 20 );
+
+    BOOST_TEST_EQ( read_binary<big_int32_t>( is, x.data(), x.size() ), 10u );
+    BOOST_TEST( is.eof() );
+
+    for( std::size_t i = 0; i < 10; ++i )
+    {
+        BOOST_TEST_EQ( x[ i ], v[ i ] );
+    }
+
+    // a reusable staging buffer
+
+    std::vector<unsigned char> staging;
+    std::ostringstream os;
+
+    BOOST_TEST_EQ( write_binary<little_uint24_t>( os, reinterpret_cast<boost::uint32_t const*>( v.data() ), 500, staging ), 500u );
+    BOOST_TEST_EQ( os.str().size(), 1500u );
+    BOOST_TEST_EQ( staging.size(), 1500u );
+
+    std::istringstream is2( os.str() );
+    std::vector<boost::uint32_t> y( 500 );
+
+    BOOST_TEST_EQ( read_binary<little_uint24_t>( is2, y.data(), y.size(), staging ), 500u );
+
+    for( std::size_t i = 0; i < y.size(); ++i )
+    {
+        BOOST_TEST_EQ( y[ i ], static_cast<boost::uint32_t>( v[ i ] ) & 0xFFFFFFu );
+    }
+}
+
+static char const * const path = "endian_binary_io_test.tmp";
+
+static void test_file()
+{
+    std::vector<double> const v = make_values<double>( 5000 );
+
+    std::FILE * f = std::fopen( path, "wb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return;
+
+    BOOST_TEST_EQ( write_binary<big_float64_t>( f, v.data(), v.size() ), v.size() );
+    std::fclose( f );
+
+    f = std::fopen( path, "rb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return;
+
+    std::vector<double> w( v.size() + 1 );
+
+    BOOST_TEST_EQ( read_binary<big_float64_t>( f, w.data(), w.size() ), v.size() );
+
+    w.pop_back();
+    BOOST_TEST( w == v );
+
+    std::fclose( f );
+
+#if defined(BOOST_ENDIAN_HAS_FD_IO)
+
+    f = std::fopen( path, "wb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return;
+
+    std::vector<boost::uint16_t> const u = make_values<boost::uint16_t>( 300000 );
+
+    BOOST_TEST_EQ( write_binary<little_uint16_t>( fileno( f ), u.data(), u.size() ), u.size() );
+    std::fclose( f );
+
+    f = std::fopen( path, "rb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return;
+
+    std::vector<big_uint16_t> b( u.size() );
+
+    // read as little endian values, seen big endian: each one reversed
+
+    BOOST_TEST_EQ( read_binary( fileno( f ), b.data(), b.size() ), b.size() );
+
+    for( std::size_t i = 0; i < u.size(); ++i )
+    {
+        BOOST_TEST_EQ( b[ i ].value(), endian_reverse( u[ i ] ) );
+    }
+
+    std::fclose( f );
+
+    // a descriptor that is not open
+
+    BOOST_TEST_EQ( write_binary<big_uint16_t>( -1, u.data(), u.size() ), 0u );
+
+#endif
+
+    std::remove( path );
+}
+
+int main()
+{
+    test_sizes<big_uint8_t>();
+    test_sizes<big_int16_t>();
+    test_sizes<little_uint16_t>();
+    test_sizes<big_uint32_t>();
+    test_sizes<little_int32_t>();
+    test_sizes<big_uint24_t>();
+    test_sizes<little_int48_t>();
+    test_sizes<big_uint64_t>();
+    test_sizes<little_uint64_t>();
+    test_sizes<big_float32_t>();
+    test_sizes<little_float64_t>();
+    test_sizes<big_int32_buf_t>();
+    test_sizes<little_uint56_buf_t>();
+    test_sizes<native_uint32_t>();
+
+    test_iostream();
+    test_file();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,248 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/bitfield.hpp>
+#include <boost/endian/buffers.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+// IPv4
+
+struct version: endian_bitfield<order::big, 0, 0, 4> {};
+struct ihl: endian_bitfield<order::big, 0, 4, 4> {};
+struct dscp: endian_bitfield<order::big, 1, 0, 6> {};
+struct dont_fragment: endian_bitfield<order::big, 6, 1, 1> {};
+struct fragment_offset: endian_bitfield<order::big, 6, 3, 13> {};
+
+struct ipv4_start
+{
+    big_uint8_buf_t version_ihl;
+    big_uint8_buf_t tos;
+    big_uint16_buf_t total_length;
+    big_uint16_buf_t id;
+    big_uint16_buf_t flags_fragment;
+};
+
+// CCSDS space packet primary header
+
+struct apid: endian_bitfield<order::big, 0, 5, 11> {};
+struct sequence_flags: endian_bitfield<order::big, 2, 0, 2> {};
+struct sequence_count: endian_bitfield<order::big, 2, 2, 14> {};
+
+// containers of 3, 5 and 8 bytes
+
+struct a20: endian_bitfield<order::big, 1, 3, 20> {};
+struct b33: endian_bitfield<order::big, 0, 7, 33> {};
+struct c64: endian_bitfield<order::big, 0, 0, 64> {};
+
+// little endian; bit 0 is the least significant bit of the first byte
+
+struct l4: endian_bitfield<order::little, 0, 4, 4> {};
+struct l12: endian_bitfield<order::little, 1, 6, 12> {};
+struct l30: endian_bitfield<order::little, 2, 1, 30> {};
+
+// the value of bits [b, b + w) of the big-endian bit string at p, numbered
+// from the most significant bit of p[0]
+
+static boost::uint64_t bits_big( unsigned char const * p, std::size_t b, std::size_t w )
+{
+    boost::uint64_t r = 0;
+
+    for( std::size_t i = b; i < b + w; ++i )
+    {
+        r = ( r << 1 ) | ( ( p[ i / 8 ] >> ( 7 - i % 8 ) ) & 1 );
+    }
+
+    return r;
+}
+
+// numbered from the least significant bit of p[0]
+
+static boost::uint64_t bits_little( unsigned char const * p, std::size_t b, std::size_t w )
+{
+    boost::uint64_t r = 0;
+
+    for( std::size_t i = b + w; i-- > b; )
+    {
+        r = ( r << 1 ) | ( ( p[ i / 8 ] >> ( i % 8 ) ) & 1 );
+    }
+
+    return r;
+}
+
+template<class F> static boost::uint64_t bits( unsigned char const * p )
+{
+    return F::byte_order == order::big?
+        bits_big( p + F::offset, F::bit_offset, F::width ):
+        bits_little( p + F::offset, F::bit_offset, F::width );
+}
+
+template<class F> static void test_field()
+{
+    unsigned char b[ 16 ];
+
+    for( std::size_t i = 0; i < sizeof(b); ++i )
+    {
+        b[ i ] = static_cast<unsigned char>( i * 0x9D + 0x31 );
+    }
+
+    BOOST_TEST_EQ( static_cast<boost::uint64_t>( F::get( b ) ), bits<F>( b ) );
+
+    // set changes the field and nothing else
+
+    boost::uint64_t const values[] = { 0, 1, 0x5A5A5A5A5A5A5A5Aull, 0xA5A5A5A5A5A5A5A5ull, ~0ull };
+
+    for( std::size_t k = 0; k < sizeof(values) / sizeof(values[0]); ++k )
+    {
+        unsigned char c[ 16 ];
+        std::memcpy( c, b, sizeof(c) );
+
+        F::set( c, static_cast<typename F::value_type>( values[ k ] ) );
+
+        boost::uint64_t const w = F::width == 64? values[ k ]: values[ k ] & ( ( 1ull << F::width ) - 1 );
+
+        BOOST_TEST_EQ( static_cast<boost::uint64_t>( F::get( c ) ), w );
+        BOOST_TEST_EQ( bits<F>( c ), w );
+
+        // restore the field, and compare the rest
+
+        F::set( c, F::get( b ) );
+        BOOST_TEST( std::memcmp( b, c, sizeof(b) ) == 0 );
+    }
+}
+
+template<class F> static void test_n()
+{
+    static std::size_t const sizes[] = { 0, 1, 7, 8, 9, 17, 100, 255, 256, 257, 600 };
+    static std::size_t const strides[] = { 8, 20, 13 };
+
+    for( std::size_t s = 0; s < sizeof(strides) / sizeof(strides[0]); ++s )
+    {
+        for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+        {
+            std::size_t const n = sizes[ k ];
+            std::size_t const stride = strides[ s ];
+
+            std::vector<unsigned char> b( n * stride + 16 );
+
+            for( std::size_t i = 0; i < b.size(); ++i )
+            {
+                b[ i ] = static_cast<unsigned char>( i * 0x9D + 0x31 );
+            }
+
+            std::vector<typename F::value_type> v( n + 1, 7 );
+
+            F::get_n( b.data(), stride, v.data(), n );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                BOOST_TEST_EQ( v[ i ], F::get( &b[ i * stride ] ) );
+            }
+
+            BOOST_TEST_EQ( v[ n ], 7 );
+
+            // set_n of the inverted values, then get_n again
+
+            std::vector<unsigned char> c( b );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                v[ i ] = static_cast<typename F::value_type>( ~v[ i ] );
+            }
+
+            F::set_n( v.data(), c.data(), stride, n );
+
+            std::vector<typename F::value_type> w( n );
+            F::get_n( c.data(), stride, w.data(), n );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                BOOST_TEST_EQ( static_cast<boost::uint64_t>( w[ i ] ), static_cast<boost::uint64_t>( v[ i ] ) & ( F::width == 64? ~0ull: ( 1ull << F::width ) - 1 ) );
+            }
+        }
+    }
+}
+
+static void test_ipv4()
+{
+    unsigned char const h[] = { 0x45, 0xB8, 0x00, 0x54, 0x12, 0x34, 0x40, 0x00 };
+
+    BOOST_TEST_EQ( version::get( h ), 4 );
+    BOOST_TEST_EQ( ihl::get( h ), 5 );
+    BOOST_TEST_EQ( dscp::get( h ), 46 );
+    BOOST_TEST_EQ( dont_fragment::get( h ), 1 );
+    BOOST_TEST_EQ( fragment_offset::get( h ), 0 );
+
+    // in a struct of endian buffers
+
+    ipv4_start s;
+    std::memcpy( &s, h, sizeof(s) );
+
+    BOOST_TEST_EQ( ihl::get( s ), 5 );
+    BOOST_TEST_EQ( fragment_offset::get( s ), 0 );
+
+    fragment_offset::set( s, 0x1ABC );
+    ihl::set( s, 6 );
+
+    BOOST_TEST_EQ( s.flags_fragment.value(), 0x5ABC );
+    BOOST_TEST_EQ( s.version_ihl.value(), 0x46 );
+    BOOST_TEST_EQ( dont_fragment::get( s ), 1 );
+}
+
+static void test_ccsds()
+{
+    unsigned char const h[] = { 0x08, 0x73, 0xC0, 0x2A, 0x00, 0x0F };
+
+    BOOST_TEST_EQ( apid::get( h ), 0x073 );
+    BOOST_TEST_EQ( sequence_flags::get( h ), 3 );
+    BOOST_TEST_EQ( sequence_count::get( h ), 0x2A );
+}
+
+int main()
+{
+    BOOST_TEST_EQ( a20::size, 3u );
+    BOOST_TEST_EQ( b33::size, 5u );
+    BOOST_TEST_EQ( sizeof( a20::value_type ), 4u );
+    BOOST_TEST_EQ( sizeof( b33::value_type ), 8u );
+    BOOST_TEST_EQ( sizeof( ihl::value_type ), 1u );
+    BOOST_TEST_EQ( sizeof( fragment_offset::value_type ), 2u );
+
+    test_ipv4();
+    test_ccsds();
+
+    test_field<version>();
+    test_field<ihl>();
+    test_field<dscp>();
+    test_field<dont_fragment>();
+    test_field<fragment_offset>();
+    test_field<apid>();
+    test_field<sequence_count>();
+    test_field<a20>();
+    test_field<b33>();
+    test_field<c64>();
+    test_field<l4>();
+    test_field<l12>();
+    test_field<l30>();
+
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test_n<ihl>();
+        test_n<fragment_offset>();
+        test_n<a20>();
+        test_n<b33>();
+        test_n<c64>();
+        test_n<l12>();
+        test_n<l30>();
+    }
+
+    return boost::report_errors();
+}
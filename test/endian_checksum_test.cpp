@@ -0,0 +1,309 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/checksum.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+// the definitions, one word or bit at a time
+
+static boost::uint16_t inet_reference( unsigned char const * p, std::size_t n )
+{
+    boost::uint32_t s = 0;
+
+    for( std::size_t i = 0; i < n; i += 2 )
+    {
+        s += p[ i ] << 8 | ( i + 1 < n? p[ i + 1 ]: 0 );
+        s = ( s & 0xFFFF ) + ( s >> 16 );
+    }
+
+    return static_cast<boost::uint16_t>( s );
+}
+
+static boost::uint32_t crc32c_reference( unsigned char const * p, std::size_t n )
+{
+    boost::uint32_t c = 0xFFFFFFFF;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        c ^= p[ i ];
+
+        for( int k = 0; k < 8; ++k )
+        {
+            c = c & 1? ( c >> 1 ) ^ 0x82F63B78: c >> 1;
+        }
+    }
+
+    return ~c;
+}
+
+static void fill( unsigned char * p, std::size_t n )
+{
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        p[ i ] = static_cast<unsigned char>( i * 0x9D + ( i >> 8 ) * 0x3B + 0x35 );
+    }
+}
+
+static void test_known()
+{
+    {
+        // RFC 1071, 3.
+
+        unsigned char const b[] = { 0x00, 0x01, 0xF2, 0x03, 0xF4, 0xF5, 0xF6, 0xF7 };
+
+        internet_checksum s;
+        s.update( b, sizeof(b) );
+
+        BOOST_TEST_EQ( s.sum(), 0xDDF2 );
+        BOOST_TEST_EQ( s.value(), 0x220D );
+    }
+
+    {
+        // an IPv4 header, with its checksum at 10
+
+        unsigned char const b[] = { 0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00, 0x40, 0x11, 0xB8, 0x61, 0xC0, 0xA8, 0x00, 0x01, 0xC0, 0xA8, 0x00, 0xC7 };
+
+        internet_checksum s;
+        s.update( b, sizeof(b) );
+
+        BOOST_TEST_EQ( s.value(), 0 );
+    }
+
+    {
+        unsigned char const b[] = "123456789";
+
+        crc32c c;
+        c.update( b, 9 );
+
+        BOOST_TEST_EQ( c.value(), 0xE3069283u );
+
+        crc32c d;
+        d.update( b, 0 );
+
+        BOOST_TEST_EQ( d.value(), 0u );
+    }
+
+    {
+        // RFC 3720, B.4: 32 bytes of zeros, of ones, and incrementing
+
+        unsigned char b[ 32 ];
+
+        std::memset( b, 0, 32 );
+
+        crc32c c0;
+        c0.update( b, 32 );
+
+        BOOST_TEST_EQ( c0.value(), 0x8A9136AAu );
+
+        std::memset( b, 0xFF, 32 );
+
+        crc32c c1;
+        c1.update( b, 32 );
+
+        BOOST_TEST_EQ( c1.value(), 0x62A8AB43u );
+
+        for( int i = 0; i < 32; ++i )
+        {
+            b[ i ] = static_cast<unsigned char>( i );
+        }
+
+        crc32c c2;
+        c2.update( b, 32 );
+
+        BOOST_TEST_EQ( c2.value(), 0x46DD794Eu );
+    }
+}
+
+static void test_update()
+{
+    // the lengths straddle the vector widths and the three CRC stripes
+
+    static std::size_t const sizes[] = { 0, 1, 2, 7, 8, 15, 16, 17, 31, 63, 64, 65, 127, 1535, 1536, 1537, 3079, 5000 };
+
+    std::vector<unsigned char> b( 5001 );
+    fill( b.data(), b.size() );
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+
+        // misaligned, all at once
+
+        {
+            internet_checksum s;
+            s.update( b.data() + 1, n );
+
+            BOOST_TEST_EQ( s.sum(), inet_reference( b.data() + 1, n ) );
+
+            crc32c c;
+            c.update( b.data() + 1, n );
+
+            BOOST_TEST_EQ( c.value(), crc32c_reference( b.data() + 1, n ) );
+        }
+
+        // in pieces of odd and even lengths
+
+        for( std::size_t m = 1; m <= 4; ++m )
+        {
+            internet_checksum s;
+            crc32c c;
+
+            for( std::size_t i = 0; i < n; i += m )
+            {
+                std::size_t const r = n - i < m? n - i: m;
+
+                s.update( b.data() + i, r );
+                c.update( b.data() + i, r );
+            }
+
+            BOOST_TEST_EQ( s.sum(), inet_reference( b.data(), n ) );
+            BOOST_TEST_EQ( c.value(), crc32c_reference( b.data(), n ) );
+        }
+
+        // resumed from a value
+
+        {
+            std::size_t const h = n / 3;
+
+            crc32c c;
+            c.update( b.data(), h );
+
+            crc32c d( c.value() );
+            d.update( b.data() + h, n - h );
+
+            BOOST_TEST_EQ( d.value(), crc32c_reference( b.data(), n ) );
+        }
+    }
+
+    // sums that carry many times
+
+    {
+        std::vector<unsigned char> z( 100000, 0xFF );
+
+        internet_checksum s;
+        s.update( z.data(), z.size() );
+
+        BOOST_TEST_EQ( s.sum(), 0xFFFF );
+        BOOST_TEST_EQ( s.sum(), inet_reference( z.data(), z.size() ) );
+    }
+}
+
+// byte comparison, as the float bytes may be NaNs
+
+template<class T> static bool same( std::vector<T> const & x, std::vector<T> const & y )
+{
+    return x.size() == y.size() && ( x.empty() || std::memcmp( x.data(), y.data(), x.size() * sizeof(T) ) == 0 );
+}
+
+template<class T> static void test_fused()
+{
+    // the lengths straddle the 6144 byte blocks
+
+    std::size_t const m = 6144 / sizeof(T);
+    std::size_t const sizes[] = { 0, 1, 3, 17, m - 1, m, m + 1, 3 * m + 5 };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+
+        std::vector<unsigned char> w( n * sizeof(T) + 1 );
+        fill( w.data(), w.size() );
+
+        unsigned char const * p = w.data() + 1;
+        std::size_t const bytes = n * sizeof(T);
+
+        std::vector<T> x( n ), y( n );
+        big_to_native_n( p, y.data(), n );
+
+        // decode
+
+        {
+            internet_checksum s;
+            crc32c c;
+
+            big_to_native_n( p, x.data(), n, s );
+            BOOST_TEST( same( x, y ) );
+
+            x.assign( n, T() );
+
+            big_to_native_n( p, x.data(), n, c );
+            BOOST_TEST( same( x, y ) );
+
+            BOOST_TEST_EQ( s.sum(), inet_reference( p, bytes ) );
+            BOOST_TEST_EQ( c.value(), crc32c_reference( p, bytes ) );
+        }
+
+        {
+            internet_checksum s;
+            crc32c c;
+
+            little_to_native_n( p, x.data(), n, s );
+            little_to_native_n( p, x.data(), n, c );
+
+            std::vector<T> z( n );
+            little_to_native_n( p, z.data(), n );
+
+            BOOST_TEST( same( x, z ) );
+            BOOST_TEST_EQ( s.sum(), inet_reference( p, bytes ) );
+            BOOST_TEST_EQ( c.value(), crc32c_reference( p, bytes ) );
+        }
+
+        // encode; the checksum is that of the output
+
+        {
+            std::vector<unsigned char> v( bytes + 1 );
+
+            internet_checksum s;
+            crc32c c;
+
+            native_to_big_n( y.data(), v.data() + 1, n, s );
+            BOOST_TEST( std::memcmp( v.data() + 1, p, bytes ) == 0 );
+
+            native_to_big_n( y.data(), v.data() + 1, n, c );
+
+            BOOST_TEST_EQ( s.sum(), inet_reference( p, bytes ) );
+            BOOST_TEST_EQ( c.value(), crc32c_reference( p, bytes ) );
+
+            internet_checksum s2;
+            crc32c c2;
+
+            native_to_little_n( y.data(), v.data() + 1, n, s2 );
+            native_to_little_n( y.data(), v.data() + 1, n, c2 );
+
+            std::vector<unsigned char> u( bytes + 1 );
+            native_to_little_n( y.data(), u.data() + 1, n );
+
+            BOOST_TEST( std::memcmp( v.data() + 1, u.data() + 1, bytes ) == 0 );
+            BOOST_TEST_EQ( s2.sum(), inet_reference( u.data() + 1, bytes ) );
+            BOOST_TEST_EQ( c2.value(), crc32c_reference( u.data() + 1, bytes ) );
+        }
+    }
+}
+
+int main()
+{
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test_known();
+        test_update();
+
+        test_fused<boost::uint8_t>();
+        test_fused<boost::uint16_t>();
+        test_fused<boost::int32_t>();
+        test_fused<boost::uint64_t>();
+        test_fused<float>();
+        test_fused<double>();
+    }
+
+    return boost::report_errors();
+}
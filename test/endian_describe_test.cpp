@@ -0,0 +1,249 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/describe.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+namespace user
+{
+
+enum E { e0, e1 = 0x01020304 };
+
+struct Inner
+{
+    boost::uint16_t a;
+    boost::int64_t b;
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( Inner, a, b )
+
+// padding, an unlisted member, a character array, a nested described type
+// and arrays of both
+
+struct Mixed
+{
+    boost::uint8_t c;
+    boost::uint32_t d;
+    char name[ 5 ];
+    boost::int16_t e[ 3 ];
+    float f;
+    double g;
+    E h;
+    Inner i;
+    Inner j[ 2 ];
+    boost::uint32_t not_listed;
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( Mixed, c, d, name, e, f, g, h, i, j )
+
+// 6 bytes, so that the permutation spans several objects
+
+struct Small
+{
+    boost::uint16_t x, y, z;
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( Small, x, y, z )
+
+class Private
+{
+public:
+
+    Private(): id_( 0 ), value_( 0 )
+    {
+    }
+
+    Private( boost::int32_t id, boost::int64_t value ): id_( id ), value_( value )
+    {
+    }
+
+    boost::int32_t id() const { return id_; }
+    boost::int64_t value() const { return value_; }
+
+private:
+
+    boost::int32_t id_;
+    boost::int64_t value_;
+
+    BOOST_ENDIAN_DESCRIBE_CLASS( Private, id_, value_ )
+};
+
+// a member with a user-supplied endian_reverse_inplace; the arrays are
+// converted member by member
+
+struct Custom
+{
+    boost::uint32_t v;
+};
+
+inline void endian_reverse_inplace( Custom & x ) noexcept
+{
+    boost::endian::endian_reverse_inplace( x.v );
+}
+
+struct WithCustom
+{
+    boost::uint16_t a;
+    Custom b;
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( WithCustom, a, b )
+
+} // namespace user
+
+// the expected result, member by member
+
+static void reverse_by_hand( user::Inner & x )
+{
+    endian_reverse_inplace( x.a );
+    endian_reverse_inplace( x.b );
+}
+
+static void reverse_by_hand( user::Mixed & x )
+{
+    endian_reverse_inplace( x.d );
+    endian_reverse_inplace( x.e );
+    endian_reverse_inplace( x.f );
+    endian_reverse_inplace( x.g );
+    endian_reverse_inplace( x.h );
+    reverse_by_hand( x.i );
+    reverse_by_hand( x.j[ 0 ] );
+    reverse_by_hand( x.j[ 1 ] );
+}
+
+static void reverse_by_hand( user::Small & x )
+{
+    endian_reverse_inplace( x.x );
+    endian_reverse_inplace( x.y );
+    endian_reverse_inplace( x.z );
+}
+
+static void reverse_by_hand( user::WithCustom & x )
+{
+    endian_reverse_inplace( x.a );
+    endian_reverse_inplace( x.b.v );
+}
+
+template<class T> static void fill( T * p, std::size_t n )
+{
+    unsigned char * q = reinterpret_cast<unsigned char*>( p );
+
+    for( std::size_t i = 0; i < n * sizeof(T); ++i )
+    {
+        q[ i ] = static_cast<unsigned char>( i * 0x9D + 0x35 );
+    }
+}
+
+template<class T> static void test()
+{
+    // single objects
+
+    {
+        T x, y;
+
+        fill( &x, 1 );
+        std::memcpy( &y, &x, sizeof(T) );
+
+        endian_reverse_inplace( x );
+        reverse_by_hand( y );
+
+        BOOST_TEST( std::memcmp( &x, &y, sizeof(T) ) == 0 );
+
+        conditional_reverse_inplace<order::little, order::big>( x );
+        reverse_by_hand( y );
+
+        BOOST_TEST( std::memcmp( &x, &y, sizeof(T) ) == 0 );
+    }
+
+    // arrays; the sizes straddle the permutation period
+
+    static std::size_t const sizes[] = { 0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 33, 64, 65, 100, 150 };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+
+        // one extra object, which must not be touched
+
+        std::vector<T> x( n + 1 ), y( n + 1 ), z( n + 1 );
+
+        fill( x.data(), n + 1 );
+        std::memcpy( y.data(), x.data(), ( n + 1 ) * sizeof(T) );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            reverse_by_hand( y[ i ] );
+        }
+
+        std::memcpy( z.data(), x.data(), ( n + 1 ) * sizeof(T) );
+        endian_reverse_inplace_n( z.data(), n );
+        BOOST_TEST( std::memcmp( z.data(), y.data(), ( n + 1 ) * sizeof(T) ) == 0 );
+
+        std::memcpy( z.data(), x.data(), ( n + 1 ) * sizeof(T) );
+        endian_reverse_inplace( z.data(), z.data() + n );
+        BOOST_TEST( std::memcmp( z.data(), y.data(), ( n + 1 ) * sizeof(T) ) == 0 );
+
+        std::memcpy( z.data(), x.data(), ( n + 1 ) * sizeof(T) );
+        conditional_reverse_inplace_n( z.data(), n, order::big, order::little );
+        BOOST_TEST( std::memcmp( z.data(), y.data(), ( n + 1 ) * sizeof(T) ) == 0 );
+
+        std::vector<T> w( x );
+        endian_reverse_n( x.data(), w.data(), n );
+        BOOST_TEST( std::memcmp( w.data(), y.data(), ( n + 1 ) * sizeof(T) ) == 0 );
+    }
+}
+
+static void test_private()
+{
+    user::Private x[ 4 ] = { user::Private( 1, 2 ), user::Private( 0x01020304, 0x0102030405060708 ), user::Private( -1, -2 ), user::Private() };
+
+    endian_reverse_inplace( x[ 1 ] );
+
+    BOOST_TEST_EQ( x[ 1 ].id(), 0x04030201 );
+    BOOST_TEST_EQ( x[ 1 ].value(), 0x0807060504030201 );
+
+    endian_reverse_inplace_n( x, 4 );
+
+    BOOST_TEST_EQ( x[ 0 ].id(), 0x01000000 );
+    BOOST_TEST_EQ( x[ 0 ].value(), 0x0200000000000000 );
+    BOOST_TEST_EQ( x[ 1 ].id(), 0x01020304 );
+    BOOST_TEST_EQ( x[ 1 ].value(), 0x0102030405060708 );
+    BOOST_TEST_EQ( x[ 2 ].id(), -1 );
+    BOOST_TEST_EQ( x[ 2 ].value(), -0x0100000000000001 );
+    BOOST_TEST_EQ( x[ 3 ].id(), 0 );
+    BOOST_TEST_EQ( x[ 3 ].value(), 0 );
+}
+
+int main()
+{
+    BOOST_TEST( detail::endian_permutation_of<user::Mixed>().valid );
+    BOOST_TEST( detail::endian_permutation_of<user::Small>().valid );
+    BOOST_TEST( !detail::endian_permutation_of<user::WithCustom>().valid );
+
+    // built in fixed storage, so that the noexcept bulk functions cannot
+    // fail on first use
+
+    BOOST_TEST( noexcept( detail::endian_permutation_of<user::Mixed>() ) );
+
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test<user::Inner>();
+        test<user::Mixed>();
+        test<user::Small>();
+        test<user::WithCustom>();
+
+        test_private();
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,201 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+static std::size_t const sizes[] = { 0, 1, 2, 5, 8, 15, 16, 17, 33, 100 };
+
+template<class T, std::size_t N, order Order> void test_( std::size_t stride )
+{
+    std::size_t const offsets[] = { 0, 1, stride - N };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+
+        for( int j = 0; j < 3; ++j )
+        {
+            std::size_t const offset = offsets[ j ];
+
+            if( offset + N > stride )
+            {
+                continue;
+            }
+
+            // exactly n records, so that reading past the last field is
+            // caught by the sanitizers
+
+            std::vector<unsigned char> records( n * stride );
+
+            for( std::size_t i = 0; i < records.size(); ++i )
+            {
+                records[ i ] = static_cast<unsigned char>( i * 0x9D + 0x35 );
+            }
+
+            unsigned char none[ 64 ] = {};
+            unsigned char * const base = records.empty()? none: records.data();
+
+            T dst[ 101 ] = {};
+
+            endian_gather_n<T, N, Order>( base, stride, offset, dst, n );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                // compare the bits; some of the float values are NaNs
+
+                T const x = endian_load<T, N, Order>( base + i * stride + offset );
+                BOOST_TEST( std::memcmp( &dst[ i ], &x, sizeof(T) ) == 0 );
+            }
+
+            BOOST_TEST_EQ( dst[ n ], T() );
+
+            // store back, changed; the bytes around the fields must survive
+
+            std::vector<unsigned char> ref( records );
+
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                unsigned char * q = reinterpret_cast<unsigned char*>( &dst[ i ] );
+                q[ 0 ] = static_cast<unsigned char>( q[ 0 ] ^ ( i | 1 ) );
+
+                endian_store<T, N, Order>( ref.data() + i * stride + offset, dst[ i ] );
+            }
+
+            endian_scatter_n<T, N, Order>( dst, base, stride, offset, n );
+
+            BOOST_TEST( records == ref );
+        }
+    }
+}
+
+template<class T, std::size_t N> void test()
+{
+    std::size_t const strides[] = { N, N + 1, 8, 12, 16, 24, 64 };
+
+    for( int i = 0; i < 7; ++i )
+    {
+        if( strides[ i ] >= N )
+        {
+            test_<T, N, order::big>( strides[ i ] );
+            test_<T, N, order::little>( strides[ i ] );
+        }
+    }
+}
+
+template<class T> void test2()
+{
+    test<T, 1>();
+    test<T, 2>();
+}
+
+template<class T> void test4()
+{
+    test2<T>();
+    test<T, 3>();
+    test<T, 4>();
+}
+
+template<class T> void test8()
+{
+    test4<T>();
+    test<T, 5>();
+    test<T, 6>();
+    test<T, 7>();
+    test<T, 8>();
+}
+
+// a stride of zero reads the same field n times
+
+static void test_stride_zero()
+{
+    unsigned char const b[ 3 ] = { 0x80, 0x01, 0x02 };
+
+    boost::int32_t dst[ 20 ];
+
+    endian_gather_n<boost::int32_t, 3, order::big>( b, 0, 0, dst, 20 );
+
+    for( int i = 0; i < 20; ++i )
+    {
+        BOOST_TEST_EQ( dst[ i ], -0x7FFEFE );
+    }
+}
+
+// the id and balance fields of an array of
+//
+//     struct record { big_uint32_t id; big_int32_t balance; char name[ 20 ]; };
+
+static void test_records()
+{
+    std::size_t const stride = 28;
+    std::size_t const n = 50;
+
+    unsigned char records[ n * stride ];
+    std::memset( records, 'x', sizeof(records) );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        endian_store<boost::uint32_t, 4, order::big>( records + i * stride, static_cast<boost::uint32_t>( 1000 + i ) );
+        endian_store<boost::int32_t, 4, order::big>( records + i * stride + 4, static_cast<boost::int32_t>( 10 * i ) - 250 );
+    }
+
+    boost::uint32_t id[ n ];
+    boost::int32_t balance[ n ];
+
+    endian_gather_n<boost::uint32_t, 4, order::big>( records, stride, 0, id, n );
+    endian_gather_n<boost::int32_t, 4, order::big>( records, stride, 4, balance, n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( id[ i ], 1000 + i );
+        BOOST_TEST_EQ( balance[ i ], static_cast<boost::int32_t>( 10 * i ) - 250 );
+
+        balance[ i ] += 7;
+    }
+
+    endian_scatter_n<boost::int32_t, 4, order::big>( balance, records, stride, 4, n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( ( endian_load<boost::uint32_t, 4, order::big>( records + i * stride ) ), 1000 + i );
+        BOOST_TEST_EQ( ( endian_load<boost::int32_t, 4, order::big>( records + i * stride + 4 ) ), static_cast<boost::int32_t>( 10 * i ) - 243 );
+        BOOST_TEST_EQ( records[ i * stride + 8 ], 'x' );
+    }
+}
+
+int main()
+{
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test<boost::int8_t, 1>();
+        test<boost::uint8_t, 1>();
+
+        test2<boost::int16_t>();
+        test2<boost::uint16_t>();
+
+        test4<boost::int32_t>();
+        test4<boost::uint32_t>();
+
+        test8<boost::int64_t>();
+        test8<boost::uint64_t>();
+
+        test<float, 4>();
+        test<double, 8>();
+
+        test_stride_zero();
+        test_records();
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,215 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/lazy_array.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <system_error>
+#include <vector>
+
+using namespace boost::endian;
+
+template<class T> static T value( std::size_t i )
+{
+    return static_cast<T>( i * 0x9E3779B97F4A7C15ull + ( i >> 5 ) );
+}
+
+static void test_span()
+{
+    typedef lazy_native_array<order::big, boost::uint32_t> array_type;
+
+    std::size_t const n = array_type::page_size * 10 + 7;
+
+    std::vector<unsigned char> v( n * 4 );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        store_big_u32( &v[ i * 4 ], value<boost::uint32_t>( i ) );
+    }
+
+    array_type a( array_type::span_type( v.data(), n ) );
+
+    BOOST_TEST_EQ( a.size(), n );
+    BOOST_TEST_EQ( a.page_count(), 11u );
+    BOOST_TEST_EQ( a.converted_pages(), 0u );
+
+    // the first access converts one page
+
+    BOOST_TEST_EQ( a[ array_type::page_size * 3 + 5 ], value<boost::uint32_t>( array_type::page_size * 3 + 5 ) );
+    BOOST_TEST_EQ( a.converted_pages(), 1u );
+    BOOST_TEST( a.is_converted( array_type::page_size * 3 ) );
+    BOOST_TEST( !a.is_converted( array_type::page_size * 4 ) );
+
+    BOOST_TEST_EQ( a[ array_type::page_size * 3 ], value<boost::uint32_t>( array_type::page_size * 3 ) );
+    BOOST_TEST_EQ( a.converted_pages(), 1u );
+
+    // the last, partial page
+
+    BOOST_TEST_EQ( a[ n - 1 ], value<boost::uint32_t>( n - 1 ) );
+    BOOST_TEST_EQ( a.converted_pages(), 2u );
+
+    // a range across converted and unconverted pages
+
+    boost::uint32_t const * p = a.data( array_type::page_size * 2 + 1, array_type::page_size * 3 );
+
+    for( std::size_t i = 0; i < array_type::page_size * 3; ++i )
+    {
+        BOOST_TEST_EQ( p[ i ], value<boost::uint32_t>( array_type::page_size * 2 + 1 + i ) );
+    }
+
+    BOOST_TEST_EQ( a.converted_pages(), 5u );
+
+    // all of it
+
+    p = a.data( 0, n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( p[ i ], value<boost::uint32_t>( i ) );
+    }
+
+    BOOST_TEST_EQ( a.converted_pages(), a.page_count() );
+
+    // after the source changes
+
+    store_big_u32( &v[ 4 ], 0x01020304 );
+
+    BOOST_TEST_EQ( a[ 1 ], value<boost::uint32_t>( 1 ) );
+
+    a.reset();
+
+    BOOST_TEST_EQ( a.converted_pages(), 0u );
+    BOOST_TEST_EQ( a[ 1 ], 0x01020304u );
+}
+
+template<order Order, class T, std::size_t n_bits> static void test_type( std::size_t n )
+{
+    typedef lazy_native_array<Order, T, n_bits> array_type;
+
+    std::size_t const N = n_bits / 8;
+
+    std::vector<unsigned char> v( n * N );
+    std::vector<T> w( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        endian_store<T, N, Order>( &v[ i * N ], value<T>( i ) );
+        w[ i ] = endian_load<T, N, Order>( &v[ i * N ] );
+    }
+
+    array_type a( typename array_type::span_type( v.data(), n ) );
+
+    // every page from its last element down
+
+    for( std::size_t i = n; i > 0; --i )
+    {
+        BOOST_TEST_EQ( a[ i - 1 ], w[ i - 1 ] );
+    }
+
+    BOOST_TEST_EQ( a.converted_pages(), a.page_count() );
+}
+
+static void test_types()
+{
+    test_type<order::big, boost::uint16_t, 16>( 5000 );
+    test_type<order::little, boost::int32_t, 24>( 3000 );
+    test_type<order::big, boost::int64_t, 40>( 1000 );
+    test_type<order::little, boost::uint64_t, 64>( 1500 );
+    test_type<order::big, boost::uint8_t, 8>( 10000 );
+    test_type<order::native, boost::uint32_t, 32>( 2000 );
+}
+
+static void test_empty()
+{
+    lazy_native_array<order::big, boost::uint32_t> a;
+
+    BOOST_TEST( a.empty() );
+    BOOST_TEST_EQ( a.page_count(), 0u );
+
+    std::error_code ec;
+
+    BOOST_TEST( a.assign( lazy_native_array<order::big, boost::uint32_t>::span_type(), ec ) );
+    BOOST_TEST( !ec );
+    BOOST_TEST( a.empty() );
+    BOOST_TEST( a.data( 0, 0 ) == 0 );
+}
+
+#if defined(BOOST_ENDIAN_HAS_MMAP)
+
+static char const * const path = "endian_lazy_array_test.tmp";
+
+static void test_file()
+{
+    std::size_t const n = 100000;
+
+    {
+        std::vector<unsigned char> v( n * 8 + 3 );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            endian_store<double, 8, order::big>( &v[ i * 8 ], static_cast<double>( i ) / 8 );
+        }
+
+        std::FILE * f = std::fopen( path, "wb" );
+
+        BOOST_TEST( f != 0 );
+        if( f == 0 ) return;
+
+        BOOST_TEST_EQ( std::fwrite( v.data(), 1, v.size(), f ), v.size() );
+        std::fclose( f );
+    }
+
+    lazy_native_array<order::big, double> a( path );
+
+    BOOST_TEST_EQ( a.size(), n );
+
+    BOOST_TEST_EQ( a[ 77777 ], 77777.0 / 8 );
+    BOOST_TEST_EQ( a[ 12 ], 12.0 / 8 );
+    BOOST_TEST_EQ( a.converted_pages(), 2u );
+
+    a.close();
+
+    BOOST_TEST( a.empty() );
+
+    std::remove( path );
+
+    std::error_code ec;
+
+    BOOST_TEST( !a.open( path, ec ) );
+    BOOST_TEST( ec == std::errc::no_such_file_or_directory );
+
+    bool thrown = false;
+
+    try
+    {
+        lazy_native_array<order::big, double> b( path );
+    }
+    catch( std::system_error const & x )
+    {
+        thrown = true;
+        BOOST_TEST( x.code() == std::errc::no_such_file_or_directory );
+    }
+
+    BOOST_TEST( thrown );
+}
+
+#endif
+
+int main()
+{
+    test_span();
+    test_types();
+    test_empty();
+
+#if defined(BOOST_ENDIAN_HAS_MMAP)
+
+    test_file();
+
+#endif
+
+    return boost::report_errors();
+}
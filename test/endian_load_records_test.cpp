@@ -0,0 +1,130 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/record.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+struct id: endian_field<0, order::big, boost::uint32_t> {};
+struct stamp: endian_field<4, order::big, boost::int64_t> {};
+struct kind: endian_field<12, order::little, boost::uint16_t> {};
+struct value: endian_field<14, order::big, double> {};
+struct count: endian_field<22, order::big, boost::int32_t, 24> {};
+struct tag: endian_field<25, order::big, char> {};
+struct delta: endian_field<26, order::little, boost::int64_t, 40> {};
+
+// the fields are listed out of offset order
+
+typedef endian_layout<stamp, id, kind, value, count, tag, delta> event;
+
+// two bytes of trailing padding
+
+struct padded_event: event
+{
+    static const std::size_t size = 33;
+};
+
+const std::size_t padded_event::size;
+
+// one field
+
+struct sample: endian_field<0, order::big, float> {};
+
+typedef endian_layout<sample> samples;
+
+template<class Layout> static void test_event()
+{
+    // the sizes straddle the vector widths and the tile size
+
+    static std::size_t const sizes[] = { 0, 1, 2, 7, 8, 15, 16, 17, 100, 177, 178, 179, 400, 1000 };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+        std::size_t const R = Layout::size;
+
+        std::vector<unsigned char> b( n * R + 1 );
+
+        for( std::size_t i = 0; i < b.size(); ++i )
+        {
+            b[ i ] = static_cast<unsigned char>( i * 0x9D + 0x31 );
+        }
+
+        // one extra element, which must not be touched
+
+        std::vector<boost::int64_t> c0( n + 1, 5 );
+        std::vector<boost::uint32_t> c1( n + 1, 5 );
+        std::vector<boost::uint16_t> c2( n + 1, 5 );
+        std::vector<double> c3( n + 1, 5 );
+        std::vector<boost::int32_t> c4( n + 1, 5 );
+        std::vector<char> c5( n + 1, 5 );
+        std::vector<boost::int64_t> c6( n + 1, 5 );
+
+        endian_load_records<Layout>( b.data(), n, c0.data(), c1.data(), c2.data(), c3.data(), c4.data(), c5.data(), c6.data() );
+
+        endian_record_view<Layout const> r( b.data() );
+
+        for( std::size_t i = 0; i < n; ++i, r = r.next() )
+        {
+            BOOST_TEST_EQ( c0[ i ], r.template get<stamp>() );
+            BOOST_TEST_EQ( c1[ i ], r.template get<id>() );
+            BOOST_TEST_EQ( c2[ i ], r.template get<kind>() );
+            BOOST_TEST_EQ( c4[ i ], r.template get<count>() );
+            BOOST_TEST_EQ( c5[ i ], r.template get<tag>() );
+            BOOST_TEST_EQ( c6[ i ], r.template get<delta>() );
+
+            double v = r.template get<value>();
+            BOOST_TEST( std::memcmp( &c3[ i ], &v, sizeof(v) ) == 0 );
+        }
+
+        BOOST_TEST_EQ( c0[ n ], 5 );
+        BOOST_TEST_EQ( c1[ n ], 5u );
+        BOOST_TEST_EQ( c2[ n ], 5 );
+        BOOST_TEST_EQ( c3[ n ], 5 );
+        BOOST_TEST_EQ( c4[ n ], 5 );
+        BOOST_TEST_EQ( c5[ n ], 5 );
+        BOOST_TEST_EQ( c6[ n ], 5 );
+    }
+}
+
+static void test_samples()
+{
+    std::size_t const n = 300;
+
+    unsigned char b[ n * 4 ];
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        endian_store<float, 4, order::big>( b + i * 4, static_cast<float>( i ) * 0.5f );
+    }
+
+    float f[ n ];
+
+    endian_load_records<samples>( b, n, f );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST_EQ( f[ i ], static_cast<float>( i ) * 0.5f );
+    }
+}
+
+int main()
+{
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test_event<event>();
+        test_event<padded_event>();
+        test_samples();
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,224 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/mapped.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#if !defined(BOOST_ENDIAN_HAS_MMAP)
+
+int main()
+{
+    return 0;
+}
+
+#else
+
+using namespace boost::endian;
+
+static char const * const path = "endian_mapped_test.tmp";
+
+static void write_file( std::vector<unsigned char> const & v )
+{
+    std::FILE * f = std::fopen( path, "wb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return;
+
+    if( !v.empty() )
+    {
+        BOOST_TEST_EQ( std::fwrite( v.data(), 1, v.size(), f ), v.size() );
+    }
+
+    std::fclose( f );
+}
+
+static std::vector<unsigned char> read_file()
+{
+    std::vector<unsigned char> v;
+
+    std::FILE * f = std::fopen( path, "rb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return v;
+
+    int c;
+
+    while( ( c = std::fgetc( f ) ) != EOF )
+    {
+        v.push_back( static_cast<unsigned char>( c ) );
+    }
+
+    std::fclose( f );
+    return v;
+}
+
+static void test_read_only()
+{
+    // 1000 big endian 24-bit values, and two trailing bytes
+
+    std::vector<unsigned char> v( 3002 );
+
+    for( std::size_t i = 0; i < 1000; ++i )
+    {
+        store_big_s24( &v[ 3 * i ], static_cast<boost::int32_t>( i * 997 ) - 500000 );
+    }
+
+    write_file( v );
+
+    mapped_endian_array<order::big, boost::int32_t const, 24> a( path );
+
+    BOOST_TEST( a.is_open() );
+    BOOST_TEST_EQ( a.size(), 1000u );
+    BOOST_TEST_EQ( a.size_bytes(), 3000u );
+
+    BOOST_TEST_EQ( a[ 0 ], -500000 );
+    BOOST_TEST_EQ( a[ 999 ], 999 * 997 - 500000 );
+
+    BOOST_TEST( a.advise( map_advice::sequential ) );
+    BOOST_TEST( a.advise( map_advice::random, 10, 20 ) );
+    BOOST_TEST( a.advise( map_advice::willneed ) );
+    BOOST_TEST( a.advise( map_advice::hugepage ) );
+
+    std::vector<boost::int32_t> x( a.size() );
+    a.span().copy_to( x.data() );
+
+    std::size_t i = 0;
+
+    for( mapped_big_array<boost::int32_t const, 24>::iterator it = a.begin(); it != a.end(); ++it, ++i )
+    {
+        BOOST_TEST_EQ( *it, x[ i ] );
+    }
+
+    BOOST_TEST_EQ( i, 1000u );
+
+    a.close();
+
+    BOOST_TEST( !a.is_open() );
+    BOOST_TEST( a.empty() );
+}
+
+static void test_read_write()
+{
+    std::vector<unsigned char> v( 4 * 100 );
+
+    for( std::size_t i = 0; i < 100; ++i )
+    {
+        store_little_u32( &v[ 4 * i ], static_cast<boost::uint32_t>( i ) );
+    }
+
+    write_file( v );
+
+    {
+        mapped_little_array<boost::uint32_t> a( path );
+
+        BOOST_TEST_EQ( a.size(), 100u );
+
+        a[ 7 ] = 0x01020304;
+
+        std::vector<boost::uint32_t> x( 100, 0xAABBCCDD );
+        a.span().subspan( 50 ).assign_from( x.data() );
+
+        a.flush();
+    }
+
+    std::vector<unsigned char> const w = read_file();
+
+    BOOST_TEST_EQ( w.size(), 400u );
+    BOOST_TEST_EQ( load_little_u32( &w[ 4 * 6 ] ), 6u );
+    BOOST_TEST_EQ( load_little_u32( &w[ 4 * 7 ] ), 0x01020304u );
+    BOOST_TEST_EQ( load_little_u32( &w[ 4 * 49 ] ), 49u );
+    BOOST_TEST_EQ( load_little_u32( &w[ 4 * 99 ] ), 0xAABBCCDDu );
+}
+
+static void test_large()
+{
+    // large enough to be placed at a huge page boundary
+
+    std::size_t const n = ( std::size_t( 5 ) << 20 ) / 8 + 3;
+
+    std::vector<unsigned char> v( n * 8 );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        store_big_u64( &v[ 8 * i ], i * 0x9E3779B97F4A7C15ull );
+    }
+
+    write_file( v );
+
+    mapped_endian_array<order::big, boost::uint64_t const> a( path );
+
+    BOOST_TEST_EQ( a.size(), n );
+    BOOST_TEST_EQ( reinterpret_cast<std::size_t>( a.data() ) % ( std::size_t( 1 ) << 21 ), 0u );
+
+    BOOST_TEST_EQ( a[ 0 ], 0u );
+    BOOST_TEST_EQ( a[ n - 1 ], ( n - 1 ) * 0x9E3779B97F4A7C15ull );
+
+    BOOST_TEST( a.advise( map_advice::hugepage ) );
+    BOOST_TEST( a.advise( map_advice::dontneed, n / 2, n ) );
+
+    // still readable after dontneed; the pages are read back from the file
+
+    BOOST_TEST_EQ( a[ n - 2 ], ( n - 2 ) * 0x9E3779B97F4A7C15ull );
+}
+
+static void test_errors()
+{
+    write_file( std::vector<unsigned char>() );
+
+    {
+        mapped_endian_array<order::big, boost::uint16_t const> a( path );
+
+        BOOST_TEST( a.is_open() );
+        BOOST_TEST( a.empty() );
+        BOOST_TEST( a.begin() == a.end() );
+        BOOST_TEST( a.advise( map_advice::sequential ) );
+    }
+
+    std::remove( path );
+
+    {
+        std::error_code ec;
+        mapped_endian_array<order::big, boost::uint16_t const> a( path, ec );
+
+        BOOST_TEST( !a.is_open() );
+        BOOST_TEST( ec == std::errc::no_such_file_or_directory );
+    }
+
+    {
+        bool thrown = false;
+
+        try
+        {
+            mapped_endian_array<order::big, boost::uint16_t> a( path );
+        }
+        catch( std::system_error const & x )
+        {
+            thrown = true;
+            BOOST_TEST( x.code() == std::errc::no_such_file_or_directory );
+        }
+
+        BOOST_TEST( thrown );
+    }
+}
+
+int main()
+{
+    test_read_only();
+    test_read_write();
+    test_large();
+    test_errors();
+
+    std::remove( path );
+
+    return boost::report_errors();
+}
+
+#endif
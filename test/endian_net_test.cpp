@@ -0,0 +1,418 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/net.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+using namespace boost::endian::net;
+
+typedef std::vector<unsigned char> packet;
+
+static void put16( packet & p, std::size_t k, unsigned v )
+{
+    endian_store<boost::uint16_t, 2, order::big>( &p[ k ], static_cast<boost::uint16_t>( v ) );
+}
+
+static void put32( packet & p, std::size_t k, boost::uint32_t v )
+{
+    endian_store<boost::uint32_t, 4, order::big>( &p[ k ], v );
+}
+
+// Ethernet, with the given VLAN tags
+
+static std::size_t ethernet( packet & p, boost::uint16_t type, std::size_t tags = 0, boost::uint16_t tpid = ether_type::vlan )
+{
+    p.assign( 14 + tags * 4, 0 );
+
+    for( std::size_t i = 0; i < 12; ++i )
+    {
+        p[ i ] = static_cast<unsigned char>( 0x10 + i );
+    }
+
+    std::size_t k = 12;
+
+    for( std::size_t i = 0; i < tags; ++i, k += 4 )
+    {
+        put16( p, k, i == 0? tpid: ether_type::vlan );
+        put16( p, k + 2, 0xA000 | ( 100 + i ) ); // priority 5, VLAN 100 + i
+    }
+
+    put16( p, k, type );
+    return k + 2;
+}
+
+static std::size_t ipv4( packet & p, std::size_t k, boost::uint8_t protocol, std::size_t options = 0, unsigned fragment = 0x4000 )
+{
+    p.resize( k + 20 + options );
+
+    p[ k ] = static_cast<unsigned char>( 0x40 | ( 5 + options / 4 ) );
+    p[ k + 1 ] = 0xB8;
+    put16( p, k + 6, fragment );
+    p[ k + 8 ] = 64;
+    p[ k + 9 ] = protocol;
+    put32( p, k + 12, 0xC0A80001 );
+    put32( p, k + 16, 0x0A000002 );
+
+    return k + 20 + options;
+}
+
+static std::size_t ipv6( packet & p, std::size_t k, boost::uint8_t next )
+{
+    p.resize( k + 40 );
+
+    put32( p, k, 0x6ABCDEF1 );
+    p[ k + 6 ] = next;
+    p[ k + 7 ] = 32;
+
+    for( std::size_t i = 0; i < 32; ++i )
+    {
+        p[ k + 8 + i ] = static_cast<unsigned char>( i );
+    }
+
+    return k + 40;
+}
+
+static std::size_t udp( packet & p, std::size_t k )
+{
+    p.resize( k + 8 );
+
+    put16( p, k, 5353 );
+    put16( p, k + 2, 53 );
+    put16( p, k + 4, 8 );
+
+    return k + 8;
+}
+
+static std::size_t tcp( packet & p, std::size_t k, std::size_t options = 0 )
+{
+    p.resize( k + 20 + options );
+
+    put16( p, k, 44321 );
+    put16( p, k + 2, 443 );
+    put32( p, k + 4, 0x01020304 );
+    put16( p, k + 12, ( ( 5 + options / 4 ) << 12 ) | tcp_flags::syn | tcp_flags::ack | tcp_flags::ns );
+
+    return k + 20 + options;
+}
+
+static void finish( packet & p, std::size_t l3, std::size_t payload )
+{
+    p.resize( p.size() + payload, 0xEE );
+
+    if( p[ l3 ] >> 4 == 4 )
+    {
+        put16( p, l3 + 2, static_cast<unsigned>( p.size() - l3 ) );
+    }
+    else
+    {
+        put16( p, l3 + 4, static_cast<unsigned>( p.size() - l3 - 40 ) );
+    }
+}
+
+static void test_headers()
+{
+    packet p;
+
+    std::size_t k = ethernet( p, ether_type::ipv4, 1 );
+    std::size_t m = ipv4( p, k, ip_protocol::tcp, 4 );
+    tcp( p, m, 12 );
+
+    ethernet_header const & e = *reinterpret_cast<ethernet_header const*>( &p[ 0 ] );
+    vlan_tag const & v = *reinterpret_cast<vlan_tag const*>( &p[ 14 ] );
+    ipv4_header const & h = *reinterpret_cast<ipv4_header const*>( &p[ k ] );
+    tcp_header const & t = *reinterpret_cast<tcp_header const*>( &p[ m ] );
+
+    BOOST_TEST_EQ( e.ether_type.value(), ether_type::vlan );
+    BOOST_TEST_EQ( e.source[ 0 ], 0x16 );
+
+    BOOST_TEST_EQ( v.pcp(), 5 );
+    BOOST_TEST( !v.dei() );
+    BOOST_TEST_EQ( v.vid(), 100 );
+    BOOST_TEST_EQ( v.ether_type.value(), ether_type::ipv4 );
+
+    BOOST_TEST_EQ( h.version(), 4 );
+    BOOST_TEST_EQ( h.ihl(), 6 );
+    BOOST_TEST_EQ( h.header_length(), 24u );
+    BOOST_TEST_EQ( h.dscp(), 46 );
+    BOOST_TEST_EQ( h.ecn(), 0 );
+    BOOST_TEST( h.dont_fragment() );
+    BOOST_TEST( !h.more_fragments() );
+    BOOST_TEST_EQ( h.fragment_offset(), 0 );
+    BOOST_TEST_EQ( h.ttl.value(), 64 );
+    BOOST_TEST_EQ( h.source.value(), 0xC0A80001u );
+
+    BOOST_TEST_EQ( t.source_port.value(), 44321 );
+    BOOST_TEST_EQ( t.sequence_number.value(), 0x01020304u );
+    BOOST_TEST_EQ( t.data_offset(), 8 );
+    BOOST_TEST_EQ( t.header_length(), 32u );
+    BOOST_TEST_EQ( t.flags(), tcp_flags::syn | tcp_flags::ack | tcp_flags::ns );
+
+    ipv6( p, 14, ip_protocol::udp );
+
+    ipv6_header const & h6 = *reinterpret_cast<ipv6_header const*>( &p[ 14 ] );
+
+    BOOST_TEST_EQ( h6.version(), 6 );
+    BOOST_TEST_EQ( h6.traffic_class(), 0xAB );
+    BOOST_TEST_EQ( h6.flow_label(), 0xCDEF1u );
+    BOOST_TEST_EQ( h6.hop_limit.value(), 32 );
+    BOOST_TEST_EQ( h6.destination[ 15 ], 31 );
+}
+
+struct expected
+{
+    boost::uint16_t l3, l4, payload, type, vlan;
+    boost::uint8_t version, protocol;
+    boost::uint16_t sport, dport, flags;
+};
+
+static void check( packet_burst const & b, std::size_t i, expected const & x )
+{
+    BOOST_TEST_EQ( b.l3_offset[ i ], x.l3 );
+    BOOST_TEST_EQ( b.l4_offset[ i ], x.l4 );
+    BOOST_TEST_EQ( b.payload_offset[ i ], x.payload );
+    BOOST_TEST_EQ( b.ether_type[ i ], x.type );
+    BOOST_TEST_EQ( b.vlan_id[ i ], x.vlan );
+    BOOST_TEST_EQ( b.ip_version[ i ], x.version );
+    BOOST_TEST_EQ( b.protocol[ i ], x.protocol );
+    BOOST_TEST_EQ( b.source_port[ i ], x.sport );
+    BOOST_TEST_EQ( b.destination_port[ i ], x.dport );
+    BOOST_TEST_EQ( b.tcp_flags[ i ], x.flags );
+}
+
+static void test_burst()
+{
+    std::vector<packet> v;
+    std::vector<expected> x;
+
+    packet p;
+    std::size_t k, m;
+
+    // IPv4 UDP
+
+    k = ethernet( p, ether_type::ipv4 );
+    m = ipv4( p, k, ip_protocol::udp );
+    udp( p, m );
+    finish( p, k, 10 );
+
+    v.push_back( p );
+    expected x0 = { 14, 34, 42, ether_type::ipv4, 0, 4, ip_protocol::udp, 5353, 53, 0 };
+    x.push_back( x0 );
+
+    // VLAN, IPv4 with options, TCP with options
+
+    k = ethernet( p, ether_type::ipv4, 1 );
+    m = ipv4( p, k, ip_protocol::tcp, 8 );
+    tcp( p, m, 12 );
+    finish( p, k, 100 );
+
+    v.push_back( p );
+    expected x1 = { 18, 46, 78, ether_type::ipv4, 100, 4, ip_protocol::tcp, 44321, 443, tcp_flags::syn | tcp_flags::ack | tcp_flags::ns };
+    x.push_back( x1 );
+
+    // QinQ, IPv6 TCP
+
+    k = ethernet( p, ether_type::ipv6, 2, ether_type::qinq );
+    m = ipv6( p, k, ip_protocol::tcp );
+    tcp( p, m );
+    finish( p, k, 0 );
+
+    v.push_back( p );
+    expected x2 = { 22, 62, 82, ether_type::ipv6, 100, 6, ip_protocol::tcp, 44321, 443, tcp_flags::syn | tcp_flags::ack | tcp_flags::ns };
+    x.push_back( x2 );
+
+    // IPv6 ICMPv6; no transport header
+
+    k = ethernet( p, ether_type::ipv6 );
+    m = ipv6( p, k, ip_protocol::icmpv6 );
+    finish( p, k, 8 );
+
+    v.push_back( p );
+    expected x3 = { 14, 0, 0, ether_type::ipv6, 0, 6, ip_protocol::icmpv6, 0, 0, 0 };
+    x.push_back( x3 );
+
+    // a later IPv4 fragment; no transport header
+
+    k = ethernet( p, ether_type::ipv4 );
+    m = ipv4( p, k, ip_protocol::udp, 0, 0x00B9 );
+    udp( p, m );
+
+    v.push_back( p );
+    expected x4 = { 14, 0, 0, ether_type::ipv4, 0, 4, ip_protocol::udp, 0, 0, 0 };
+    x.push_back( x4 );
+
+    // truncated TCP header
+
+    k = ethernet( p, ether_type::ipv4 );
+    m = ipv4( p, k, ip_protocol::tcp );
+    tcp( p, m );
+    p.resize( p.size() - 1 );
+
+    v.push_back( p );
+    expected x5 = { 14, 0, 0, ether_type::ipv4, 0, 4, ip_protocol::tcp, 0, 0, 0 };
+    x.push_back( x5 );
+
+    // TCP data offset past the end
+
+    k = ethernet( p, ether_type::ipv4 );
+    m = ipv4( p, k, ip_protocol::tcp );
+    tcp( p, m, 4 );
+    p.resize( p.size() - 1 );
+
+    v.push_back( p );
+    x.push_back( x5 );
+
+    // IHL below 5
+
+    k = ethernet( p, ether_type::ipv4 );
+    ipv4( p, k, ip_protocol::udp );
+    p[ k ] = 0x44;
+
+    v.push_back( p );
+    expected x7 = { 0, 0, 0, ether_type::ipv4, 0, 0, 0, 0, 0, 0 };
+    x.push_back( x7 );
+
+    // ARP
+
+    k = ethernet( p, ether_type::arp );
+    p.resize( k + 28 );
+
+    v.push_back( p );
+    expected x8 = { 0, 0, 0, ether_type::arp, 0, 0, 0, 0, 0, 0 };
+    x.push_back( x8 );
+
+    // truncated VLAN tag, and truncated Ethernet header
+
+    ethernet( p, ether_type::ipv4, 1 );
+    p.resize( 16 );
+
+    v.push_back( p );
+    expected x9 = { 0, 0, 0, ether_type::vlan, 0, 0, 0, 0, 0, 0 };
+    x.push_back( x9 );
+
+    p.resize( 13 );
+
+    v.push_back( p );
+    expected x10 = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    x.push_back( x10 );
+
+    // repeat the above past the capacity of a burst
+
+    std::size_t const n0 = v.size();
+
+    while( v.size() < 100 )
+    {
+        v.push_back( v[ v.size() % n0 ] );
+        x.push_back( x[ x.size() % n0 ] );
+    }
+
+    std::vector<unsigned char const*> ptrs( v.size() );
+    std::vector<std::size_t> lengths( v.size() );
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        ptrs[ i ] = v[ i ].data();
+        lengths[ i ] = v[ i ].size();
+    }
+
+    packet_burst b;
+
+    std::size_t r = parse_burst( ptrs.data(), lengths.data(), v.size(), b );
+
+    BOOST_TEST_EQ( r, 64u );
+    BOOST_TEST_EQ( b.size, 64u );
+
+    for( std::size_t i = 0; i < r; ++i )
+    {
+        check( b, i, x[ i ] );
+    }
+
+    r = parse_burst( ptrs.data() + 64, lengths.data() + 64, v.size() - 64, b );
+
+    BOOST_TEST_EQ( r, 36u );
+
+    for( std::size_t i = 0; i < r; ++i )
+    {
+        check( b, i, x[ 64 + i ] );
+    }
+}
+
+static void test_columns()
+{
+    packet p;
+
+    std::size_t k = ethernet( p, ether_type::ipv4 );
+    std::size_t m = ipv4( p, k, ip_protocol::udp );
+    udp( p, m );
+    finish( p, k, 50 );
+
+    unsigned char const * q = p.data();
+    std::size_t n = p.size();
+
+    packet_burst b;
+    parse_burst( &q, &n, 1, b );
+
+    BOOST_TEST_EQ( b.ttl[ 0 ], 64u );
+    BOOST_TEST_EQ( b.ip_length[ 0 ], 78 );
+    BOOST_TEST_EQ( b.source_ipv4[ 0 ], 0xC0A80001u );
+    BOOST_TEST_EQ( b.destination_ipv4[ 0 ], 0x0A000002u );
+
+    k = ethernet( p, ether_type::ipv6 );
+    m = ipv6( p, k, ip_protocol::udp );
+    udp( p, m );
+    finish( p, k, 50 );
+
+    q = p.data();
+    n = p.size();
+
+    parse_burst( &q, &n, 1, b );
+
+    BOOST_TEST_EQ( b.ttl[ 0 ], 32u );
+    BOOST_TEST_EQ( b.ip_length[ 0 ], 98 );
+    BOOST_TEST_EQ( b.source_ipv4[ 0 ], 0u );
+
+    // the largest IPv6 payload length, with the header
+
+    put16( p, k + 4, 0xFFFF );
+
+    parse_burst( &q, &n, 1, b );
+
+    BOOST_TEST_EQ( b.ip_length[ 0 ], 0xFFFFu + 40 );
+
+    // a frame larger than 64 KB, as captured with GRO or TSO
+
+    k = ethernet( p, ether_type::ipv4, 1 );
+    m = ipv4( p, k, ip_protocol::tcp );
+    tcp( p, m );
+    p.resize( 100000, 0xEE );
+
+    q = p.data();
+    n = p.size();
+
+    parse_burst( &q, &n, 1, b );
+
+    BOOST_TEST_EQ( b.vlan_id[ 0 ], 100u );
+    BOOST_TEST_EQ( b.l3_offset[ 0 ], 18u );
+    BOOST_TEST_EQ( b.l4_offset[ 0 ], 38u );
+    BOOST_TEST_EQ( b.payload_offset[ 0 ], 58u );
+    BOOST_TEST_EQ( b.ip_version[ 0 ], 4u );
+    BOOST_TEST_EQ( b.protocol[ 0 ], ip_protocol::tcp );
+    BOOST_TEST_EQ( b.source_ipv4[ 0 ], 0xC0A80001u );
+    BOOST_TEST_EQ( b.source_port[ 0 ], 44321u );
+    BOOST_TEST_EQ( b.destination_port[ 0 ], 443u );
+}
+
+int main()
+{
+    test_headers();
+    test_burst();
+    test_columns();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,386 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/pipeline.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(BOOST_ENDIAN_HAS_PIPELINE)
+
+int main()
+{
+    return 0;
+}
+
+#else
+
+using namespace boost::endian;
+
+static char const * const src_path = "endian_pipeline_test.src.tmp";
+static char const * const dst_path = "endian_pipeline_test.dst.tmp";
+
+static void write_file( char const * path, std::vector<unsigned char> const & v )
+{
+    std::FILE * f = std::fopen( path, "wb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return;
+
+    if( !v.empty() )
+    {
+        BOOST_TEST_EQ( std::fwrite( v.data(), 1, v.size(), f ), v.size() );
+    }
+
+    std::fclose( f );
+}
+
+static std::vector<unsigned char> read_file( char const * path )
+{
+    std::vector<unsigned char> v;
+
+    std::FILE * f = std::fopen( path, "rb" );
+
+    BOOST_TEST( f != 0 );
+    if( f == 0 ) return v;
+
+    unsigned char t[ 4096 ];
+
+    for( std::size_t n; ( n = std::fread( t, 1, sizeof(t), f ) ) != 0; )
+    {
+        v.insert( v.end(), t, t + n );
+    }
+
+    std::fclose( f );
+    return v;
+}
+
+static std::vector<unsigned char> make_data( std::size_t n )
+{
+    std::vector<unsigned char> v( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        v[ i ] = static_cast<unsigned char>( i * 7 + ( i >> 8 ) );
+    }
+
+    return v;
+}
+
+// the reversal of each whole N-byte value; trailing bytes unchanged
+
+static std::vector<unsigned char> reversed( std::vector<unsigned char> v, std::size_t N )
+{
+    for( std::size_t i = 0; i + N <= v.size(); i += N )
+    {
+        for( std::size_t j = 0; j < N / 2; ++j )
+        {
+            unsigned char t = v[ i + j ];
+            v[ i + j ] = v[ i + N - 1 - j ];
+            v[ i + N - 1 - j ] = t;
+        }
+    }
+
+    return v;
+}
+
+template<class T> static void test_convert( std::size_t size, std::size_t buffer_bytes, unsigned buffers, bool io_uring )
+{
+    std::vector<unsigned char> const v = make_data( size );
+    write_file( src_path, v );
+
+    pipeline_options opt;
+
+    opt.buffer_bytes = buffer_bytes;
+    opt.buffers = buffers;
+    opt.io_uring = io_uring;
+    opt.parallel.threads = 2;
+
+    std::error_code ec;
+
+    boost::uint64_t const n = pipeline_convert_file<order::big, order::little, T>( src_path, dst_path, opt, ec );
+
+    BOOST_TEST( !ec );
+    BOOST_TEST_EQ( n, size );
+    BOOST_TEST( read_file( dst_path ) == reversed( v, sizeof(T) ) );
+
+    // no conversion between equal orders
+
+    pipeline_convert_file<order::big, order::big, T>( src_path, dst_path, opt );
+
+    BOOST_TEST( read_file( dst_path ) == v );
+}
+
+static void test_backends()
+{
+    for( int k = 0; k < 2; ++k )
+    {
+        bool const io_uring = k == 0;
+
+        // empty, smaller than a buffer, and many buffers with a tail
+
+        test_convert<boost::uint32_t>( 0, 4096, 4, io_uring );
+        test_convert<boost::uint32_t>( 3, 4096, 4, io_uring );
+        test_convert<boost::uint32_t>( 1000, 4096, 4, io_uring );
+        test_convert<boost::uint64_t>( 100000 + 5, 4096, 4, io_uring );
+        test_convert<boost::uint16_t>( 100001, 100, 2, io_uring );
+        test_convert<boost::int32_t>( 1 << 20, 65536, 8, io_uring );
+
+        // a buffer smaller than a value holds one value
+
+        test_convert<boost::uint64_t>( 800, 1, 3, io_uring );
+    }
+}
+
+static void test_fd()
+{
+    std::vector<unsigned char> const v = make_data( 40000 );
+    write_file( src_path, v );
+
+    std::FILE * in = std::fopen( src_path, "rb" );
+    std::FILE * out = std::fopen( dst_path, "wb" );
+
+    BOOST_TEST( in != 0 && out != 0 );
+    if( in == 0 || out == 0 ) return;
+
+    pipeline_options opt;
+    opt.buffer_bytes = 1024;
+
+    BOOST_TEST_EQ( ( pipeline_convert<order::little, order::big, boost::uint32_t>( fileno( in ), fileno( out ), opt ) ), 40000u );
+
+    std::fclose( in );
+    std::fclose( out );
+
+    BOOST_TEST( read_file( dst_path ) == reversed( v, 4 ) );
+}
+
+static void test_errors()
+{
+    write_file( src_path, make_data( 1000 ) );
+
+    for( int k = 0; k < 2; ++k )
+    {
+        pipeline_options opt;
+
+        opt.buffer_bytes = 64;
+        opt.io_uring = k == 0;
+
+        // not open for writing
+
+        std::FILE * in = std::fopen( src_path, "rb" );
+        std::FILE * out = std::fopen( src_path, "rb" );
+
+        BOOST_TEST( in != 0 && out != 0 );
+        if( in == 0 || out == 0 ) return;
+
+        std::error_code ec;
+        pipeline_convert<order::big, order::little, boost::uint32_t>( fileno( in ), fileno( out ), opt, ec );
+
+        BOOST_TEST( ec == std::errc::bad_file_descriptor );
+
+        std::fclose( in );
+        std::fclose( out );
+    }
+
+    {
+        std::error_code ec;
+        pipeline_convert<order::big, order::little, boost::uint32_t>( -1, -1, pipeline_options(), ec );
+
+        BOOST_TEST( ec == std::errc::bad_file_descriptor );
+    }
+
+    {
+        // not a regular file
+
+        int fd[ 2 ];
+
+        BOOST_TEST_EQ( ::pipe( fd ), 0 );
+
+        std::error_code ec;
+        pipeline_convert<order::big, order::little, boost::uint32_t>( fd[ 0 ], fd[ 1 ], pipeline_options(), ec );
+
+        BOOST_TEST( ec == std::errc::invalid_seek );
+
+        ::close( fd[ 0 ] );
+        ::close( fd[ 1 ] );
+    }
+
+    std::remove( src_path );
+
+    {
+        std::error_code ec;
+        pipeline_convert_file<order::big, order::little, boost::uint32_t>( src_path, dst_path, pipeline_options(), ec );
+
+        BOOST_TEST( ec == std::errc::no_such_file_or_directory );
+    }
+
+    {
+        bool thrown = false;
+
+        try
+        {
+            pipeline_convert_file<order::big, order::little, boost::uint32_t>( src_path, dst_path );
+        }
+        catch( std::system_error const & x )
+        {
+            thrown = true;
+            BOOST_TEST( x.code() == std::errc::no_such_file_or_directory );
+        }
+
+        BOOST_TEST( thrown );
+    }
+}
+
+#if defined(BOOST_ENDIAN_HAS_IO_URING)
+
+// A ring that fails two submits in three with EAGAIN or EBUSY, keeping the
+// entries it did not take, and transfers half of each read or write
+
+struct busy_ring
+{
+    struct op
+    {
+        bool write;
+        int fd;
+        void * p;
+        std::size_t n;
+        unsigned long long offset;
+        unsigned long long user_data;
+    };
+
+    std::vector<op> queued;
+    std::deque< std::pair<unsigned long long, int> > completed;
+
+    unsigned calls;
+    unsigned busy;
+
+    busy_ring(): calls( 0 ), busy( 0 )
+    {
+    }
+
+    void prepare( bool write, int fd, void * p, std::size_t n, unsigned long long offset, unsigned long long user_data )
+    {
+        op const o = { write, fd, p, n, offset, user_data };
+        queued.push_back( o );
+    }
+
+    int submit( unsigned = 0 )
+    {
+        if( ++calls % 3 != 0 )
+        {
+            ++busy;
+            return calls % 3 == 1? EAGAIN: EBUSY;
+        }
+
+        for( std::size_t i = 0; i < queued.size(); ++i )
+        {
+            op const & o = queued[ i ];
+
+            std::size_t const n = ( o.n + 1 ) / 2;
+
+            ssize_t const r = o.write?
+                ::pwrite( o.fd, o.p, n, static_cast<off_t>( o.offset ) ):
+                ::pread( o.fd, o.p, n, static_cast<off_t>( o.offset ) );
+
+            completed.push_back( std::make_pair( o.user_data, r < 0? -errno: static_cast<int>( r ) ) );
+        }
+
+        queued.clear();
+        return 0;
+    }
+
+    bool complete( unsigned long long & user_data, int & res )
+    {
+        if( completed.empty() ) return false;
+
+        user_data = completed.front().first;
+        res = completed.front().second;
+
+        completed.pop_front();
+        return true;
+    }
+};
+
+static void test_busy_ring()
+{
+    std::vector<unsigned char> const v = make_data( 1000 );
+
+    write_file( src_path, v );
+    write_file( dst_path, std::vector<unsigned char>() );
+
+    std::FILE * in = std::fopen( src_path, "rb" );
+    std::FILE * out = std::fopen( dst_path, "wb" );
+
+    BOOST_TEST( in != 0 && out != 0 );
+    if( in == 0 || out == 0 ) return;
+
+    std::vector<unsigned char> storage( 3 * 64 );
+
+    detail::pipeline_state s;
+
+    s.src = fileno( in );
+    s.dst = fileno( out );
+    s.size = v.size();
+    s.buffer_bytes = 64;
+    s.written = 0;
+
+    s.buffers.resize( 3 );
+
+    for( std::size_t i = 0; i < 3; ++i )
+    {
+        detail::pipeline_buffer & b = s.buffers[ i ];
+
+        b.p = storage.data() + i * 64;
+        b.offset = 0;
+        b.size = 0;
+        b.done = 0;
+        b.state = detail::pipeline_buffer::idle;
+    }
+
+    parallel_options popt;
+    detail::pipeline_converter<order::big, order::little, boost::uint32_t> const convert = { &popt };
+
+    busy_ring ring;
+    bool abandoned = false;
+
+    BOOST_TEST_EQ( detail::pipeline_run_ring( ring, s, convert, abandoned ), 0 );
+    BOOST_TEST( !abandoned );
+    BOOST_TEST( ring.busy > 0 );
+    BOOST_TEST_EQ( s.written, v.size() );
+
+    std::fclose( in );
+    std::fclose( out );
+
+    BOOST_TEST( read_file( dst_path ) == reversed( v, 4 ) );
+}
+
+#endif
+
+int main()
+{
+    test_backends();
+    test_fd();
+    test_errors();
+
+#if defined(BOOST_ENDIAN_HAS_IO_URING)
+
+    test_busy_ring();
+
+#endif
+
+    std::remove( src_path );
+    std::remove( dst_path );
+
+    return boost::report_errors();
+}
+
+#endif
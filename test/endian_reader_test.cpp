@@ -0,0 +1,213 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/reader.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <vector>
+
+using namespace boost::endian;
+
+static void test_read()
+{
+    unsigned char const b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B };
+
+    endian_reader r( b, b + sizeof(b) );
+
+    BOOST_TEST( r );
+    BOOST_TEST_EQ( r.size(), 11u );
+
+    BOOST_TEST_EQ( r.read<big_uint16_t>(), 0x0102 );
+    BOOST_TEST_EQ( r.read<little_uint32_buf_t>(), 0x06050403u );
+    BOOST_TEST_EQ( r.read<big_uint24_t>(), 0x070809u );
+
+    BOOST_TEST_EQ( r.position(), 9u );
+    BOOST_TEST_EQ( r.size(), 2u );
+    BOOST_TEST( r.data() == b + 9 );
+
+    BOOST_TEST( r.skip( 1 ) );
+    BOOST_TEST_EQ( r.read<big_int8_t>(), 0x0B );
+
+    BOOST_TEST( r );
+    BOOST_TEST( r.empty() );
+
+    // past the end; the failure is sticky
+
+    BOOST_TEST_EQ( r.read<big_uint8_t>(), 0 );
+    BOOST_TEST( !r );
+    BOOST_TEST( r.failed() );
+}
+
+static void test_failure()
+{
+    unsigned char const b[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+
+    {
+        endian_reader r( b, sizeof(b) );
+
+        BOOST_TEST_EQ( r.read<big_uint32_t>(), 0x01020304u );
+
+        // four bytes are needed and two are left; nothing is consumed
+
+        BOOST_TEST_EQ( r.read<big_uint32_t>(), 0u );
+        BOOST_TEST( !r );
+
+        // the two bytes left are no longer readable
+
+        BOOST_TEST_EQ( r.read<big_uint16_t>(), 0 );
+        BOOST_TEST( r.failed() );
+        BOOST_TEST_EQ( r.size(), 0u );
+    }
+
+    {
+        endian_reader r( b, sizeof(b) );
+
+        BOOST_TEST( !r.skip( 7 ) );
+        BOOST_TEST( !r );
+    }
+
+    {
+        endian_reader r( b, sizeof(b) );
+
+        boost::uint16_t v[ 4 ] = {};
+
+        BOOST_TEST( !r.read_n<big_uint16_t>( v, 4 ) );
+        BOOST_TEST( !r );
+    }
+
+    {
+        endian_reader r( b, sizeof(b) );
+
+        BOOST_TEST( !r.reserve( 7 ) );
+        BOOST_TEST( !r );
+    }
+
+    {
+        // a count whose size in bytes would overflow
+
+        endian_reader r( b, sizeof(b) );
+
+        boost::uint64_t v = 0;
+
+        BOOST_TEST( !r.read_n<big_uint64_t>( &v, ~static_cast<std::size_t>( 0 ) / 4 ) );
+        BOOST_TEST( !r );
+    }
+
+    {
+        endian_reader r;
+
+        BOOST_TEST( r );
+        BOOST_TEST( r.empty() );
+
+        BOOST_TEST_EQ( r.read<big_uint8_t>(), 0 );
+        BOOST_TEST( !r );
+    }
+}
+
+static void test_read_n()
+{
+    std::vector<unsigned char> b( 1003 );
+
+    for( std::size_t i = 0; i < b.size(); ++i )
+    {
+        b[ i ] = static_cast<unsigned char>( i * 0x9D + 1 );
+    }
+
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        endian_reader r( b.data(), b.size() );
+
+        BOOST_TEST_EQ( r.read<big_uint8_t>(), b[ 0 ] );
+
+        std::vector<boost::int32_t> v( 250 );
+        BOOST_TEST( r.read_n<big_int32_t>( v.data(), v.size() ) );
+
+        for( std::size_t i = 0; i < v.size(); ++i )
+        {
+            BOOST_TEST_EQ( v[ i ], load_big_s32( b.data() + 1 + 4 * i ) );
+        }
+
+        std::vector<boost::uint16_t> w( 1 );
+        BOOST_TEST( r.read_n<little_uint16_t>( w.data(), 1 ) );
+        BOOST_TEST_EQ( w[ 0 ], load_little_u16( b.data() + 1001 ) );
+
+        BOOST_TEST( r.empty() );
+        BOOST_TEST( r );
+    }
+}
+
+static void test_reserve()
+{
+    // records of a 2-byte tag, a 4-byte length and a 24-bit value
+
+    std::vector<unsigned char> b( 9 * 100 + 5 );
+
+    for( std::size_t i = 0; i < 100; ++i )
+    {
+        store_big_u16( &b[ 9 * i ], static_cast<boost::uint16_t>( i ) );
+        store_little_u32( &b[ 9 * i + 2 ], static_cast<boost::uint32_t>( i * 1000 ) );
+        store_big_s24( &b[ 9 * i + 6 ], -static_cast<boost::int32_t>( i ) );
+    }
+
+    for( int k = 0; k < 2; ++k )
+    {
+        read_hint const hint = k == 0? read_hint::normal: read_hint::prefetch;
+
+        endian_reader r( b.data(), b.size() );
+
+        std::size_t i = 0;
+
+        while( endian_block_reader c = r.reserve( 9, hint ) )
+        {
+            BOOST_TEST_EQ( c.size(), 9u );
+
+            BOOST_TEST_EQ( c.read<big_uint16_t>(), i );
+            BOOST_TEST_EQ( c.read<little_uint32_t>(), i * 1000 );
+            BOOST_TEST_EQ( c.read<big_int24_t>(), -static_cast<boost::int32_t>( i ) );
+
+            BOOST_TEST_EQ( c.size(), 0u );
+
+            ++i;
+        }
+
+        BOOST_TEST_EQ( i, 100u );
+
+        // the last reserve failed, with 5 bytes left
+
+        BOOST_TEST( !r );
+        BOOST_TEST_EQ( r.position(), b.size() );
+    }
+
+    {
+        endian_reader r( b.data(), b.size() );
+
+        endian_block_reader c = r.reserve( 18 );
+
+        BOOST_TEST( c );
+        BOOST_TEST( c.data() == b.data() );
+        BOOST_TEST_EQ( r.position(), 18u );
+
+        c.skip( 9 );
+
+        boost::uint16_t t = 0;
+        c.read_n<big_uint16_buf_t>( &t, 1 );
+
+        BOOST_TEST_EQ( t, 1 );
+        BOOST_TEST_EQ( c.size(), 7u );
+    }
+}
+
+int main()
+{
+    test_read();
+    test_failure();
+    test_read_n();
+    test_reserve();
+
+    return boost::report_errors();
+}
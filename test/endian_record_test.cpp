@@ -0,0 +1,142 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/record.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+
+using namespace boost::endian;
+
+// a made up frame header; the fields are listed out of order, there is a gap
+// at 7, there are 24 and 48 bit fields, and fields whose names are also
+// those of the endian_field members
+
+struct magic: endian_field<0, order::big, boost::uint32_t> {};
+struct version: endian_field<4, order::big, boost::uint8_t> {};
+struct flags: endian_field<5, order::little, boost::uint16_t> {};
+struct length: endian_field<8, order::big, boost::uint32_t, 24> {};
+struct offset: endian_field<11, order::little, boost::int64_t, 48> {};
+struct size: endian_field<21, order::big, boost::uint16_t> {};
+struct ratio: endian_field<17, order::big, float> {};
+
+typedef endian_layout<magic, flags, version, length, offset, ratio, size> header;
+
+// the same layout, with trailing bytes
+
+struct padded_header: header
+{
+    static const std::size_t size = 28;
+};
+
+const std::size_t padded_header::size;
+
+template<class F> typename F::value_type load( unsigned char const * p )
+{
+    typedef typename detail::endian_field_of<F>::type B;
+    return endian_load<typename B::value_type, B::size, B::byte_order>( p + B::offset );
+}
+
+// generic code can use operator[] without `template`
+
+template<class View> boost::uint32_t read_length( View v )
+{
+    return v[ length() ];
+}
+
+int main()
+{
+    BOOST_TEST_EQ( header::size, 23u );
+    BOOST_TEST_EQ( header::field_count, 7u );
+    BOOST_TEST_EQ( endian_record_view<header>::record_size, 23u );
+    BOOST_TEST_EQ( endian_record_view<padded_header const>::record_size, 28u );
+
+    BOOST_TEST( header::contains<ratio>::value );
+    BOOST_TEST( !endian_layout<magic>::contains<ratio>::value );
+
+    unsigned char b[ 48 ];
+
+    for( std::size_t i = 0; i < sizeof(b); ++i )
+    {
+        b[ i ] = static_cast<unsigned char>( i * 0x9D + 0x31 );
+    }
+
+    {
+        endian_record_view<header const> r( b );
+
+        BOOST_TEST( r.data() == b );
+        BOOST_TEST( r.field_data<length>() == b + 8 );
+
+        BOOST_TEST_EQ( r.get<magic>(), load<magic>( b ) );
+        BOOST_TEST_EQ( r.get<version>(), load<version>( b ) );
+        BOOST_TEST_EQ( r.get<flags>(), load<flags>( b ) );
+        BOOST_TEST_EQ( r.get<length>(), load<length>( b ) );
+        BOOST_TEST_EQ( r.get<offset>(), load<offset>( b ) );
+        BOOST_TEST_EQ( r.get<size>(), load<size>( b ) );
+
+        BOOST_TEST_EQ( r[ magic() ], load<magic>( b ) );
+        BOOST_TEST_EQ( read_length( r ), load<length>( b ) );
+
+        BOOST_TEST( r.next().data() == b + 23 );
+        BOOST_TEST_EQ( r.next().get<flags>(), load<flags>( b + 23 ) );
+    }
+
+    {
+        unsigned char c[ 48 ];
+        std::memcpy( c, b, sizeof(c) );
+
+        endian_record_view<header> r( c );
+
+        r.set<magic>( 0x01020304u );
+        r.set<flags>( 0x0506 );
+        r.set<length>( 0x0A0B0C );
+        r[ offset() ] = -2;
+        r[ ratio() ] = 1.5f;
+        r[ size() ] = 0x1122;
+
+        BOOST_TEST_EQ( c[ 0 ], 0x01 );
+        BOOST_TEST_EQ( c[ 3 ], 0x04 );
+        BOOST_TEST_EQ( c[ 4 ], b[ 4 ] );
+        BOOST_TEST_EQ( c[ 5 ], 0x06 );
+        BOOST_TEST_EQ( c[ 6 ], 0x05 );
+        BOOST_TEST_EQ( c[ 7 ], b[ 7 ] );
+        BOOST_TEST_EQ( c[ 8 ], 0x0A );
+        BOOST_TEST_EQ( c[ 10 ], 0x0C );
+        BOOST_TEST_EQ( c[ 11 ], 0xFE );
+        BOOST_TEST_EQ( c[ 16 ], 0xFF );
+        BOOST_TEST_EQ( c[ 17 ], 0x3F );
+        BOOST_TEST_EQ( c[ 18 ], 0xC0 );
+        BOOST_TEST_EQ( c[ 21 ], 0x11 );
+        BOOST_TEST_EQ( c[ 22 ], 0x22 );
+        BOOST_TEST_EQ( c[ 23 ], b[ 23 ] );
+
+        BOOST_TEST_EQ( r.get<offset>(), -2 );
+        BOOST_TEST_EQ( r.get<ratio>(), 1.5f );
+        BOOST_TEST_EQ( read_length( r ), 0x0A0B0Cu );
+
+        // the proxy reads back, and assigns values between fields
+
+        r[ version() ] = r[ flags() ] & 0xFF;
+        BOOST_TEST_EQ( r.get<version>(), 0x06 );
+
+        // mutable to const
+
+        endian_record_view<header const> k = r;
+        BOOST_TEST( k.data() == c );
+        BOOST_TEST_EQ( k.get<magic>(), 0x01020304u );
+
+        // arrays of records
+
+        endian_record_view<padded_header> p( c );
+
+        p.next().set<magic>( 0xAABBCCDDu );
+
+        BOOST_TEST_EQ( c[ 28 ], 0xAA );
+        BOOST_TEST_EQ( c[ 31 ], 0xDD );
+    }
+
+    return boost::report_errors();
+}
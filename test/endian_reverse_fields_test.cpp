@@ -0,0 +1,218 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/detail/endian_reverse_fields.hpp>
+#include <boost/endian/detail/simd_dispatch.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace boost::endian;
+
+typedef std::vector< std::pair<std::size_t, std::size_t> > field_list;
+
+static std::vector<unsigned char> make_data( std::size_t n )
+{
+    std::vector<unsigned char> v( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        v[ i ] = static_cast<unsigned char>( i * 13 + ( i >> 7 ) );
+    }
+
+    return v;
+}
+
+// each field of each record reversed a byte at a time
+
+static std::vector<unsigned char> reference( std::vector<unsigned char> v, std::size_t size, field_list const & fields )
+{
+    for( std::size_t i = 0; i + size <= v.size(); i += size )
+    {
+        for( std::size_t j = 0; j < fields.size(); ++j )
+        {
+            std::reverse( v.begin() + i + fields[ j ].first, v.begin() + i + fields[ j ].first + fields[ j ].second );
+        }
+    }
+
+    return v;
+}
+
+static void test_layout( std::size_t size, field_list const & fields )
+{
+    detail::endian_record_layout r;
+
+    BOOST_TEST( detail::endian_record_layout_make( r, size, fields ) );
+
+    // fewer records than a period of the permutation, a few periods, and
+    // lengths that leave a tail to the scalar loop
+
+    std::size_t const counts[] = { 0, 1, 2, 3, 7, 16, 31, 64, 100, 257, 1000 };
+
+    for( std::size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i )
+    {
+        std::size_t const n = counts[ i ];
+
+        // one byte more than the records, which must be left alone
+
+        std::vector<unsigned char> v = make_data( n * size + 1 );
+        std::vector<unsigned char> const w = reference( v, size, fields );
+
+        detail::endian_reverse_records( v.data(), n, r );
+
+        BOOST_TEST( v == w );
+
+        // twice is the identity
+
+        detail::endian_reverse_records( v.data(), n, r );
+
+        BOOST_TEST( v == make_data( n * size + 1 ) );
+    }
+}
+
+static field_list make_fields( std::size_t const (*f)[ 2 ], std::size_t n )
+{
+    field_list r;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        r.push_back( std::make_pair( f[ i ][ 0 ], f[ i ][ 1 ] ) );
+    }
+
+    return r;
+}
+
+static void test_layouts()
+{
+    {
+        // 8,4x2,c6,2
+
+        std::size_t const f[][ 2 ] = { { 0, 8 }, { 8, 4 }, { 12, 4 }, { 22, 2 } };
+        test_layout( 24, make_fields( f, 4 ) );
+    }
+
+    {
+        // 3,c2,5,7; odd sizes and an odd record
+
+        std::size_t const f[][ 2 ] = { { 0, 3 }, { 5, 5 }, { 10, 7 } };
+        test_layout( 17, make_fields( f, 3 ) );
+    }
+
+    {
+        // 4,c2,2,c4; a record size that does not divide a vector
+
+        std::size_t const f[][ 2 ] = { { 0, 4 }, { 6, 2 } };
+        test_layout( 12, make_fields( f, 2 ) );
+    }
+
+    {
+        // given out of order, with a gap at the end
+
+        std::size_t const f[][ 2 ] = { { 6, 2 }, { 0, 4 }, { 4, 1 } };
+        test_layout( 11, make_fields( f, 3 ) );
+    }
+
+    {
+        // 2; 4x4; 8x2
+
+        std::size_t const f1[][ 2 ] = { { 0, 2 } };
+        test_layout( 2, make_fields( f1, 1 ) );
+
+        std::size_t const f2[][ 2 ] = { { 0, 4 }, { 4, 4 }, { 8, 4 }, { 12, 4 } };
+        test_layout( 16, make_fields( f2, 4 ) );
+
+        std::size_t const f3[][ 2 ] = { { 0, 8 }, { 8, 8 } };
+        test_layout( 16, make_fields( f3, 2 ) );
+    }
+
+    {
+        // 16, wider than a field of a described type
+
+        std::size_t const f[][ 2 ] = { { 0, 16 }, { 16, 2 } };
+        test_layout( 18, make_fields( f, 2 ) );
+    }
+
+    {
+        // nothing to reverse
+
+        std::size_t const f[][ 2 ] = { { 0, 1 }, { 1, 1 } };
+        test_layout( 5, make_fields( f, 2 ) );
+        test_layout( 5, field_list() );
+    }
+}
+
+static void test_rejected()
+{
+    detail::endian_record_layout r;
+
+    {
+        std::size_t const f[][ 2 ] = { { 0, 4 }, { 4, 4 } };
+        BOOST_TEST( detail::endian_record_layout_make( r, 8, make_fields( f, 2 ) ) );
+    }
+
+    // a layout that is rejected leaves r as it was
+
+    BOOST_TEST( !detail::endian_record_layout_make( r, 0, field_list() ) );
+
+    {
+        // overlapping
+
+        std::size_t const f[][ 2 ] = { { 0, 4 }, { 2, 4 } };
+        BOOST_TEST( !detail::endian_record_layout_make( r, 8, make_fields( f, 2 ) ) );
+    }
+
+    {
+        // overlapping, given out of order
+
+        std::size_t const f[][ 2 ] = { { 4, 4 }, { 0, 5 } };
+        BOOST_TEST( !detail::endian_record_layout_make( r, 16, make_fields( f, 2 ) ) );
+    }
+
+    {
+        // the same field twice
+
+        std::size_t const f[][ 2 ] = { { 2, 2 }, { 2, 2 } };
+        BOOST_TEST( !detail::endian_record_layout_make( r, 8, make_fields( f, 2 ) ) );
+    }
+
+    {
+        // larger than the record
+
+        std::size_t const f[][ 2 ] = { { 0, 8 } };
+        BOOST_TEST( !detail::endian_record_layout_make( r, 4, make_fields( f, 1 ) ) );
+    }
+
+    {
+        // past the end of the record
+
+        std::size_t const f[][ 2 ] = { { 6, 4 } };
+        BOOST_TEST( !detail::endian_record_layout_make( r, 8, make_fields( f, 1 ) ) );
+    }
+
+    {
+        // an offset whose end does not fit in a std::size_t
+
+        std::size_t const f[][ 2 ] = { { ~std::size_t( 0 ), 2 } };
+        BOOST_TEST( !detail::endian_record_layout_make( r, 8, make_fields( f, 1 ) ) );
+    }
+
+    BOOST_TEST_EQ( r.size, 8u );
+    BOOST_TEST_EQ( r.fields.size(), 2u );
+}
+
+int main()
+{
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test_layouts();
+    }
+
+    test_rejected();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,144 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// sizes straddle every vector width and unroll factor of the kernels
+
+static std::size_t const sizes[] = { 0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255, 256, 257, 1000 };
+
+template<class T> T make_value( std::size_t i )
+{
+    unsigned char tmp[ sizeof(T) ];
+
+    for( std::size_t j = 0; j < sizeof(T); ++j )
+    {
+        tmp[ j ] = static_cast<unsigned char>( i * 131 + j * 17 + 1 );
+    }
+
+    T t;
+    std::memcpy( &t, tmp, sizeof(T) );
+    return t;
+}
+
+template<class T> bool same_bits( T const & a, T const & b )
+{
+    return std::memcmp( &a, &b, sizeof(T) ) == 0;
+}
+
+template<class T> void test()
+{
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t n = sizes[ k ];
+
+        // offset by one element to exercise unaligned starts
+
+        std::vector<T> v( n + 1 );
+
+        for( std::size_t i = 0; i < n + 1; ++i )
+        {
+            v[ i ] = make_value<T>( i );
+        }
+
+        std::vector<T> w( v );
+
+        for( std::size_t i = 1; i < n + 1; ++i )
+        {
+            boost::endian::endian_reverse_inplace( w[ i ] );
+        }
+
+        boost::endian::endian_reverse_inplace_n( v.data() + 1, n );
+
+        for( std::size_t i = 0; i < n + 1; ++i )
+        {
+            BOOST_TEST( same_bits( v[ i ], w[ i ] ) );
+        }
+
+        boost::endian::endian_reverse_inplace( v.data() + 1, v.data() + n + 1 );
+
+        for( std::size_t i = 0; i < n + 1; ++i )
+        {
+            BOOST_TEST( same_bits( v[ i ], make_value<T>( i ) ) );
+        }
+
+        boost::endian::native_to_big_inplace_n( v.data(), n + 1 );
+        boost::endian::big_to_native_inplace_n( v.data(), n + 1 );
+
+        boost::endian::native_to_little_inplace_n( v.data(), n + 1 );
+        boost::endian::little_to_native_inplace_n( v.data(), n + 1 );
+
+        boost::endian::conditional_reverse_inplace_n( v.data(), n + 1, boost::endian::order::big, boost::endian::order::little );
+        boost::endian::conditional_reverse_inplace_n<boost::endian::order::little, boost::endian::order::big>( v.data(), n + 1 );
+
+        for( std::size_t i = 0; i < n + 1; ++i )
+        {
+            BOOST_TEST( same_bits( v[ i ], make_value<T>( i ) ) );
+        }
+    }
+}
+
+namespace user
+{
+
+struct udt
+{
+    int x;
+    short y;
+};
+
+inline void endian_reverse_inplace( udt & u ) noexcept
+{
+    boost::endian::endian_reverse_inplace( u.x );
+    boost::endian::endian_reverse_inplace( u.y );
+}
+
+} // namespace user
+
+enum E { e1 = 0x01020304 };
+
+int main()
+{
+    test<boost::uint8_t>();
+    test<boost::int16_t>();
+    test<boost::uint16_t>();
+    test<boost::int32_t>();
+    test<boost::uint32_t>();
+    test<boost::int64_t>();
+    test<boost::uint64_t>();
+    test<float>();
+    test<double>();
+    test<E>();
+
+    {
+        user::udt v[ 3 ] = { { 0x01020304, 0x0506 }, { 0x0708090A, 0x0B0C }, { 0x0D0E0F10, 0x1112 } };
+
+        boost::endian::endian_reverse_inplace_n( v, 3 );
+
+        BOOST_TEST_EQ( v[2].x, 0x100F0E0D );
+        BOOST_TEST_EQ( v[2].y, 0x1211 );
+
+        boost::endian::endian_reverse_inplace( v );
+
+        BOOST_TEST_EQ( v[0].x, 0x01020304 );
+        BOOST_TEST_EQ( v[0].y, 0x0506 );
+    }
+
+    {
+        boost::uint32_t v[ 2 ][ 2 ] = { { 0x01020304, 0x05060708 }, { 0x090A0B0C, 0x0D0E0F10 } };
+
+        boost::endian::endian_reverse_inplace( v );
+
+        BOOST_TEST_EQ( v[0][0], 0x04030201 );
+        BOOST_TEST_EQ( v[1][1], 0x100F0E0D );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,165 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/span.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace boost::endian;
+
+template<order Order, class T, std::size_t N> void test()
+{
+    std::size_t const n = 37;
+
+    std::vector<unsigned char> b( n * N );
+
+    for( std::size_t i = 0; i < b.size(); ++i )
+    {
+        b[ i ] = static_cast<unsigned char>( i * 0x9D + 0x31 );
+    }
+
+    endian_span<Order, T, N * 8> s( b.data(), n );
+
+    BOOST_TEST_EQ( s.size(), n );
+    BOOST_TEST_EQ( s.size_bytes(), n * N );
+    BOOST_TEST( !s.empty() );
+    BOOST_TEST( s.data() == b.data() );
+    BOOST_TEST_EQ( s.end() - s.begin(), static_cast<std::ptrdiff_t>( n ) );
+
+    // element access and iteration
+
+    std::size_t i = 0;
+
+    for( typename endian_span<Order, T, N * 8>::iterator it = s.begin(); it != s.end(); ++it, ++i )
+    {
+        T const x = endian_load<T, N, Order>( b.data() + i * N );
+
+        BOOST_TEST_EQ( static_cast<T>( *it ), x );
+        BOOST_TEST_EQ( static_cast<T>( s[ i ] ), x );
+    }
+
+    BOOST_TEST_EQ( i, n );
+    BOOST_TEST_EQ( static_cast<T>( s.front() ), ( endian_load<T, N, Order>( b.data() ) ) );
+    BOOST_TEST_EQ( static_cast<T>( s.back() ), ( endian_load<T, N, Order>( b.data() + ( n - 1 ) * N ) ) );
+
+    // bulk copy agrees with the element-wise loads
+
+    std::vector<T> v( n );
+    s.copy_to( v.data() );
+
+    for( std::size_t j = 0; j < n; ++j )
+    {
+        BOOST_TEST_EQ( v[ j ], static_cast<T>( s[ j ] ) );
+    }
+
+    // element-wise stores
+
+    for( std::size_t j = 0; j < n; ++j )
+    {
+        s[ j ] = static_cast<T>( j * 3 + 1 );
+    }
+
+    for( std::size_t j = 0; j < n; ++j )
+    {
+        BOOST_TEST_EQ( ( endian_load<T, N, Order>( b.data() + j * N ) ), static_cast<T>( j * 3 + 1 ) );
+    }
+
+    // bulk store
+
+    s.assign_from( v.data() );
+
+    for( std::size_t j = 0; j < n; ++j )
+    {
+        BOOST_TEST_EQ( ( endian_load<T, N, Order>( b.data() + j * N ) ), v[ j ] );
+    }
+
+    // read-only view and standard algorithms
+
+    endian_span<Order, T const, N * 8> c = s;
+
+    BOOST_TEST( c.data() == b.data() );
+    BOOST_TEST( std::equal( c.begin(), c.end(), v.begin() ) );
+    BOOST_TEST( std::equal( s.cbegin(), s.cend(), v.begin() ) );
+
+    BOOST_TEST_EQ( *std::max_element( c.begin(), c.end() ), *std::max_element( v.begin(), v.end() ) );
+    BOOST_TEST_EQ( std::count( c.begin(), c.end(), v[ 7 ] ), std::count( v.begin(), v.end(), v[ 7 ] ) );
+
+    std::sort( s.begin(), s.end() );
+    std::sort( v.begin(), v.end() );
+
+    BOOST_TEST( std::equal( c.begin(), c.end(), v.begin() ) );
+    BOOST_TEST( std::is_sorted( c.begin(), c.end() ) );
+
+    std::reverse( s.begin(), s.end() );
+    BOOST_TEST( std::equal( c.begin(), c.end(), v.rbegin() ) );
+
+    // subviews
+
+    BOOST_TEST( c.first( 3 ).data() == b.data() );
+    BOOST_TEST_EQ( c.first( 3 ).size(), 3u );
+    BOOST_TEST( c.last( 3 ).data() == b.data() + ( n - 3 ) * N );
+    BOOST_TEST( c.subspan( 2, 4 ).data() == b.data() + 2 * N );
+    BOOST_TEST_EQ( c.subspan( 2, 4 ).size(), 4u );
+    BOOST_TEST_EQ( c.subspan( 2 ).size(), n - 2 );
+    BOOST_TEST_EQ( static_cast<T>( c.subspan( 2 )[ 0 ] ), static_cast<T>( c[ 2 ] ) );
+
+    typename endian_span<Order, T const, N * 8>::iterator it = c.begin() + 5;
+
+    BOOST_TEST( it == s.begin() + 5 );
+    BOOST_TEST( it - 5 == c.begin() );
+    BOOST_TEST( it > c.begin() );
+    BOOST_TEST_EQ( it[ 1 ], static_cast<T>( c[ 6 ] ) );
+}
+
+int main()
+{
+    test<order::big, boost::int16_t, 2>();
+    test<order::little, boost::uint16_t, 2>();
+
+    test<order::big, boost::int32_t, 3>();
+    test<order::little, boost::int32_t, 3>();
+    test<order::big, boost::uint32_t, 4>();
+    test<order::little, boost::int32_t, 4>();
+
+    test<order::big, boost::int64_t, 6>();
+    test<order::little, boost::uint64_t, 5>();
+    test<order::big, boost::uint64_t, 8>();
+    test<order::little, boost::int64_t, 8>();
+
+    {
+        unsigned char b[] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0 };
+
+        big_span<boost::uint32_t> s( b, 2 );
+
+        BOOST_TEST_EQ( s[ 0 ], 0x12345678u );
+        BOOST_TEST_EQ( s[ 1 ], 0x9ABCDEF0u );
+
+        little_span<boost::uint16_t const> t( b, 4 );
+
+        BOOST_TEST_EQ( t[ 0 ], 0x3412 );
+        BOOST_TEST_EQ( t[ 3 ], 0xF0DE );
+
+        endian_span<order::big, boost::int32_t, 24> u( b, 2 );
+
+        u[ 1 ] = -2;
+
+        BOOST_TEST_EQ( b[ 3 ], 0xFF );
+        BOOST_TEST_EQ( b[ 4 ], 0xFF );
+        BOOST_TEST_EQ( b[ 5 ], 0xFE );
+        BOOST_TEST_EQ( b[ 6 ], 0xDE );
+
+        BOOST_TEST_EQ( u[ 1 ], -2 );
+
+        endian_span<order::big, boost::int32_t, 24> e;
+
+        BOOST_TEST( e.empty() );
+        BOOST_TEST( e.begin() == e.end() );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,101 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+static std::size_t const sizes[] = { 0, 1, 2, 5, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 257 };
+
+template<class T, std::size_t N, order Order> void test_()
+{
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t n = sizes[ k ];
+
+        std::vector<T> src( n + 1 );
+
+        for( std::size_t i = 0; i < src.size(); ++i )
+        {
+            src[ i ] = static_cast<T>( ( i + 1 ) * 0x0123456789ABCDEFull + ( i << 62 ) );
+        }
+
+        // the guard bytes around the output must survive
+
+        unsigned char dst[ 257 * 8 + 2 ];
+        std::memset( dst, 0xA5, sizeof(dst) );
+
+        endian_store_n<T, N, Order>( src.data() + 1, dst + 1, n );
+
+        unsigned char ref[ 257 * 8 + 2 ];
+        std::memset( ref, 0xA5, sizeof(ref) );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            endian_store<T, N, Order>( ref + 1 + i * N, src[ i + 1 ] );
+        }
+
+        BOOST_TEST( std::memcmp( dst, ref, sizeof(dst) ) == 0 );
+    }
+}
+
+template<class T, std::size_t N> void test()
+{
+    test_<T, N, order::big>();
+    test_<T, N, order::little>();
+}
+
+template<class T> void test2()
+{
+    test<T, 1>();
+    test<T, 2>();
+}
+
+template<class T> void test4()
+{
+    test2<T>();
+    test<T, 3>();
+    test<T, 4>();
+}
+
+template<class T> void test8()
+{
+    test4<T>();
+    test<T, 5>();
+    test<T, 6>();
+    test<T, 7>();
+    test<T, 8>();
+}
+
+int main()
+{
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test<boost::int8_t, 1>();
+        test<boost::uint8_t, 1>();
+
+        test2<boost::int16_t>();
+        test2<boost::uint16_t>();
+
+        test4<boost::int32_t>();
+        test4<boost::uint32_t>();
+
+        test8<boost::int64_t>();
+        test8<boost::uint64_t>();
+
+        test<float, 4>();
+        test<double, 8>();
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,167 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/record.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+// a gap at 12, and the fields are listed out of offset order
+
+struct stamp: endian_field<4, order::big, boost::int64_t> {};
+struct id: endian_field<0, order::big, boost::uint32_t> {};
+struct kind: endian_field<13, order::little, boost::uint16_t> {};
+struct value: endian_field<15, order::big, double> {};
+struct count: endian_field<23, order::big, boost::int32_t, 24> {};
+
+typedef endian_layout<stamp, id, kind, value, count> event;
+
+// trailing padding
+
+struct padded_event: event
+{
+    static const std::size_t size = 31;
+};
+
+const std::size_t padded_event::size;
+
+// no gaps, 8 bytes
+
+struct lo: endian_field<0, order::little, boost::uint32_t> {};
+struct hi: endian_field<4, order::big, float> {};
+
+typedef endian_layout<lo, hi> pair;
+
+template<class Layout> static void expect( std::vector<unsigned char> const & b, std::size_t o, std::size_t n,
+    boost::int64_t const * c0, boost::uint32_t const * c1, boost::uint16_t const * c2, double const * c3, boost::int32_t const * c4, bool nt )
+{
+    std::size_t const R = Layout::size;
+
+    std::vector<unsigned char> e( b.size() );
+
+    for( std::size_t i = 0; i < e.size(); ++i )
+    {
+        e[ i ] = static_cast<unsigned char>( i * 0x9D + 0x31 );
+    }
+
+    if( nt )
+    {
+        std::memset( &e[ o ], 0, n * R );
+    }
+
+    endian_record_view<Layout> r( &e[ o ] );
+
+    for( std::size_t i = 0; i < n; ++i, r = r.next() )
+    {
+        r.template set<stamp>( c0[ i ] );
+        r.template set<id>( c1[ i ] );
+        r.template set<kind>( c2[ i ] );
+        r.template set<value>( c3[ i ] );
+        r.template set<count>( c4[ i ] );
+    }
+
+    BOOST_TEST( b == e );
+}
+
+template<class Layout> static void test_event()
+{
+    static std::size_t const sizes[] = { 0, 1, 2, 3, 7, 8, 16, 17, 100, 150, 151, 152, 400, 1000 };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+        std::size_t const R = Layout::size;
+
+        std::vector<boost::int64_t> c0( n );
+        std::vector<boost::uint32_t> c1( n );
+        std::vector<boost::uint16_t> c2( n );
+        std::vector<double> c3( n );
+        std::vector<boost::int32_t> c4( n );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            c0[ i ] = static_cast<boost::int64_t>( i * 0x0123456789ABCDEFull );
+            c1[ i ] = static_cast<boost::uint32_t>( i * 0x9E3779B9u );
+            c2[ i ] = static_cast<boost::uint16_t>( i * 0x9D );
+            c3[ i ] = static_cast<double>( i ) / 3;
+            c4[ i ] = static_cast<boost::int32_t>( i * 0x10101 ) - 0x400000;
+        }
+
+        // every destination alignment modulo 64, with guard bytes on both sides
+
+        for( std::size_t o = 64; o < 128; o += 7 )
+        {
+            for( int nt = 0; nt < 2; ++nt )
+            {
+                std::vector<unsigned char> b( n * R + 192 );
+
+                for( std::size_t i = 0; i < b.size(); ++i )
+                {
+                    b[ i ] = static_cast<unsigned char>( i * 0x9D + 0x31 );
+                }
+
+                if( nt )
+                {
+                    endian_store_records<Layout>( &b[ o ], n, store_hint::nontemporal, c0.data(), c1.data(), c2.data(), c3.data(), c4.data() );
+                }
+                else
+                {
+                    endian_store_records<Layout>( &b[ o ], n, c0.data(), c1.data(), c2.data(), c3.data(), c4.data() );
+                }
+
+                expect<Layout>( b, o, n, c0.data(), c1.data(), c2.data(), c3.data(), c4.data(), nt != 0 );
+            }
+        }
+    }
+}
+
+static void test_pair()
+{
+    std::size_t const n = 1000;
+
+    std::vector<boost::uint32_t> c0( n );
+    std::vector<float> c1( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        c0[ i ] = static_cast<boost::uint32_t>( i * 0x9E3779B9u );
+        c1[ i ] = static_cast<float>( i ) * 0.25f;
+    }
+
+    std::vector<unsigned char> b( n * 8 ), e( n * 8 );
+
+    endian_store_records<pair>( b.data(), n, store_hint::nontemporal, c0.data(), c1.data() );
+    endian_store_records<pair>( e.data(), n, c0.data(), c1.data() );
+
+    BOOST_TEST( b == e );
+
+    // round trip
+
+    std::vector<boost::uint32_t> d0( n );
+    std::vector<float> d1( n );
+
+    endian_load_records<pair>( b.data(), n, d0.data(), d1.data() );
+
+    BOOST_TEST( c0 == d0 );
+    BOOST_TEST( c1 == d1 );
+}
+
+int main()
+{
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test_event<event>();
+        test_event<padded_event>();
+        test_pair();
+    }
+
+    return boost::report_errors();
+}
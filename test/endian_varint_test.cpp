@@ -0,0 +1,270 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace boost::endian;
+
+static void test_single()
+{
+    unsigned char b[ 16 ];
+
+    BOOST_TEST_EQ( store_varint_u32( b, 0 ), 1u );
+    BOOST_TEST_EQ( b[ 0 ], 0 );
+
+    BOOST_TEST_EQ( store_varint_u32( b, 300 ), 2u );
+    BOOST_TEST_EQ( b[ 0 ], 0xAC );
+    BOOST_TEST_EQ( b[ 1 ], 0x02 );
+
+    BOOST_TEST_EQ( store_varint_u32( b, 0xFFFFFFFFu ), 5u );
+    BOOST_TEST_EQ( b[ 0 ], 0xFF );
+    BOOST_TEST_EQ( b[ 3 ], 0xFF );
+    BOOST_TEST_EQ( b[ 4 ], 0x0F );
+
+    BOOST_TEST_EQ( store_varint_u64( b, 0xFFFFFFFFFFFFFFFFull ), 10u );
+    BOOST_TEST_EQ( b[ 8 ], 0xFF );
+    BOOST_TEST_EQ( b[ 9 ], 0x01 );
+
+    BOOST_TEST_EQ( store_varint_s32( b, -1 ), 1u );
+    BOOST_TEST_EQ( b[ 0 ], 0x01 );
+
+    BOOST_TEST_EQ( store_varint_s64( b, -65 ), 2u );
+    BOOST_TEST_EQ( b[ 0 ], 0x81 );
+    BOOST_TEST_EQ( b[ 1 ], 0x01 );
+
+    {
+        boost::uint32_t v = 0;
+
+        unsigned char const c[] = { 0xAC, 0x02, 0x7F };
+        BOOST_TEST_EQ( load_varint_u32( c, 3, v ), 2u );
+        BOOST_TEST_EQ( v, 300u );
+
+        // truncated
+
+        BOOST_TEST_EQ( load_varint_u32( c, 1, v ), 0u );
+        BOOST_TEST_EQ( load_varint_u32( c, 0, v ), 0u );
+
+        // the largest, too long, and too large
+
+        unsigned char const d[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x00 };
+        BOOST_TEST_EQ( load_varint_u32( d, 6, v ), 5u );
+        BOOST_TEST_EQ( v, 0xFFFFFFFFu );
+
+        unsigned char const e[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+        BOOST_TEST_EQ( load_varint_u32( e, 6, v ), 0u );
+
+        unsigned char const f[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x1F };
+        BOOST_TEST_EQ( load_varint_u32( f, 5, v ), 0u );
+
+        // a non-minimal encoding of 0 is valid
+
+        BOOST_TEST_EQ( load_varint_u32( e + 2, 4, v ), 4u );
+        BOOST_TEST_EQ( v, 0u );
+    }
+
+    {
+        boost::uint64_t v = 0;
+
+        unsigned char const c[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+        BOOST_TEST_EQ( load_varint_u64( c, 10, v ), 10u );
+        BOOST_TEST_EQ( v, 0xFFFFFFFFFFFFFFFFull );
+
+        unsigned char const d[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02 };
+        BOOST_TEST_EQ( load_varint_u64( d, 10, v ), 0u );
+    }
+
+    {
+        boost::int32_t v = 0;
+
+        unsigned char const c[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+        BOOST_TEST_EQ( load_varint_s32( c, 5, v ), 5u );
+        BOOST_TEST_EQ( v, std::numeric_limits<boost::int32_t>::min() );
+
+        boost::int64_t w = 0;
+
+        unsigned char const d[] = { 0x81, 0x01 };
+        BOOST_TEST_EQ( load_varint_s64( d, 2, w ), 2u );
+        BOOST_TEST_EQ( w, -65 );
+    }
+
+    BOOST_TEST_EQ( zigzag_encode_s32( 0 ), 0u );
+    BOOST_TEST_EQ( zigzag_encode_s32( -1 ), 1u );
+    BOOST_TEST_EQ( zigzag_encode_s32( 1 ), 2u );
+    BOOST_TEST_EQ( zigzag_encode_s32( -2 ), 3u );
+    BOOST_TEST_EQ( zigzag_encode_s32( std::numeric_limits<boost::int32_t>::max() ), 0xFFFFFFFEu );
+    BOOST_TEST_EQ( zigzag_encode_s32( std::numeric_limits<boost::int32_t>::min() ), 0xFFFFFFFFu );
+    BOOST_TEST_EQ( zigzag_encode_s64( std::numeric_limits<boost::int64_t>::min() ), 0xFFFFFFFFFFFFFFFFull );
+
+    BOOST_TEST_EQ( zigzag_decode_s32( 3 ), -2 );
+    BOOST_TEST_EQ( zigzag_decode_s32( 0xFFFFFFFFu ), std::numeric_limits<boost::int32_t>::min() );
+    BOOST_TEST_EQ( zigzag_decode_s64( 4 ), 2 );
+    BOOST_TEST_EQ( zigzag_decode_s64( 0xFFFFFFFFFFFFFFFEull ), std::numeric_limits<boost::int64_t>::max() );
+
+    BOOST_TEST_EQ( varint_max_size<boost::uint8_t>::value, 2u );
+    BOOST_TEST_EQ( varint_max_size<boost::int16_t>::value, 3u );
+    BOOST_TEST_EQ( varint_max_size<boost::uint32_t>::value, 5u );
+    BOOST_TEST_EQ( varint_max_size<boost::int64_t>::value, 10u );
+}
+
+// values of up to `bits` significant bits, with the sign of the value mixed
+// in for signed types
+
+template<class T> static T value( std::size_t i, int bits )
+{
+    boost::uint64_t x = i * 0x9E3779B97F4A7C15ull;
+    x ^= x >> 29;
+
+    int const w = static_cast<int>( sizeof(T) * 8 );
+    int const b = bits < w? bits: w;
+
+    boost::uint64_t const m = b >= 64? ~0ull: ( 1ull << ( x % b + 1 ) ) - 1;
+    boost::uint64_t v = ( x >> 7 ) & m;
+
+    if( std::numeric_limits<T>::is_signed && ( x & 0x10 ) )
+    {
+        v = ~v;
+    }
+
+    return static_cast<T>( v );
+}
+
+template<class T> static void test_bulk( int bits )
+{
+    // the lengths straddle the 4, 6 and 16 value steps
+
+    static std::size_t const sizes[] = { 0, 1, 3, 4, 5, 15, 16, 17, 33, 100, 1000 };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+
+        std::vector<T> x( n + 1 );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            x[ i ] = value<T>( i, bits );
+        }
+
+        // the expected encoding, one value at a time
+
+        std::vector<unsigned char> e( ( n + 1 ) * varint_max_size<T>::value );
+        std::size_t m = 0;
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            m += detail::varint_store_one( e.data() + m, x[ i ] );
+        }
+
+        std::vector<unsigned char> b( e.size(), 0xCC );
+
+        BOOST_TEST_EQ( store_varint_n( x.data(), b.data(), n ), m );
+        BOOST_TEST( std::memcmp( b.data(), e.data(), m ) == 0 );
+
+        std::vector<T> y( n + 1, T( 0x5A ) );
+
+        BOOST_TEST_EQ( load_varint_n( b.data(), m, y.data(), n ), m );
+        BOOST_TEST( std::memcmp( x.data(), y.data(), n * sizeof(T) ) == 0 );
+        BOOST_TEST_EQ( y[ n ], T( 0x5A ) );
+
+        // extra bytes are not read
+
+        BOOST_TEST_EQ( load_varint_n( b.data(), b.size(), y.data(), n ), m );
+
+        // a missing byte
+
+        if( n != 0 )
+        {
+            BOOST_TEST_EQ( load_varint_n( b.data(), m - 1, y.data(), n ), 0u );
+        }
+
+        // one invalid value in the middle
+
+        if( n >= 17 )
+        {
+            std::vector<unsigned char> c( e.size() + 16 );
+
+            std::size_t h = 0;
+
+            for( std::size_t i = 0; i < n / 2; ++i )
+            {
+                h += detail::varint_store_one( c.data() + h, x[ i ] );
+            }
+
+            for( std::size_t i = 0; i < varint_max_size<T>::value; ++i )
+            {
+                c[ h++ ] = 0xFF;
+            }
+
+            c[ h++ ] = 0x01;
+
+            for( std::size_t i = n / 2 + 1; i < n; ++i )
+            {
+                h += detail::varint_store_one( c.data() + h, x[ i ] );
+            }
+
+            BOOST_TEST_EQ( load_varint_n( c.data(), h, y.data(), n ), 0u );
+        }
+    }
+}
+
+template<class T> static void test_bulk()
+{
+    test_bulk<T>( 7 );
+    test_bulk<T>( 14 );
+    test_bulk<T>( 21 );
+    test_bulk<T>( 64 );
+}
+
+static void test_patterns()
+{
+    // every combination of 1, 2 and 3 byte values in the first 16 bytes
+
+    std::vector<boost::uint32_t> x;
+
+    for( int p = 0; p < 729; ++p )
+    {
+        for( int i = 0, w = 1; i < 6; ++i, w *= 3 )
+        {
+            static boost::uint32_t const v[] = { 0x45, 0x1234, 0x12345 };
+            x.push_back( v[ p / w % 3 ] + i );
+        }
+    }
+
+    std::vector<unsigned char> b( x.size() * 5 );
+    std::size_t const m = store_varint_n( x.data(), b.data(), x.size() );
+
+    std::vector<boost::uint32_t> y( x.size() );
+
+    BOOST_TEST_EQ( load_varint_n( b.data(), m, y.data(), y.size() ), m );
+    BOOST_TEST( x == y );
+}
+
+int main()
+{
+    test_single();
+
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        test_bulk<boost::int8_t>();
+        test_bulk<boost::uint8_t>();
+        test_bulk<boost::int16_t>();
+        test_bulk<boost::uint16_t>();
+        test_bulk<boost::int32_t>();
+        test_bulk<boost::uint32_t>();
+        test_bulk<boost::int64_t>();
+        test_bulk<boost::uint64_t>();
+
+        test_patterns();
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,250 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/working_copy.hpp>
+#include <boost/endian/describe.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+namespace user
+{
+
+// 16 bytes, four to a line
+
+struct Quote
+{
+    boost::uint32_t id;
+    boost::int32_t bid;
+    float ask;
+    boost::uint16_t size;
+    char flag[ 2 ];
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( Quote, id, bid, ask, size, flag )
+
+// 160 bytes, across three lines
+
+struct Account
+{
+    boost::uint64_t id;
+    double balance;
+    boost::int32_t history[ 36 ];
+};
+
+BOOST_ENDIAN_DESCRIBE_STRUCT( Account, id, balance, history )
+
+} // namespace user
+
+static user::Quote make_quote( std::size_t i )
+{
+    user::Quote q;
+
+    q.id = static_cast<boost::uint32_t>( i );
+    q.bid = static_cast<boost::int32_t>( i * 1000 ) - 50000;
+    q.ask = static_cast<float>( i ) / 4;
+    q.size = static_cast<boost::uint16_t>( i * 7 );
+    q.flag[ 0 ] = 'a';
+    q.flag[ 1 ] = static_cast<char>( 'a' + i % 26 );
+
+    return q;
+}
+
+static bool operator==( user::Quote const & a, user::Quote const & b )
+{
+    return std::memcmp( &a, &b, sizeof(a) ) == 0;
+}
+
+static void test_records()
+{
+    std::size_t const n = 1000;
+
+    std::vector<user::Quote> native( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        native[ i ] = make_quote( i );
+    }
+
+    std::vector<user::Quote> big( native );
+    native_to_big_inplace_n( big.data(), n );
+
+    big_working_copy<user::Quote> w( big.data(), n );
+
+    BOOST_TEST_EQ( w.size(), n );
+    BOOST_TEST_EQ( w.line_count(), n * 16 / 64 );
+    BOOST_TEST_EQ( w.dirty_lines(), 0u );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        BOOST_TEST( w[ i ] == native[ i ] );
+    }
+
+    // one field, one whole record and a range
+
+    w.modify( 10, &user::Quote::bid ) = 77;
+    w.modify( 500 ).ask = 1.5f;
+
+    user::Quote * p = w.modify( 800, 9 );
+
+    for( std::size_t i = 0; i < 9; ++i )
+    {
+        p[ i ].size = 0xABCD;
+    }
+
+    BOOST_TEST( w.is_dirty( 10 ) );
+    BOOST_TEST( w.is_dirty( 11 ) ); // the same line
+    BOOST_TEST( !w.is_dirty( 12 ) );
+    BOOST_TEST( w.is_dirty( 500 ) );
+    BOOST_TEST_EQ( w.dirty_lines(), 1u + 1u + 3u );
+
+    // the source is left as it was until the flush; records written back are
+    // seen by marking the source
+
+    std::vector<user::Quote> const before( big );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        big[ i ].flag[ 0 ] = 'x';
+    }
+
+    BOOST_TEST_EQ( w.flush(), 4u + 4u + 12u );
+    BOOST_TEST_EQ( w.dirty_lines(), 0u );
+
+    native[ 10 ].bid = 77;
+    native[ 500 ].ask = 1.5f;
+
+    for( std::size_t i = 800; i < 809; ++i )
+    {
+        native[ i ].size = 0xABCD;
+    }
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        bool const written = ( i >= 8 && i < 12 ) || ( i >= 500 && i < 504 ) || ( i >= 800 && i < 812 );
+
+        user::Quote expected = written? native[ i ]: before[ i ];
+
+        if( written )
+        {
+            native_to_big_inplace( expected );
+        }
+        else
+        {
+            expected.flag[ 0 ] = 'x';
+        }
+
+        BOOST_TEST( big[ i ] == expected );
+    }
+
+    // nothing to write
+
+    BOOST_TEST_EQ( w.flush(), 0u );
+}
+
+static void test_discard()
+{
+    std::vector<boost::uint32_t> v( 100 );
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        v[ i ] = native_to_little( static_cast<boost::uint32_t>( i * 3 ) );
+    }
+
+    little_working_copy<boost::uint32_t> w( v.data(), v.size() );
+
+    BOOST_TEST_EQ( w.line_count(), 7u );
+
+    w.modify( 0 ) = 1;
+    w.modify( 99 ) = 2;
+
+    BOOST_TEST_EQ( w.dirty_lines(), 2u );
+    BOOST_TEST_EQ( w[ 99 ], 2u );
+
+    // the last, partial line holds four values
+
+    BOOST_TEST_EQ( w.discard(), 16u + 4u );
+    BOOST_TEST_EQ( w.dirty_lines(), 0u );
+
+    BOOST_TEST_EQ( w[ 0 ], 0u );
+    BOOST_TEST_EQ( w[ 99 ], 297u );
+
+    w.modify( 50 ) = 5;
+
+    BOOST_TEST_EQ( w.flush(), 16u );
+    BOOST_TEST_EQ( little_to_native( v[ 50 ] ), 5u );
+    BOOST_TEST_EQ( little_to_native( v[ 49 ] ), 147u );
+}
+
+static void test_large_records()
+{
+    std::size_t const n = 20;
+
+    std::vector<user::Account> a( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        a[ i ].id = i;
+        a[ i ].balance = static_cast<double>( i ) * 10;
+
+        for( std::size_t j = 0; j < 36; ++j )
+        {
+            a[ i ].history[ j ] = static_cast<boost::int32_t>( i * 100 + j );
+        }
+    }
+
+    native_to_big_inplace_n( a.data(), n );
+
+    big_working_copy<user::Account> w( a.data(), n );
+
+    BOOST_TEST_EQ( w[ 7 ].history[ 35 ], 735 );
+
+    // a field in the middle of a record writes back that record
+
+    w.modify( 2, &user::Account::balance ) = -1;
+
+    BOOST_TEST( w.is_dirty( 2 ) );
+    BOOST_TEST( !w.is_dirty( 1 ) );
+    BOOST_TEST( !w.is_dirty( 3 ) );
+
+    BOOST_TEST_EQ( w.flush(), 1u );
+    BOOST_TEST_EQ( ( endian_load<double, 8, order::big>( reinterpret_cast<unsigned char const*>( &a[ 2 ].balance ) ) ), -1.0 );
+
+    // a line shared by two records writes back both
+
+    w.modify( 4 ).history[ 35 ] = 0;
+
+    BOOST_TEST_EQ( w.flush(), 2u );
+    BOOST_TEST_EQ( big_to_native( a[ 4 ].history[ 35 ] ), 0 );
+    BOOST_TEST_EQ( big_to_native( a[ 5 ].id ), 5u );
+}
+
+static void test_empty()
+{
+    endian_working_copy<order::big, boost::uint64_t> w;
+
+    BOOST_TEST( w.empty() );
+    BOOST_TEST_EQ( w.line_count(), 0u );
+    BOOST_TEST_EQ( w.flush(), 0u );
+
+    w.assign( 0, 0 );
+
+    BOOST_TEST( w.empty() );
+    BOOST_TEST_EQ( w.discard(), 0u );
+}
+
+int main()
+{
+    test_records();
+    test_discard();
+    test_large_records();
+    test_empty();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,306 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/writer.hpp>
+#include <boost/endian/reader.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+using namespace boost::endian;
+
+static std::vector<unsigned char> contents( endian_writer const & w )
+{
+    std::vector<unsigned char> r( w.size() );
+    w.copy_to( r.data() );
+    return r;
+}
+
+// the chunks, as seen by for_each_chunk
+
+struct collect
+{
+    std::vector<unsigned char> * v;
+    std::size_t * count;
+
+    void operator()( unsigned char const * p, std::size_t n ) const
+    {
+        BOOST_TEST_NE( n, 0u );
+
+        v->insert( v->end(), p, p + n );
+        ++*count;
+    }
+};
+
+static void test_write()
+{
+    endian_writer w;
+
+    BOOST_TEST( w.empty() );
+    BOOST_TEST_EQ( w.chunk_count(), 0u );
+
+    w.write<big_uint16_t>( 0x0102 );
+    w.write<little_uint32_buf_t>( 0x06050403 );
+    w.write<big_int24_t>( 0x070809 );
+
+    unsigned char const b[] = { 0x0A, 0x0B };
+    w.write_bytes( b, 2 );
+
+    BOOST_TEST_EQ( w.size(), 11u );
+    BOOST_TEST_EQ( w.chunk_count(), 1u );
+
+    std::vector<unsigned char> const v = contents( w );
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        BOOST_TEST_EQ( v[ i ], i + 1 );
+    }
+}
+
+static void test_chunks()
+{
+    // a small first chunk, so that values meet the chunk ends
+
+    endian_writer w( 7 );
+
+    std::vector<unsigned char> e;
+
+    for( int i = 0; i < 3000; ++i )
+    {
+        unsigned char t[ 8 ];
+
+        switch( i % 4 )
+        {
+        case 0:
+
+            w.write<big_uint32_t>( i * 0x01010101u );
+            store_big_u32( t, i * 0x01010101u );
+            e.insert( e.end(), t, t + 4 );
+            break;
+
+        case 1:
+
+            w.write<little_int64_t>( -i );
+            store_little_s64( t, -i );
+            e.insert( e.end(), t, t + 8 );
+            break;
+
+        case 2:
+
+            w.write<big_uint8_t>( static_cast<boost::uint8_t>( i ) );
+            e.push_back( static_cast<unsigned char>( i ) );
+            break;
+
+        default:
+
+            {
+                unsigned char const s[ 5 ] = { 1, 2, 3, 4, 5 };
+                w.write_bytes( s, 5 );
+                e.insert( e.end(), s, s + 5 );
+            }
+        }
+    }
+
+    BOOST_TEST_EQ( w.size(), e.size() );
+    BOOST_TEST( contents( w ) == e );
+
+    BOOST_TEST_GT( w.chunk_count(), 1u );
+
+    std::vector<unsigned char> c;
+    std::size_t n = 0;
+
+    collect f = { &c, &n };
+    w.for_each_chunk( f );
+
+    BOOST_TEST( c == e );
+    BOOST_TEST_EQ( n, w.chunk_count() );
+
+    // geometric growth: few chunks for many values
+
+    BOOST_TEST_LT( w.chunk_count(), 16u );
+}
+
+static void test_write_n()
+{
+    std::vector<boost::int32_t> x( 1000 );
+
+    for( std::size_t i = 0; i < x.size(); ++i )
+    {
+        x[ i ] = static_cast<boost::int32_t>( i * 0x9E3779B9u );
+    }
+
+    for( int level = 0; level <= static_cast<int>( simd_supported_level() ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        endian_writer w( 64 );
+
+        w.write<big_uint8_t>( 0xEE );
+        w.write_n<big_int32_t>( x.data(), x.size() );
+        w.write_n<little_int24_t>( x.data(), 10 );
+
+        std::vector<unsigned char> const v = contents( w );
+
+        BOOST_TEST_EQ( v.size(), 1 + 4000 + 30u );
+
+        endian_reader r( v.data(), v.size() );
+
+        BOOST_TEST_EQ( r.read<big_uint8_t>(), 0xEE );
+
+        std::vector<boost::int32_t> y( x.size() );
+        BOOST_TEST( r.read_n<big_int32_t>( y.data(), y.size() ) );
+        BOOST_TEST( x == y );
+
+        for( std::size_t i = 0; i < 10; ++i )
+        {
+            boost::int32_t const e = endian_load<boost::int32_t, 3, order::little>( v.data() + 4001 + 3 * i );
+            BOOST_TEST_EQ( r.read<little_int24_t>(), e );
+        }
+
+        BOOST_TEST( r.empty() );
+    }
+}
+
+static void test_backpatch()
+{
+    endian_writer w( 16 );
+
+    w.write<big_uint8_t>( 1 );
+
+    // a length prefix, stored after the body; the body spans several chunks
+
+    unsigned char * p = w.reserve( 4 );
+    std::size_t const start = w.size();
+
+    for( int i = 0; i < 100; ++i )
+    {
+        w.write<big_uint32_t>( i );
+    }
+
+    store_big_u32( p, static_cast<boost::uint32_t>( w.size() - start ) );
+
+    std::vector<unsigned char> const v = contents( w );
+
+    BOOST_TEST_EQ( v[ 0 ], 1 );
+    BOOST_TEST_EQ( load_big_u32( v.data() + 1 ), 400u );
+    BOOST_TEST_EQ( load_big_u32( v.data() + 5 + 4 * 99 ), 99u );
+
+    // a reserve larger than any chunk
+
+    unsigned char * q = w.reserve( 100000 );
+    std::memset( q, 0x5A, 100000 );
+
+    BOOST_TEST_EQ( w.size(), 405u + 100000 );
+    BOOST_TEST_EQ( contents( w )[ 405 + 99999 ], 0x5A );
+
+    // reserving nothing does not add a chunk
+
+    std::size_t const n = w.chunk_count();
+    w.reserve( 0 );
+
+    BOOST_TEST_EQ( w.chunk_count(), n );
+}
+
+static void test_clear()
+{
+    endian_writer w( 32 );
+
+    for( int i = 0; i < 1000; ++i )
+    {
+        w.write<big_uint64_t>( i );
+    }
+
+    std::size_t const c = w.capacity();
+
+    w.clear();
+
+    BOOST_TEST( w.empty() );
+    BOOST_TEST_EQ( w.chunk_count(), 0u );
+
+    // the same output again allocates nothing
+
+    for( int i = 0; i < 1000; ++i )
+    {
+        w.write<big_uint64_t>( i + 1 );
+    }
+
+    BOOST_TEST_EQ( w.capacity(), c );
+    BOOST_TEST_EQ( load_big_u64( contents( w ).data() + 8 * 999 ), 1000u );
+
+    w.clear();
+    w.write<big_uint8_t>( 7 );
+    w.shrink_to_fit();
+
+    BOOST_TEST_EQ( w.chunk_count(), 1u );
+    BOOST_TEST_EQ( w.capacity(), 32u );
+
+    // moves
+
+    endian_writer w2( std::move( w ) );
+
+    BOOST_TEST_EQ( w2.size(), 1u );
+    BOOST_TEST_EQ( contents( w2 )[ 0 ], 7 );
+
+    BOOST_TEST( w.empty() );
+    BOOST_TEST_EQ( w.capacity(), 0u );
+
+    w.write<big_uint16_t>( 0x0809 );
+
+    w2 = std::move( w );
+
+    BOOST_TEST_EQ( w2.size(), 2u );
+    BOOST_TEST_EQ( contents( w2 )[ 1 ], 9 );
+}
+
+#if defined(BOOST_ENDIAN_HAS_IOVEC)
+
+static void test_iovec()
+{
+    endian_writer w( 10 );
+
+    for( int i = 0; i < 20; ++i )
+    {
+        w.write<big_uint32_t>( i );
+    }
+
+    std::size_t const n = w.chunk_count();
+
+    BOOST_TEST_EQ( w.export_iovec( 0, 0 ), n );
+
+    std::vector<iovec> iov( n );
+    BOOST_TEST_EQ( w.export_iovec( iov.data(), n ), n );
+
+    std::vector<unsigned char> v;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        unsigned char const * p = static_cast<unsigned char const*>( iov[ i ].iov_base );
+        v.insert( v.end(), p, p + iov[ i ].iov_len );
+    }
+
+    BOOST_TEST( v == contents( w ) );
+}
+
+#endif
+
+int main()
+{
+    test_write();
+    test_chunks();
+    test_write_n();
+    test_backpatch();
+    test_clear();
+
+#if defined(BOOST_ENDIAN_HAS_IOVEC)
+
+    test_iovec();
+
+#endif
+
+    return boost::report_errors();
+}
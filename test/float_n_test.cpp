@@ -0,0 +1,195 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// The bulk functions must move float and double values as bit patterns:
+// signaling NaNs stay signaling, NaN payloads and the sign of zero survive
+
+#include <boost/endian/conversion.hpp>
+#include <boost/endian/buffers.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace boost::endian;
+
+template<class T> struct bits;
+
+template<> struct bits<float>
+{
+    typedef boost::uint32_t type;
+};
+
+template<> struct bits<double>
+{
+    typedef boost::uint64_t type;
+};
+
+template<class T> std::vector<typename bits<T>::type> patterns();
+
+template<> std::vector<boost::uint32_t> patterns<float>()
+{
+    boost::uint32_t const p[] =
+    {
+        0x00000000, 0x80000000,             // +0, -0
+        0x7F800000, 0xFF800000,             // +inf, -inf
+        0x7FC00000, 0xFFC00000,             // quiet NaN
+        0x7F800001, 0xFFA5A5A5, 0x7FBFFFFF, // signaling NaN with payloads
+        0x7FC12345,                         // quiet NaN with payload
+        0x00000001, 0x807FFFFF,             // denormals
+        0x3F800000, 0xC0490FDB,             // 1, -pi
+    };
+
+    return std::vector<boost::uint32_t>( p, p + sizeof(p) / sizeof(p[0]) );
+}
+
+template<> std::vector<boost::uint64_t> patterns<double>()
+{
+    boost::uint64_t const p[] =
+    {
+        0x0000000000000000ull, 0x8000000000000000ull,
+        0x7FF0000000000000ull, 0xFFF0000000000000ull,
+        0x7FF8000000000000ull, 0xFFF8000000000000ull,
+        0x7FF0000000000001ull, 0xFFF5A5A5A5A5A5A5ull, 0x7FF7FFFFFFFFFFFFull,
+        0x7FF8123456789ABCull,
+        0x0000000000000001ull, 0x800FFFFFFFFFFFFFull,
+        0x3FF0000000000000ull, 0xC00921FB54442D18ull,
+    };
+
+    return std::vector<boost::uint64_t>( p, p + sizeof(p) / sizeof(p[0]) );
+}
+
+template<class T> void test( std::size_t n )
+{
+    typedef typename bits<T>::type U;
+
+    std::vector<U> const p = patterns<T>();
+
+    std::vector<T> v( n );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        std::memcpy( &v[ i ], &p[ i % p.size() ], sizeof(T) );
+    }
+
+    // the expected big endian representation
+
+    std::vector<unsigned char> big( n * sizeof(T) );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        endian_store<U, sizeof(T), order::big>( &big[ i * sizeof(T) ], p[ i % p.size() ] );
+    }
+
+    std::size_t const size = n * sizeof(T);
+
+    // src -> dst
+
+    std::vector<unsigned char> b( size + 1 );
+
+    native_to_big_n( v.data(), b.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( b.data(), big.data(), size ) == 0 );
+
+    native_to_big_n( v.data(), b.data() + 1, n, store_hint::nontemporal );
+    BOOST_TEST( n == 0 || std::memcmp( b.data() + 1, big.data(), size ) == 0 );
+
+    endian_store_n<T, sizeof(T), order::big>( v.data(), b.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( b.data(), big.data(), size ) == 0 );
+
+    std::vector<T> w( n );
+
+    big_to_native_n( big.data(), w.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( w.data(), v.data(), size ) == 0 );
+
+    w.assign( n, T() );
+    endian_load_n<T, sizeof(T), order::big>( big.data(), w.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( w.data(), v.data(), size ) == 0 );
+
+    // in place
+
+    w = v;
+
+    native_to_big_inplace_n( w.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( w.data(), big.data(), size ) == 0 );
+
+    big_to_native_inplace_n( w.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( w.data(), v.data(), size ) == 0 );
+
+    endian_reverse_inplace_n( w.data(), n );
+    endian_reverse_n( w.data(), w.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( w.data(), v.data(), size ) == 0 );
+
+    // buffers
+
+    std::vector< endian_buffer<order::big, T, sizeof(T) * 8> > bb( n );
+
+    endian_store_n( v.data(), bb.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( bb.data(), big.data(), size ) == 0 );
+
+    w.assign( n, T() );
+    endian_load_n( bb.data(), w.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( w.data(), v.data(), size ) == 0 );
+
+    std::vector< endian_buffer<order::big, T, sizeof(T) * 8, align::yes> > ba( n );
+
+    endian_store_n( v.data(), ba.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( ba.data(), big.data(), size ) == 0 );
+
+    w.assign( n, T() );
+    endian_load_n( ba.data(), w.data(), n );
+    BOOST_TEST( n == 0 || std::memcmp( w.data(), v.data(), size ) == 0 );
+}
+
+int main()
+{
+    simd_level const supported = simd_supported_level();
+
+    for( int level = 0; level <= static_cast<int>( supported ); ++level )
+    {
+        set_simd_dispatch_level( static_cast<simd_level>( level ) );
+
+        for( std::size_t n = 0; n < 160; n = n * 2 + 1 )
+        {
+            test<float>( n );
+            test<double>( n );
+        }
+    }
+
+    {
+        big_float64_buf_t b[ 2 ];
+
+        b[ 0 ] = 1.0;
+        b[ 1 ] = -0.0;
+
+        double d[ 2 ];
+        endian_load_n( b, d, 2 );
+
+        BOOST_TEST_EQ( d[ 0 ], 1.0 );
+        BOOST_TEST_EQ( d[ 1 ], 0.0 );
+
+        boost::uint64_t u;
+        std::memcpy( &u, &d[ 1 ], 8 );
+
+        BOOST_TEST_EQ( u, 0x8000000000000000ull );
+
+        little_int24_buf_t c[ 3 ];
+        boost::int32_t const x[ 3 ] = { -1, 0x123456, -0x800000 };
+
+        endian_store_n( x, c, 3 );
+
+        BOOST_TEST_EQ( c[ 0 ].value(), -1 );
+        BOOST_TEST_EQ( c[ 1 ].value(), 0x123456 );
+        BOOST_TEST_EQ( c[ 2 ].value(), -0x800000 );
+
+        boost::int32_t y[ 3 ];
+        endian_load_n( c, y, 3 );
+
+        BOOST_TEST_EQ( y[ 0 ], x[ 0 ] );
+        BOOST_TEST_EQ( y[ 1 ], x[ 1 ] );
+        BOOST_TEST_EQ( y[ 2 ], x[ 2 ] );
+    }
+
+    return boost::report_errors();
+}
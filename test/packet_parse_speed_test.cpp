@@ -0,0 +1,268 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Measures the packet rate of net::parse_burst for several burst sizes, over a
+// synthetic capture of Ethernet frames: IPv4 and IPv6, TCP and UDP, with and
+// without VLAN tags and IP or TCP options. The capture is generated in the
+// libpcap file format and read back through its record headers, as a capture
+// from disk would be; it can also be written out, to be replayed elsewhere.
+//
+// Usage: packet_parse_speed_test [packets [repetitions [output.pcap]]]
+
+#include <boost/endian/net.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/timer/timer.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace boost::endian;
+
+static std::size_t packets = 1 << 18;
+static int repetitions = 20;
+
+static unsigned sink;
+
+// a small deterministic generator, so that runs are comparable
+
+static boost::uint32_t rng_state = 0x12345678;
+
+static boost::uint32_t rng()
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// libpcap file format; written little endian, read in either order
+
+static boost::uint32_t const pcap_magic = 0xA1B2C3D4;
+
+static void pcap_header( std::vector<unsigned char> & f )
+{
+    unsigned char h[ 24 ];
+
+    endian_store<boost::uint32_t, 4, order::little>( h + 0, pcap_magic );
+    endian_store<boost::uint16_t, 2, order::little>( h + 4, 2 );
+    endian_store<boost::uint16_t, 2, order::little>( h + 6, 4 );
+    endian_store<boost::uint32_t, 4, order::little>( h + 8, 0 );
+    endian_store<boost::uint32_t, 4, order::little>( h + 12, 0 );
+    endian_store<boost::uint32_t, 4, order::little>( h + 16, 65535 );
+    endian_store<boost::uint32_t, 4, order::little>( h + 20, 1 ); // Ethernet
+
+    f.insert( f.end(), h, h + 24 );
+}
+
+// appends one frame, with its record header
+
+static void pcap_frame( std::vector<unsigned char> & f, std::size_t i )
+{
+    unsigned char p[ 1514 ] = {};
+
+    boost::uint32_t const r = rng();
+
+    std::size_t k = 12;
+
+    // 1 in 8 frames has a VLAN tag
+
+    if( r % 8 == 0 )
+    {
+        endian_store<boost::uint16_t, 2, order::big>( p + k, net::ether_type::vlan );
+        endian_store<boost::uint16_t, 2, order::big>( p + k + 2, static_cast<boost::uint16_t>( r >> 20 & 0xFFF ) );
+        k += 4;
+    }
+
+    // 3 in 4 are IPv4; 2 in 3 are TCP
+
+    bool const v6 = ( r >> 3 ) % 4 == 0;
+    boost::uint8_t const protocol = ( r >> 5 ) % 3 == 0? net::ip_protocol::udp: net::ip_protocol::tcp;
+
+    std::size_t const payload = 16 + ( r >> 8 ) % 1200;
+
+    endian_store<boost::uint16_t, 2, order::big>( p + k, v6? net::ether_type::ipv6: net::ether_type::ipv4 );
+    k += 2;
+
+    std::size_t const l3 = k;
+
+    if( v6 )
+    {
+        p[ k ] = 0x60;
+        p[ k + 6 ] = protocol;
+        p[ k + 7 ] = 64;
+        k += 40;
+    }
+    else
+    {
+        std::size_t const options = ( r >> 7 ) % 8 == 0? 8: 0;
+
+        p[ k ] = static_cast<unsigned char>( 0x45 + options / 4 );
+        p[ k + 8 ] = 64;
+        p[ k + 9 ] = protocol;
+        endian_store<boost::uint32_t, 4, order::big>( p + k + 12, 0x0A000000 | static_cast<boost::uint32_t>( i & 0xFFFF ) );
+        endian_store<boost::uint32_t, 4, order::big>( p + k + 16, 0xC0A80001 );
+        k += 20 + options;
+    }
+
+    endian_store<boost::uint16_t, 2, order::big>( p + k, static_cast<boost::uint16_t>( 1024 + r % 50000 ) );
+    endian_store<boost::uint16_t, 2, order::big>( p + k + 2, protocol == net::ip_protocol::udp? 53: 443 );
+
+    if( protocol == net::ip_protocol::udp )
+    {
+        endian_store<boost::uint16_t, 2, order::big>( p + k + 4, static_cast<boost::uint16_t>( 8 + payload ) );
+        k += 8;
+    }
+    else
+    {
+        std::size_t const options = ( r >> 9 ) % 2 == 0? 12: 0;
+
+        endian_store<boost::uint16_t, 2, order::big>( p + k + 12, static_cast<boost::uint16_t>( ( 5 + options / 4 ) << 12 | net::tcp_flags::ack ) );
+        k += 20 + options;
+    }
+
+    k += payload;
+
+    if( v6 )
+    {
+        endian_store<boost::uint16_t, 2, order::big>( p + l3 + 4, static_cast<boost::uint16_t>( k - l3 - 40 ) );
+    }
+    else
+    {
+        endian_store<boost::uint16_t, 2, order::big>( p + l3 + 2, static_cast<boost::uint16_t>( k - l3 ) );
+    }
+
+    unsigned char h[ 16 ];
+
+    endian_store<boost::uint32_t, 4, order::little>( h + 0, static_cast<boost::uint32_t>( i / 1000000 ) );
+    endian_store<boost::uint32_t, 4, order::little>( h + 4, static_cast<boost::uint32_t>( i % 1000000 ) );
+    endian_store<boost::uint32_t, 4, order::little>( h + 8, static_cast<boost::uint32_t>( k ) );
+    endian_store<boost::uint32_t, 4, order::little>( h + 12, static_cast<boost::uint32_t>( k ) );
+
+    f.insert( f.end(), h, h + 16 );
+    f.insert( f.end(), p, p + k );
+}
+
+// the frames of a capture; false if it is not a libpcap file
+
+static bool pcap_read( std::vector<unsigned char> const & f, std::vector<unsigned char const*> & frames, std::vector<std::size_t> & lengths )
+{
+    if( f.size() < 24 ) return false;
+
+    order o;
+
+    if( endian_load<boost::uint32_t, 4, order::little>( &f[ 0 ] ) == pcap_magic )
+    {
+        o = order::little;
+    }
+    else if( endian_load<boost::uint32_t, 4, order::big>( &f[ 0 ] ) == pcap_magic )
+    {
+        o = order::big;
+    }
+    else
+    {
+        return false;
+    }
+
+    for( std::size_t k = 24; k + 16 <= f.size(); )
+    {
+        boost::uint32_t n = o == order::little?
+            endian_load<boost::uint32_t, 4, order::little>( &f[ k + 8 ] ):
+            endian_load<boost::uint32_t, 4, order::big>( &f[ k + 8 ] );
+
+        k += 16;
+
+        if( n > f.size() - k ) return false;
+
+        frames.push_back( &f[ k ] );
+        lengths.push_back( n );
+
+        k += n;
+    }
+
+    return true;
+}
+
+static void time_burst( std::vector<unsigned char const*> const & frames, std::vector<std::size_t> const & lengths, std::size_t size )
+{
+    net::packet_burst b;
+
+    std::size_t const n = frames.size();
+
+    boost::timer::cpu_timer t;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        for( std::size_t i = 0; i < n; i += size )
+        {
+            std::size_t const m = net::parse_burst( &frames[ i ], &lengths[ i ], n - i < size? n - i: size, b );
+
+            for( std::size_t j = 0; j < m; ++j )
+            {
+                sink += b.destination_port[ j ] + b.payload_offset[ j ];
+            }
+        }
+    }
+
+    t.stop();
+
+    double const s = t.elapsed().wall / 1e9;
+
+    std::printf( "burst %-8lu %10.1f\n", static_cast<unsigned long>( size ), s > 0? static_cast<double>( n ) * repetitions / s / 1e6: 0 );
+}
+
+int main( int argc, char const * argv[] )
+{
+    if( argc > 1 )
+    {
+        packets = std::strtoul( argv[ 1 ], 0, 10 );
+    }
+
+    if( argc > 2 )
+    {
+        repetitions = std::atoi( argv[ 2 ] );
+    }
+
+    std::vector<unsigned char> f;
+
+    pcap_header( f );
+
+    for( std::size_t i = 0; i < packets; ++i )
+    {
+        pcap_frame( f, i );
+    }
+
+    if( argc > 3 )
+    {
+        if( std::FILE * out = std::fopen( argv[ 3 ], "wb" ) )
+        {
+            std::fwrite( f.data(), 1, f.size(), out );
+            std::fclose( out );
+        }
+        else
+        {
+            std::perror( argv[ 3 ] );
+            return 1;
+        }
+    }
+
+    std::vector<unsigned char const*> frames;
+    std::vector<std::size_t> lengths;
+
+    if( !pcap_read( f, frames, lengths ) || frames.size() != packets )
+    {
+        std::printf( "Invalid capture\n" );
+        return 1;
+    }
+
+    std::printf( "%lu packets, %lu bytes, %d repetitions; Mpackets/s\n\n", static_cast<unsigned long>( packets ), static_cast<unsigned long>( f.size() ), repetitions );
+
+    time_burst( frames, lengths, 1 );
+    time_burst( frames, lengths, 16 );
+    time_burst( frames, lengths, 32 );
+    time_burst( frames, lengths, 64 );
+
+    return sink == 0x12345678? 1: 0;
+}
@@ -0,0 +1,124 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Measures how the parallel bulk functions scale with the number of threads.
+// Prints one CSV row per thread count, suitable for charting: the throughput
+// of in-place reversal, copy-and-convert, and a packed 48-bit decode, each in
+// GB/s of the larger side, and the speedup over one thread.
+//
+// Usage: parallel_speed_test [megabytes [max-threads [numa]]]
+
+#include <boost/endian/parallel.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/timer/timer.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace boost::endian;
+
+static int const repetitions = 5;
+
+// best of the repetitions, in GB/s
+
+template<class F> double measure( std::size_t bytes, F f )
+{
+    double best = 0;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        boost::timer::cpu_timer t;
+        f();
+        t.stop();
+
+        double s = t.elapsed().wall / 1e9;
+
+        if( s > 0 && bytes / s / 1e9 > best )
+        {
+            best = bytes / s / 1e9;
+        }
+    }
+
+    return best;
+}
+
+int main( int argc, char const * argv[] )
+{
+    std::size_t megabytes = 512;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    bool numa = false;
+
+    if( argc > 1 )
+    {
+        megabytes = std::strtoul( argv[ 1 ], 0, 10 );
+    }
+
+    if( argc > 2 )
+    {
+        max_threads = static_cast<unsigned>( std::strtoul( argv[ 2 ], 0, 10 ) );
+    }
+
+    if( argc > 3 )
+    {
+        numa = std::atoi( argv[ 3 ] ) != 0;
+    }
+
+    if( max_threads == 0 )
+    {
+        max_threads = 1;
+    }
+
+    std::size_t const n = megabytes * 1024 * 1024 / 8;
+
+    std::vector<boost::uint64_t> a( n ), b( n );
+    std::vector<unsigned char> packed( n * 6 );
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        a[ i ] = i * 0x9E3779B97F4A7C15ull;
+    }
+
+    std::printf( "# %s, %lu MB, numa %s\n", BOOST_ENDIAN_SIMD_MSG, static_cast<unsigned long>( megabytes ), numa? "on": "off" );
+    std::printf( "threads,inplace_gbs,inplace_speedup,copy_gbs,copy_speedup,load48_gbs,load48_speedup\n" );
+
+    double base[ 3 ] = {};
+
+    for( unsigned threads = 1; threads <= max_threads; threads = threads < 4? threads + 1: threads * 2 )
+    {
+        parallel_options opt( threads );
+        opt.numa = numa;
+
+        // touch the pages from the workers first, so that with NUMA they are
+        // spread the way the conversion will access them
+
+        endian_reverse_n( opt, a.data(), b.data(), n );
+        endian_store_n<boost::uint64_t, 6, order::big>( opt, a.data(), packed.data(), n );
+
+        double r[ 3 ];
+
+        r[ 0 ] = measure( n * 8, [&]{ endian_reverse_inplace_n( opt, a.data(), n ); } );
+        r[ 1 ] = measure( n * 8, [&]{ endian_reverse_n( opt, a.data(), b.data(), n, store_hint::nontemporal ); } );
+        r[ 2 ] = measure( n * 8, [&]{ endian_load_n<boost::uint64_t, 6, order::big>( opt, packed.data(), b.data(), n ); } );
+
+        if( threads == 1 )
+        {
+            base[ 0 ] = r[ 0 ];
+            base[ 1 ] = r[ 1 ];
+            base[ 2 ] = r[ 2 ];
+        }
+
+        std::printf( "%u", threads );
+
+        for( int i = 0; i < 3; ++i )
+        {
+            std::printf( ",%.2f,%.2f", r[ i ], base[ i ] > 0? r[ i ] / base[ i ]: 0 );
+        }
+
+        std::printf( "\n" );
+    }
+
+    return 0;
+}
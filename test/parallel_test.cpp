@@ -0,0 +1,235 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/parallel.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace boost::endian;
+
+static std::size_t const sizes[] = { 0, 1, 15, 16, 17, 1000, 4097, 100003 };
+
+template<class T> void test( parallel_options const & opt )
+{
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t const n = sizes[ k ];
+
+        std::vector<T> v( n + 1 );
+
+        for( std::size_t i = 0; i < n + 1; ++i )
+        {
+            v[ i ] = static_cast<T>( ( i + 1 ) * 0x0102030405060708ull );
+        }
+
+        // an odd start, so that the first chunk is shorter
+
+        std::vector<T> w( v.begin() + 1, v.end() );
+
+        endian_reverse_inplace_n( opt, w.data(), n );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            BOOST_TEST_EQ( w[ i ], endian_reverse( v[ i + 1 ] ) );
+        }
+
+        native_to_big_inplace_n( opt, w.data(), n );
+        big_to_native_inplace_n( opt, w.data(), n );
+        little_to_native_inplace_n( opt, w.data(), n );
+        conditional_reverse_inplace_n<order::big, order::little>( opt, w.data(), n );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            BOOST_TEST_EQ( w[ i ], v[ i + 1 ] );
+        }
+
+        std::vector<T> x( n + 1 );
+
+        endian_reverse_n( opt, v.data() + 1, x.data(), n );
+        conditional_reverse_n<order::big, order::big>( opt, x.data(), w.data(), n, store_hint::nontemporal );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            BOOST_TEST_EQ( x[ i ], endian_reverse( v[ i + 1 ] ) );
+            BOOST_TEST_EQ( w[ i ], x[ i ] );
+        }
+
+        std::vector<unsigned char> b( n * sizeof(T) + 1 );
+
+        native_to_big_n( opt, v.data() + 1, b.data() + 1, n );
+        big_to_native_n( opt, b.data() + 1, x.data(), n );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            BOOST_TEST_EQ( ( endian_load<T, sizeof(T), order::big>( b.data() + 1 + i * sizeof(T) ) ), v[ i + 1 ] );
+            BOOST_TEST_EQ( x[ i ], v[ i + 1 ] );
+        }
+
+        native_to_little_n( opt, v.data() + 1, b.data(), n, store_hint::nontemporal );
+        little_to_native_n( opt, b.data(), x.data(), n );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            BOOST_TEST_EQ( x[ i ], v[ i + 1 ] );
+        }
+
+        // packed, 3 bytes per value
+
+        std::size_t const N = sizeof(T) < 3? sizeof(T): 3;
+
+        endian_store_n<T, N, order::big>( opt, v.data() + 1, b.data() + 1, n );
+        endian_load_n<T, N, order::big>( opt, b.data() + 1, x.data(), n );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            BOOST_TEST_EQ( x[ i ], ( endian_load<T, N, order::big>( b.data() + 1 + i * N ) ) );
+
+            unsigned char t[ 8 ];
+            endian_store<T, N, order::big>( t, v[ i + 1 ] );
+
+            BOOST_TEST( std::memcmp( t, b.data() + 1 + i * N, N ) == 0 );
+        }
+    }
+}
+
+static void test_chunks( std::size_t size, std::size_t n, std::size_t chunk_bytes, std::size_t offset )
+{
+    alignas( 64 ) static unsigned char buffer[ 128 ];
+
+    unsigned char const * anchor = buffer + offset;
+
+    boost::endian::detail::parallel_chunks chunks( anchor, size, n, chunk_bytes );
+
+    BOOST_TEST_GE( chunks.count(), 1u );
+    BOOST_TEST_EQ( chunks.begin( 0 ), 0u );
+    BOOST_TEST_EQ( chunks.end( chunks.count() - 1 ), n );
+
+    for( std::size_t k = 1; k < chunks.count(); ++k )
+    {
+        BOOST_TEST_EQ( chunks.begin( k ), chunks.end( k - 1 ) );
+        BOOST_TEST_LT( chunks.begin( k ), chunks.end( k ) );
+
+        if( offset % size == 0 || size % 2 == 1 )
+        {
+            // a boundary on a cache line is reachable
+
+            BOOST_TEST_EQ( ( offset + chunks.begin( k ) * size ) % 64, 0u );
+        }
+    }
+
+    // every chunk is taken exactly once, from any home node
+
+    for( unsigned nodes = 1; nodes <= 3; ++nodes )
+    {
+        boost::endian::detail::parallel_queue queue( chunks, nodes, anchor, size );
+
+        std::vector<int> seen( chunks.count() );
+        std::size_t c;
+
+        for( int home = -1; queue.take( home, c ); home = ( home + 2 ) % static_cast<int>( nodes + 1 ) - 1 )
+        {
+            BOOST_TEST_LT( c, chunks.count() );
+            ++seen[ c ];
+        }
+
+        for( std::size_t k = 0; k < seen.size(); ++k )
+        {
+            BOOST_TEST_EQ( seen[ k ], 1 );
+        }
+    }
+}
+
+static void test_all( parallel_options const & opt )
+{
+    test<boost::uint16_t>( opt );
+    test<boost::int32_t>( opt );
+    test<boost::uint64_t>( opt );
+}
+
+int main()
+{
+    for( std::size_t size = 1; size <= 8; ++size )
+    {
+        for( std::size_t offset = 0; offset < 64; offset += 5 )
+        {
+            test_chunks( size, 0, 0, offset );
+            test_chunks( size, 1, 100, offset );
+            test_chunks( size, 1000, 100, offset );
+            test_chunks( size, 1000, 256, offset );
+            test_chunks( size, 1000000, 0, offset );
+        }
+    }
+
+    parallel_options opt;
+
+    test_all( opt );
+
+    unsigned const threads[] = { 1, 2, 3, 8 };
+
+    for( int i = 0; i < 4; ++i )
+    {
+        opt.threads = threads[ i ];
+
+        // small chunks, to exercise the scheduling; rounded up to 64 bytes
+
+        opt.chunk_bytes = 100;
+        test_all( opt );
+
+        opt.chunk_bytes = 4096;
+        test_all( opt );
+
+        opt.numa = true;
+        test_all( opt );
+
+        opt.numa = false;
+        opt.chunk_bytes = 0;
+        test_all( opt );
+    }
+
+    // executors
+
+    opt.threads = 4;
+    opt.chunk_bytes = 1024;
+
+    opt.executor = []( std::function<void()> f ) { f(); };
+    test_all( opt );
+
+    opt.executor = []( std::function<void()> f ) { std::thread( f ).detach(); };
+    test_all( opt );
+
+    opt.numa = true;
+    test_all( opt );
+
+    // an executor that refuses work; the calling thread does it all
+
+    opt.executor = []( std::function<void()> ) { throw 1; };
+    test_all( opt );
+
+    // an executor that runs the task and then throws
+
+    opt.executor = []( std::function<void()> f ) { f(); throw 1; };
+    test_all( opt );
+
+    // an executor that keeps the task and throws; the task is run later, and
+    // must do nothing
+
+    std::vector< std::function<void()> > kept;
+
+    opt.executor = [&]( std::function<void()> f ) { kept.push_back( f ); throw 1; };
+    test_all( opt );
+
+    BOOST_TEST( !kept.empty() );
+
+    for( std::size_t i = 0; i < kept.size(); ++i )
+    {
+        kept[ i ]();
+    }
+
+    return boost::report_errors();
+}
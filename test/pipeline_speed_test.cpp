@@ -0,0 +1,140 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Measures the throughput of converting a local file of big endian 32-bit
+// values to little endian: a serial loop that reads a buffer with
+// std::ifstream, converts it and writes it with std::ofstream, against
+// pipeline_convert with the thread and io_uring backends. The files are
+// written to the current directory; the source is in the page cache after
+// the first pass, so the results show how well the stages overlap rather
+// than the speed of the disk.
+//
+// Usage: pipeline_speed_test [megabytes [threads]]
+
+#include <boost/endian/pipeline.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/timer/timer.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#if !defined(BOOST_ENDIAN_HAS_PIPELINE)
+
+int main()
+{
+    std::printf( "pipeline_convert is not available on this platform\n" );
+    return 0;
+}
+
+#else
+
+using namespace boost::endian;
+
+static char const * const src_path = "pipeline_speed_test.src.tmp";
+static char const * const dst_path = "pipeline_speed_test.dst.tmp";
+
+static int const repetitions = 3;
+
+static std::size_t const buffer_bytes = std::size_t( 4 ) << 20;
+
+// best of the repetitions, in MB/s
+
+template<class F> double measure( std::size_t bytes, F f )
+{
+    double best = 0;
+
+    for( int r = 0; r < repetitions; ++r )
+    {
+        boost::timer::cpu_timer t;
+        f();
+        t.stop();
+
+        double s = t.elapsed().wall / 1e9;
+
+        if( s > 0 && bytes / s / 1e6 > best )
+        {
+            best = bytes / s / 1e6;
+        }
+    }
+
+    return best;
+}
+
+static void serial()
+{
+    std::ifstream in( src_path, std::ios::binary );
+    std::ofstream out( dst_path, std::ios::binary | std::ios::trunc );
+
+    std::vector<boost::uint32_t> buffer( buffer_bytes / 4 );
+
+    for( ;; )
+    {
+        in.read( reinterpret_cast<char*>( buffer.data() ), buffer_bytes );
+
+        std::size_t const n = static_cast<std::size_t>( in.gcount() );
+
+        if( n == 0 ) break;
+
+        big_to_native_inplace_n( buffer.data(), n / 4 );
+        native_to_little_inplace_n( buffer.data(), n / 4 );
+
+        out.write( reinterpret_cast<char const*>( buffer.data() ), static_cast<std::streamsize>( n ) );
+    }
+}
+
+static void pipelined( pipeline_options const & opt )
+{
+    pipeline_convert_file<order::big, order::little, boost::uint32_t>( src_path, dst_path, opt );
+}
+
+int main( int argc, char const * argv[] )
+{
+    std::size_t megabytes = argc > 1? std::strtoul( argv[ 1 ], 0, 10 ): 256;
+    unsigned threads = argc > 2? static_cast<unsigned>( std::strtoul( argv[ 2 ], 0, 10 ) ): 0;
+
+    std::size_t const bytes = megabytes << 20;
+
+    {
+        std::vector<boost::uint32_t> v( buffer_bytes / 4 );
+
+        for( std::size_t i = 0; i < v.size(); ++i )
+        {
+            v[ i ] = static_cast<boost::uint32_t>( i * 0x9E3779B9u );
+        }
+
+        std::ofstream out( src_path, std::ios::binary | std::ios::trunc );
+
+        for( std::size_t n = 0; n < bytes; n += buffer_bytes )
+        {
+            out.write( reinterpret_cast<char const*>( v.data() ), static_cast<std::streamsize>( buffer_bytes ) );
+        }
+    }
+
+    pipeline_options opt;
+
+    opt.buffer_bytes = buffer_bytes;
+    opt.parallel.threads = threads;
+
+    std::printf( "%zu MB, %zu KB buffers\n\n", megabytes, buffer_bytes >> 10 );
+
+    std::printf( "ifstream/ofstream, serial:  %8.1f MB/s\n", measure( bytes, serial ) );
+
+    opt.io_uring = false;
+    std::printf( "pipeline_convert, threads:  %8.1f MB/s\n", measure( bytes, [&]{ pipelined( opt ); } ) );
+
+#if defined(BOOST_ENDIAN_HAS_IO_URING)
+
+    opt.io_uring = true;
+    std::printf( "pipeline_convert, io_uring: %8.1f MB/s\n", measure( bytes, [&]{ pipelined( opt ); } ) );
+
+#endif
+
+    std::remove( src_path );
+    std::remove( dst_path );
+}
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/endian/conversion.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+
+using namespace boost::endian;
+
+template<class T> void test()
+{
+    for( std::size_t n = 0; n < 300; n += 7 )
+    {
+        std::vector<T> v( n + 1 ), w( n + 1 ), x( n + 1 );
+
+        for( std::size_t i = 0; i < n + 1; ++i )
+        {
+            v[ i ] = static_cast<T>( ( i + 1 ) * 0x0102030405060708ull );
+        }
+
+        endian_reverse_n( v.data() + 1, w.data() + 1, n );
+        endian_reverse_n( v.data() + 1, x.data() + 1, n, store_hint::nontemporal );
+
+        for( std::size_t i = 1; i < n + 1; ++i )
+        {
+            BOOST_TEST_EQ( w[ i ], endian_reverse( v[ i ] ) );
+            BOOST_TEST_EQ( x[ i ], endian_reverse( v[ i ] ) );
+        }
+
+        endian_reverse_inplace_n( w.data() + 1, n );
+
+        for( std::size_t i = 1; i < n + 1; ++i )
+        {
+            BOOST_TEST_EQ( w[ i ], v[ i ] );
+        }
+    }
+}
+
+int main()
+{
+    init_simd_dispatch();
+
+    simd_level const supported = simd_supported_level();
+
+    std::printf( "%s, supported: %s, in use: %s\n", BOOST_ENDIAN_SIMD_MSG, simd_level_name( supported ), simd_dispatch_name() );
+
+    BOOST_TEST( simd_dispatch_level() == supported );
+
+    simd_level const levels[] = { simd_level::none, simd_level::ssse3, simd_level::avx2, simd_level::avx512 };
+
+    for( int i = 0; i < 4; ++i )
+    {
+        simd_level level = set_simd_dispatch_level( levels[ i ] );
+
+#if defined(BOOST_ENDIAN_SIMD_DISPATCH)
+
+        BOOST_TEST( level == ( static_cast<int>( levels[ i ] ) < static_cast<int>( supported )? levels[ i ]: supported ) );
+
+#else
+
+        BOOST_TEST( level == supported );
+
+#endif
+
+        BOOST_TEST( level == simd_dispatch_level() );
+
+        test<boost::uint16_t>();
+        test<boost::uint32_t>();
+        test<boost::uint64_t>();
+    }
+
+    set_simd_dispatch_level( supported );
+    BOOST_TEST( simd_dispatch_level() == supported );
+
+    return boost::report_errors();
+}
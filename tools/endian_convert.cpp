@@ -0,0 +1,780 @@
+// Copyright 2021 Zachary Lund
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Reverses the byte order of the fields of a file of fixed-size records, in
+// place, on all cores. The file is mapped with sequential and huge page
+// hints and converted one block at a time; after each block the progress is
+// saved, so that a run that is interrupted, or killed, resumes where it
+// stopped when started again with the same arguments.
+//
+// Usage: endian_convert [options] layout file
+//
+//   layout   the fields of one record, separated by commas:
+//              N     an N-byte field to reverse, N from 1 to 255
+//              NxK   K such fields
+//              cN    N bytes to leave alone, such as characters or padding
+//            so that "8,4x2,c6,2" is a 24-byte record of an 8-byte field,
+//            two 4-byte fields, 6 bytes of text and a 2-byte field
+//
+//   -j N     the number of threads; all cores by default
+//   -b MB    the size of a block, in MB; 256 by default
+//   -p FILE  the progress file; the file name followed by .endian-progress
+//            by default
+//   -r       ignores the progress file, and starts from the beginning
+//
+// Crash safety. A block is converted in memory and written back with pwrite,
+// one page at a time as far as the page cache is concerned, so that each
+// page of the file is either as it was or converted. Before a block is
+// written, the progress file records a CRC-32C of each of its pages and the
+// bytes of the fields that cross a page boundary. A run that finds a block
+// in progress restores the pages that were converted, which the CRC tells
+// apart, and converts the block again. This relies on the storage writing a
+// page atomically; when it did not, the damaged page is reported.
+
+#include <boost/endian/checksum.hpp>
+#include <boost/endian/reader.hpp>
+#include <boost/endian/writer.hpp>
+#include <boost/endian/detail/cstdint.hpp>
+#include <boost/endian/detail/endian_reverse_fields.hpp>
+#include <boost/endian/detail/mapped_file.hpp>
+#include <boost/endian/detail/parallel_for.hpp>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(BOOST_ENDIAN_HAS_MMAP)
+
+int main()
+{
+    std::fprintf( stderr, "endian_convert: memory mapped files are not supported on this platform\n" );
+    return 1;
+}
+
+#else
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+using namespace boost::endian;
+using boost::endian::detail::endian_record_layout;
+
+typedef std::vector< std::pair<std::size_t, std::size_t> > field_list;
+
+static volatile std::sig_atomic_t interrupted = 0;
+
+extern "C" void on_signal( int )
+{
+    interrupted = 1;
+}
+
+static void fail( std::string const & what, int e = 0 )
+{
+    if( e != 0 )
+    {
+        std::fprintf( stderr, "endian_convert: %s: %s\n", what.c_str(), std::strerror( e ) );
+    }
+    else
+    {
+        std::fprintf( stderr, "endian_convert: %s\n", what.c_str() );
+    }
+
+    std::exit( 1 );
+}
+
+// layout
+
+static bool parse_number( char const *& p, std::size_t & r )
+{
+    if( *p < '0' || *p > '9' )
+    {
+        return false;
+    }
+
+    r = 0;
+
+    for( ; *p >= '0' && *p <= '9'; ++p )
+    {
+        r = r * 10 + static_cast<std::size_t>( *p - '0' );
+
+        if( r > ( std::size_t( 1 ) << 30 ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool parse_layout( char const * p, endian_record_layout & r )
+{
+    field_list fields;
+    std::size_t size = 0;
+
+    for( ;; )
+    {
+        std::size_t n, k = 1;
+
+        if( *p == 'c' )
+        {
+            ++p;
+
+            if( !parse_number( p, n ) )
+            {
+                return false;
+            }
+
+            size += n;
+        }
+        else
+        {
+            if( !parse_number( p, n ) || n == 0 || n > 255 )
+            {
+                return false;
+            }
+
+            if( *p == 'x' )
+            {
+                ++p;
+
+                if( !parse_number( p, k ) )
+                {
+                    return false;
+                }
+            }
+
+            for( std::size_t i = 0; i < k; ++i )
+            {
+                fields.push_back( std::make_pair( size, n ) );
+                size += n;
+            }
+        }
+
+        if( size > ( std::size_t( 1 ) << 30 ) )
+        {
+            return false;
+        }
+
+        if( *p == 0 )
+        {
+            break;
+        }
+
+        if( *p++ != ',' )
+        {
+            return false;
+        }
+    }
+
+    return detail::endian_record_layout_make( r, size, fields );
+}
+
+// The block in progress: [first, last) of the file, a whole number of
+// records. Its units are the parts of the pages of the file that it
+// overlaps, so that only the first and the last can be partial.
+
+struct block
+{
+    std::size_t first;
+    std::size_t last;
+    std::size_t page;
+
+    // the CRC-32C of each unit as it was before the conversion
+    std::vector<detail::uint32_t> crc;
+
+    // the fields that cross a page boundary: offset in the file and the
+    // position of their bytes, as they were, in `bytes`
+    std::vector< std::pair<std::size_t, std::size_t> > edges;
+    std::vector<unsigned char> bytes;
+
+    std::size_t units() const
+    {
+        return last == first? 0: ( last - 1 ) / page - first / page + 1;
+    }
+
+    std::size_t unit_begin( std::size_t k ) const
+    {
+        return k == 0? first: ( first / page + k ) * page;
+    }
+
+    std::size_t unit_end( std::size_t k ) const
+    {
+        std::size_t const r = ( first / page + k + 1 ) * page;
+        return r < last? r: last;
+    }
+
+    // the bytes of the field at offset, which crosses a page boundary
+    unsigned char const * edge( std::size_t offset ) const
+    {
+        std::vector< std::pair<std::size_t, std::size_t> >::const_iterator i = std::lower_bound( edges.begin(), edges.end(), std::make_pair( offset, std::size_t( 0 ) ) );
+        return i != edges.end() && i->first == offset? &bytes[ i->second ]: 0;
+    }
+};
+
+// The bytes [a, b) of the block, at buf, are reversed field by field. The
+// fields that cross a or b are taken from the block's edges: reversed to
+// convert, or as they were to restore.
+
+static void reverse_partial( unsigned char * buf, std::size_t a, std::size_t b, std::size_t s, endian_record_layout const & r, block const & k, bool restore )
+{
+    for( std::size_t i = 0; i < r.fields.size(); ++i )
+    {
+        std::size_t const x0 = s + r.fields[ i ].first;
+        std::size_t const x1 = x0 + r.fields[ i ].second;
+
+        if( x1 <= a || x0 >= b )
+        {
+            continue;
+        }
+
+        if( x0 >= a && x1 <= b )
+        {
+            detail::endian_reverse_field( buf + ( x0 - a ), x1 - x0 );
+            continue;
+        }
+
+        unsigned char const * e = k.edge( x0 );
+
+        for( std::size_t x = std::max( x0, a ); x < std::min( x1, b ); ++x )
+        {
+            buf[ x - a ] = restore? e[ x - x0 ]: e[ x1 - 1 - x ];
+        }
+    }
+}
+
+static void reverse_range( unsigned char * buf, std::size_t a, std::size_t b, endian_record_layout const & r, block const & k, bool restore )
+{
+    std::size_t const R = r.size;
+
+    std::size_t const lo = ( a + R - 1 ) / R;
+    std::size_t const hi = b / R;
+
+    if( lo < hi )
+    {
+        detail::endian_reverse_records( buf + ( lo * R - a ), hi - lo, r );
+    }
+
+    // the records that are only partly in [a, b), at a and at b
+
+    if( a % R != 0 )
+    {
+        reverse_partial( buf, a, b, a / R * R, r, k, restore );
+    }
+
+    if( b % R != 0 && ( a % R == 0 || a / R != hi ) )
+    {
+        reverse_partial( buf, a, b, hi * R, r, k, restore );
+    }
+}
+
+static detail::uint32_t crc_of( unsigned char const * p, std::size_t n )
+{
+    crc32c c;
+    c.update( p, n );
+    return c.value();
+}
+
+static bool write_all( int fd, unsigned char const * p, std::size_t n, std::size_t offset )
+{
+    while( n != 0 )
+    {
+        ssize_t const r = ::pwrite( fd, p, n, static_cast<off_t>( offset ) );
+
+        if( r < 0 )
+        {
+            if( errno == EINTR ) continue;
+            return false;
+        }
+
+        p += r;
+        n -= static_cast<std::size_t>( r );
+        offset += static_cast<std::size_t>( r );
+    }
+
+    return true;
+}
+
+// Records the block's units and edges, as they are in the file
+
+static void prepare( block & k, unsigned char const * data, endian_record_layout const & r, parallel_options const & opt )
+{
+    std::size_t const n = k.units();
+
+    k.crc.resize( n );
+
+    detail::parallel_for( opt, data + k.first / k.page * k.page, k.page, n, [&]( std::size_t first, std::size_t count )
+    {
+        for( std::size_t i = first; i < first + count; ++i )
+        {
+            k.crc[ i ] = crc_of( data + k.unit_begin( i ), k.unit_end( i ) - k.unit_begin( i ) );
+        }
+    });
+
+    k.edges.clear();
+    k.bytes.clear();
+
+    for( std::size_t i = 1; i < n; ++i )
+    {
+        std::size_t const x = k.unit_begin( i );
+        std::size_t const s = x / r.size * r.size;
+
+        for( std::size_t j = 0; j < r.fields.size(); ++j )
+        {
+            std::size_t const x0 = s + r.fields[ j ].first;
+
+            if( x0 < x && x0 + r.fields[ j ].second > x )
+            {
+                k.edges.push_back( std::make_pair( x0, k.bytes.size() ) );
+                k.bytes.insert( k.bytes.end(), data + x0, data + x0 + r.fields[ j ].second );
+            }
+        }
+    }
+}
+
+// Converts the block, or restores its converted units; returns 0 or an errno
+
+static int process( block const & k, unsigned char const * data, int fd, endian_record_layout const & r, parallel_options const & opt, bool restore )
+{
+    std::atomic<int> error( 0 );
+    std::atomic<std::size_t> damaged( 0 );
+
+    detail::parallel_for( opt, data + k.first / k.page * k.page, k.page, k.units(), [&]( std::size_t first, std::size_t count )
+    {
+        std::size_t const a = k.unit_begin( first );
+        std::size_t const b = k.unit_end( first + count - 1 );
+
+        if( !restore )
+        {
+            std::vector<unsigned char> buf( data + a, data + b );
+
+            reverse_range( buf.data(), a, b, r, k, false );
+
+            if( !write_all( fd, buf.data(), buf.size(), a ) )
+            {
+                error = errno;
+            }
+
+            return;
+        }
+
+        std::vector<unsigned char> buf;
+
+        for( std::size_t i = first; i < first + count; ++i )
+        {
+            std::size_t const ua = k.unit_begin( i );
+            std::size_t const ub = k.unit_end( i );
+
+            if( crc_of( data + ua, ub - ua ) == k.crc[ i ] )
+            {
+                continue;
+            }
+
+            buf.assign( data + ua, data + ub );
+
+            reverse_range( buf.data(), ua, ub, r, k, true );
+
+            if( crc_of( buf.data(), buf.size() ) != k.crc[ i ] )
+            {
+                std::fprintf( stderr, "endian_convert: the bytes [%zu, %zu) are neither as they were nor converted\n", ua, ub );
+                ++damaged;
+                continue;
+            }
+
+            if( !write_all( fd, buf.data(), buf.size(), ua ) )
+            {
+                error = errno;
+            }
+        }
+    });
+
+    if( damaged != 0 )
+    {
+        return EIO;
+    }
+
+    return error;
+}
+
+// progress file
+
+static char const magic[ 8 ] = { 'E', 'N', 'D', 'C', 'O', 'N', 'V', '1' };
+
+struct progress
+{
+    std::size_t file_size;
+    std::size_t done;
+
+    // when k.last > done, the block [done, k.last) is in progress
+    block k;
+};
+
+static void save( std::string const & path, progress const & p, endian_record_layout const & r )
+{
+    endian_writer w;
+
+    w.write_bytes( reinterpret_cast<unsigned char const*>( magic ), 8 );
+
+    w.write<big_uint64_t>( p.file_size );
+    w.write<big_uint32_t>( static_cast<detail::uint32_t>( r.size ) );
+    w.write<big_uint32_t>( static_cast<detail::uint32_t>( r.fields.size() ) );
+
+    for( std::size_t i = 0; i < r.fields.size(); ++i )
+    {
+        w.write<big_uint32_t>( static_cast<detail::uint32_t>( r.fields[ i ].first ) );
+        w.write<big_uint8_t>( static_cast<detail::uint8_t>( r.fields[ i ].second ) );
+    }
+
+    w.write<big_uint64_t>( p.done );
+    w.write<big_uint64_t>( p.k.last );
+    w.write<big_uint32_t>( static_cast<detail::uint32_t>( p.k.page ) );
+
+    w.write<big_uint32_t>( static_cast<detail::uint32_t>( p.k.crc.size() ) );
+    w.write_n<big_uint32_t>( p.k.crc.data(), p.k.crc.size() );
+
+    w.write<big_uint32_t>( static_cast<detail::uint32_t>( p.k.edges.size() ) );
+    w.write<big_uint32_t>( static_cast<detail::uint32_t>( p.k.bytes.size() ) );
+
+    for( std::size_t i = 0; i < p.k.edges.size(); ++i )
+    {
+        w.write<big_uint64_t>( p.k.edges[ i ].first );
+        w.write<big_uint32_t>( static_cast<detail::uint32_t>( p.k.edges[ i ].second ) );
+    }
+
+    w.write_bytes( p.k.bytes.data(), p.k.bytes.size() );
+
+    std::vector<unsigned char> v( w.size() );
+    w.copy_to( v.data() );
+
+    unsigned char t[ 4 ];
+    store_big_u32( t, crc_of( v.data(), v.size() ) );
+    v.insert( v.end(), t, t + 4 );
+
+    // written in full to a temporary file, which then replaces the old one
+
+    std::string const tmp = path + ".tmp";
+
+    int fd = ::open( tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+    if( fd < 0 || !write_all( fd, v.data(), v.size(), 0 ) || ::fsync( fd ) != 0 )
+    {
+        fail( tmp, errno );
+    }
+
+    ::close( fd );
+
+    if( ::rename( tmp.c_str(), path.c_str() ) != 0 )
+    {
+        fail( path, errno );
+    }
+
+    std::string::size_type const slash = path.rfind( '/' );
+    std::string const dir = slash == std::string::npos? std::string( "." ): path.substr( 0, slash + 1 );
+
+    fd = ::open( dir.c_str(), O_RDONLY );
+
+    if( fd >= 0 )
+    {
+        ::fsync( fd );
+        ::close( fd );
+    }
+}
+
+// Returns: false when there is no progress file
+
+static bool load( std::string const & path, progress & p, endian_record_layout const & r )
+{
+    std::FILE * f = std::fopen( path.c_str(), "rb" );
+
+    if( f == 0 )
+    {
+        if( errno == ENOENT ) return false;
+        fail( path, errno );
+    }
+
+    std::vector<unsigned char> v;
+    unsigned char t[ 4096 ];
+
+    for( std::size_t n; ( n = std::fread( t, 1, sizeof(t), f ) ) != 0; )
+    {
+        v.insert( v.end(), t, t + n );
+    }
+
+    std::fclose( f );
+
+    if( v.size() < 12 || std::memcmp( v.data(), magic, 8 ) != 0 || load_big_u32( &v[ v.size() - 4 ] ) != crc_of( v.data(), v.size() - 4 ) )
+    {
+        fail( path + ": not a valid progress file" );
+    }
+
+    endian_reader in( v.data(), v.size() - 4 );
+
+    in.skip( 8 );
+
+    p.file_size = static_cast<std::size_t>( in.read<big_uint64_t>() );
+
+    field_list fields;
+    std::size_t const size = in.read<big_uint32_t>();
+
+    for( std::size_t i = 0, n = in.read<big_uint32_t>(); in && i < n; ++i )
+    {
+        std::size_t const offset = in.read<big_uint32_t>();
+        fields.push_back( std::make_pair( offset, std::size_t( in.read<big_uint8_t>() ) ) );
+    }
+
+    if( size != r.size || fields != r.fields )
+    {
+        fail( path + ": the progress file is for another layout; use -r to start again" );
+    }
+
+    p.done = static_cast<std::size_t>( in.read<big_uint64_t>() );
+    p.k.first = p.done;
+    p.k.last = static_cast<std::size_t>( in.read<big_uint64_t>() );
+    p.k.page = in.read<big_uint32_t>();
+
+    std::size_t const units = in.read<big_uint32_t>();
+
+    if( units <= in.size() / 4 )
+    {
+        p.k.crc.resize( units );
+        in.read_n<big_uint32_t>( p.k.crc.data(), units );
+    }
+
+    std::size_t const edges = in.read<big_uint32_t>();
+    std::size_t const bytes = in.read<big_uint32_t>();
+
+    for( std::size_t i = 0; in && i < edges; ++i )
+    {
+        std::size_t const offset = static_cast<std::size_t>( in.read<big_uint64_t>() );
+        p.k.edges.push_back( std::make_pair( offset, std::size_t( in.read<big_uint32_t>() ) ) );
+    }
+
+    if( in.size() == bytes )
+    {
+        p.k.bytes.assign( in.data(), in.data() + bytes );
+        in.skip( bytes );
+    }
+
+    if( !in || !in.empty() || p.k.page == 0 || p.k.last < p.done || p.k.crc.size() != p.k.units() || p.k.crc.size() != units )
+    {
+        fail( path + ": not a valid progress file" );
+    }
+
+    return true;
+}
+
+static void usage()
+{
+    std::fprintf( stderr,
+        "usage: endian_convert [-j threads] [-b block MB] [-p progress file] [-r] layout file\n"
+        "  layout: comma separated fields; N (an N-byte value), NxK (K of them) or cN (N bytes left alone)\n" );
+
+    std::exit( 2 );
+}
+
+int main( int argc, char const * argv[] )
+{
+    parallel_options opt;
+    std::size_t block_size = std::size_t( 256 ) << 20;
+    std::string progress_path;
+    bool restart = false;
+
+    int i = 1;
+
+    for( ; i < argc && argv[ i ][ 0 ] == '-'; ++i )
+    {
+        std::string const a = argv[ i ];
+
+        if( a == "-r" )
+        {
+            restart = true;
+        }
+        else if( ( a == "-j" || a == "-b" || a == "-p" ) && i + 1 < argc )
+        {
+            char const * v = argv[ ++i ];
+
+            if( a == "-p" )
+            {
+                progress_path = v;
+                continue;
+            }
+
+            std::size_t n;
+
+            if( !parse_number( v, n ) || *v != 0 || n == 0 )
+            {
+                usage();
+            }
+
+            if( a == "-j" )
+            {
+                opt.threads = static_cast<unsigned>( n );
+            }
+            else
+            {
+                block_size = n << 20;
+            }
+        }
+        else
+        {
+            usage();
+        }
+    }
+
+    if( argc - i != 2 )
+    {
+        usage();
+    }
+
+    endian_record_layout layout;
+
+    if( !parse_layout( argv[ i ], layout ) )
+    {
+        fail( std::string( "invalid layout: " ) + argv[ i ] );
+    }
+
+    std::string const path = argv[ i + 1 ];
+
+    if( layout.fields.empty() )
+    {
+        std::fprintf( stderr, "endian_convert: the layout has no fields of more than one byte; nothing to do\n" );
+        return 0;
+    }
+
+    if( progress_path.empty() )
+    {
+        progress_path = path + ".endian-progress";
+    }
+
+    // mapped read-only: the converted bytes are written with pwrite, which
+    // changes each page under the page lock, so that it is never written
+    // back half converted
+
+    std::error_code ec;
+    detail::mapped_file m;
+
+    if( !m.open( path.c_str(), false, ec ) )
+    {
+        fail( path, ec.value() );
+    }
+
+    int const fd = ::open( path.c_str(), O_WRONLY );
+
+    if( fd < 0 )
+    {
+        fail( path, errno );
+    }
+
+    std::size_t const size = m.size();
+
+    if( size % layout.size != 0 )
+    {
+        fail( path + ": the size is not a whole number of " + std::to_string( layout.size ) + "-byte records" );
+    }
+
+    unsigned char const * data = m.data();
+
+    m.advise( 0, size, map_advice::sequential );
+    m.advise( 0, size, map_advice::hugepage );
+
+    progress p;
+
+    p.file_size = size;
+    p.done = 0;
+    p.k.first = p.k.last = 0;
+    p.k.page = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+
+    if( !restart && load( progress_path, p, layout ) )
+    {
+        if( p.file_size != size )
+        {
+            fail( progress_path + ": the progress file is for a file of another size; use -r to start again" );
+        }
+
+        if( p.k.last > p.done )
+        {
+            std::fprintf( stderr, "endian_convert: restoring the block [%zu, %zu), which was in progress\n", p.done, p.k.last );
+
+            if( int e = process( p.k, data, fd, layout, opt, true ) )
+            {
+                fail( path, e );
+            }
+
+            if( ::fdatasync( fd ) != 0 )
+            {
+                fail( path, errno );
+            }
+        }
+
+        if( p.done != 0 )
+        {
+            std::fprintf( stderr, "endian_convert: resuming at %zu of %zu bytes\n", p.done, size );
+        }
+    }
+
+    std::signal( SIGINT, on_signal );
+    std::signal( SIGTERM, on_signal );
+
+    std::size_t const records_per_block = block_size / layout.size != 0? block_size / layout.size: 1;
+
+    while( p.done < size )
+    {
+        if( interrupted )
+        {
+            std::fprintf( stderr, "endian_convert: interrupted at %zu of %zu bytes; run again to resume\n", p.done, size );
+            return 1;
+        }
+
+        block & k = p.k;
+
+        k.first = p.done;
+        k.last = k.first + std::min( ( size - k.first ) / layout.size, records_per_block ) * layout.size;
+        k.page = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+
+        prepare( k, data, layout, opt );
+        save( progress_path, p, layout );
+
+        m.advise( k.last, k.last - k.first, map_advice::willneed );
+
+        if( int e = process( k, data, fd, layout, opt, false ) )
+        {
+            fail( path, e );
+        }
+
+        if( ::fdatasync( fd ) != 0 )
+        {
+            fail( path, errno );
+        }
+
+        p.done = k.last;
+        k.crc.clear();
+        k.edges.clear();
+        k.bytes.clear();
+
+        save( progress_path, p, layout );
+
+        // the pages are clean, and no longer needed
+
+        m.advise( k.first, k.last - k.first, map_advice::dontneed );
+
+        std::fprintf( stderr, "\rendian_convert: %3d%%", static_cast<int>( size == 0? 100: p.done * 100.0 / size ) );
+    }
+
+    std::fprintf( stderr, "\n" );
+
+    ::close( fd );
+    std::remove( progress_path.c_str() );
+
+    return 0;
+}
+
+#endif